@@ -0,0 +1,160 @@
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../s21_executor.h"
+#include "../s21_queue.h"
+
+// Задержка запроса, который раздает kFanOut мелких задач и ждет их все:
+// std::async, пул на s21::queue под мьютексом и s21::executor
+
+namespace {
+
+const int kRequests = 2000;
+const int kFanOut = 16;
+
+// Пул с одной очередью std::function под мьютексом и условной переменной
+class locked_pool {
+ public:
+  explicit locked_pool(unsigned threads) {
+    for (unsigned i = 0; i < threads; ++i) {
+      workers_.emplace_back([this] { loop(); });
+    }
+  }
+  ~locked_pool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    wake_.notify_all();
+    for (std::thread &worker : workers_) worker.join();
+  }
+  void post(std::function<void()> task) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      tasks_.push(std::move(task));
+    }
+    wake_.notify_one();
+  }
+
+ private:
+  void loop() {
+    while (true) {
+      std::function<void()> task;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        wake_.wait(lock, [this] { return stop_ || !tasks_.empty(); });
+        if (tasks_.empty()) return;
+        task = tasks_.front();
+        tasks_.pop();
+      }
+      task();
+    }
+  }
+
+  std::vector<std::thread> workers_;
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  s21::queue<std::function<void()>> tasks_;
+  bool stop_ = false;
+};
+
+long work(int i) { return long(i) * i; }
+
+// Средняя задержка запроса в микросекундах
+template <typename Request>
+double measure(Request request, long &sum) {
+  sum = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (int r = 0; r < kRequests; ++r) sum += request();
+  std::chrono::duration<double, std::micro> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return elapsed.count() / kRequests;
+}
+
+}  // namespace
+
+int main() {
+  unsigned threads = std::thread::hardware_concurrency();
+  if (threads == 0) threads = 1;
+  std::printf("%d requests, fan-out %d, %u threads\n", kRequests, kFanOut,
+              threads);
+  long expected = 0;
+  for (int i = 0; i < kFanOut; ++i) expected += work(i);
+
+  long sum = 0;
+  double async_us = measure(
+      [] {
+        std::vector<std::future<long>> parts;
+        for (int i = 0; i < kFanOut; ++i) {
+          parts.push_back(std::async(std::launch::async, work, i));
+        }
+        long total = 0;
+        for (auto &part : parts) total += part.get();
+        return total;
+      },
+      sum);
+  if (sum != expected * kRequests) return 1;
+
+  double locked_us = 0;
+  {
+    locked_pool pool(threads);
+    locked_us = measure(
+        [&pool] {
+          std::atomic<long> total{0};
+          int left = kFanOut;
+          std::mutex mutex;
+          std::condition_variable done;
+          for (int i = 0; i < kFanOut; ++i) {
+            pool.post([&, i] {
+              total.fetch_add(work(i));
+              std::lock_guard<std::mutex> lock(mutex);
+              if (--left == 0) done.notify_one();
+            });
+          }
+          std::unique_lock<std::mutex> lock(mutex);
+          done.wait(lock, [&] { return left == 0; });
+          return total.load();
+        },
+        sum);
+    if (sum != expected * kRequests) return 1;
+  }
+
+  s21::executor pool(threads);
+  double submit_us = measure(
+      [&pool] {
+        std::vector<s21::future<long>> parts;
+        for (int i = 0; i < kFanOut; ++i) {
+          parts.push_back(pool.submit([i] { return work(i); }));
+        }
+        s21::wait_all(parts.begin(), parts.end());
+        long total = 0;
+        for (auto &part : parts) total += part.get();
+        return total;
+      },
+      sum);
+  if (sum != expected * kRequests) return 1;
+
+  double for_us = measure(
+      [&pool] {
+        std::atomic<long> total{0};
+        pool.parallel_for(0, kFanOut, [&total](std::size_t i) {
+          total.fetch_add(work(int(i)));
+        });
+        return total.load();
+      },
+      sum);
+  if (sum != expected * kRequests) return 1;
+
+  std::printf("  std::async            %8.2f us/request\n", async_us);
+  std::printf("  s21::queue + mutex    %8.2f us/request\n", locked_us);
+  std::printf("  executor submit       %8.2f us/request\n", submit_us);
+  std::printf("  executor parallel_for %8.2f us/request\n", for_us);
+  return 0;
+}
@@ -0,0 +1,65 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+
+#include "../s21_frozen.h"
+#include "../s21_vector.h"
+
+// Поиск в s21::set, в frozen_set в памяти и в frozen_set из файла
+
+namespace {
+
+const std::size_t kSize = 1 << 20;
+const std::size_t kQueries = 1 << 22;
+
+template <typename F>
+double measure(F body) {
+  auto start = std::chrono::steady_clock::now();
+  body();
+  std::chrono::duration<double, std::milli> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return elapsed.count();
+}
+
+template <typename Set>
+double lookups(const Set &items, const s21::vector<std::uint64_t> &queries,
+               std::size_t &found) {
+  return measure([&] {
+    found = 0;
+    for (std::uint64_t key : queries) found += items.contains(key);
+  });
+}
+
+}  // namespace
+
+int main() {
+  std::mt19937_64 gen(1);
+  s21::set<std::uint64_t> source;
+  while (source.size() < kSize) source.insert(gen() % (kSize * 4));
+  s21::vector<std::uint64_t> queries(kQueries);
+  for (auto &key : queries) key = gen() % (kSize * 4);
+
+  std::string path = "frozen_bench.bin";
+  s21::frozen_set<std::uint64_t> frozen;
+  double build = measure([&] {
+    s21::frozen_set<std::uint64_t>(source).swap(frozen);
+    frozen.save(path);
+  });
+  s21::frozen_set<std::uint64_t> opened;
+  double open = measure(
+      [&] { s21::frozen_set<std::uint64_t>::open(path).swap(opened); });
+
+  std::size_t a = 0, b = 0, c = 0;
+  double tree = lookups(source, queries, a);
+  double memory = lookups(frozen, queries, b);
+  double mapped = lookups(opened, queries, c);
+  std::remove(path.c_str());
+
+  std::printf("%zu keys, %zu lookups\n", kSize, kQueries);
+  std::printf("  build + save %8.1f ms  open %8.3f ms\n", build, open);
+  std::printf("  s21::set %8.1f ms  frozen %8.1f ms  mapped %8.1f ms  x%.2f\n",
+              tree, memory, mapped, tree / mapped);
+  return a == b && b == c ? 0 : 1;
+}
@@ -0,0 +1,79 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <random>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+#include "../s21_map.h"
+#include "../s21_rcu.h"
+
+// Чтение rcu_map и s21::map под std::shared_mutex при разном числе
+// потоков-читателей
+
+namespace {
+
+const int kKeys = 1 << 12;
+const std::size_t kReadsPerThread = 1 << 20;
+
+class locked_map {
+ public:
+  explicit locked_map(const s21::map<int, int> &items) : map_(items) {}
+  bool contains(int key) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return map_.contains(key);
+  }
+
+ private:
+  mutable std::shared_mutex mutex_;
+  s21::map<int, int> map_;
+};
+
+template <typename Map>
+double run(const Map &map, unsigned threads, std::size_t &hits) {
+  std::vector<std::size_t> found(threads);
+  auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> workers;
+  for (unsigned t = 0; t < threads; ++t) {
+    workers.emplace_back([&map, &found, t] {
+      std::minstd_rand gen(t + 1);
+      std::size_t local = 0;
+      for (std::size_t i = 0; i < kReadsPerThread; ++i) {
+        local += map.contains(int(gen() % (kKeys * 2)));
+      }
+      found[t] = local;
+    });
+  }
+  for (std::thread &worker : workers) worker.join();
+  std::chrono::duration<double, std::milli> elapsed =
+      std::chrono::steady_clock::now() - start;
+  hits = 0;
+  for (std::size_t value : found) hits += value;
+  return elapsed.count();
+}
+
+}  // namespace
+
+int main() {
+  s21::map<int, int> items;
+  for (int key = 0; key < kKeys; ++key) items.insert_or_assign(key, key);
+  s21::rcu_map<int, int> rcu(items);
+  locked_map locked(items);
+
+  unsigned cores = std::thread::hardware_concurrency();
+  std::printf("%d keys, %zu reads per thread, %u cores\n", kKeys,
+              kReadsPerThread, cores);
+  for (unsigned threads = 1; threads <= 16; threads *= 2) {
+    std::size_t a = 0, b = 0;
+    double fast = run(rcu, threads, a);
+    double slow = run(locked, threads, b);
+    // миллионы чтений в секунду
+    double reads = double(threads) * kReadsPerThread / 1000.0;
+    std::printf("  %2u threads  rcu %7.2f Mops/s  shared_mutex %7.2f Mops/s\n",
+                threads, reads / fast, reads / slow);
+    if (a != b) return 1;
+  }
+  return 0;
+}
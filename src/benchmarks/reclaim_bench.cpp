@@ -0,0 +1,75 @@
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+
+#include "../s21_reclaim.h"
+
+// Цена защиты одного чтения и одного удаления в epoch_domain и
+// hazard_domain по сравнению с голым чтением указателя
+
+namespace {
+
+const long kReads = 1 << 24;
+const long kRetires = 1 << 20;
+
+struct item {
+  long value;
+};
+
+template <typename F>
+double per_op_ns(long count, F body) {
+  auto start = std::chrono::steady_clock::now();
+  body();
+  std::chrono::duration<double, std::nano> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return elapsed.count() / double(count);
+}
+
+}  // namespace
+
+int main() {
+  using s21::reclaim::epoch_domain;
+  using s21::reclaim::hazard_domain;
+  std::atomic<item *> shared(new item{1});
+  long sum = 0;
+
+  double plain = per_op_ns(kReads, [&] {
+    for (long i = 0; i < kReads; ++i) {
+      sum += shared.load(std::memory_order_acquire)->value;
+    }
+  });
+  double epoch = per_op_ns(kReads, [&] {
+    for (long i = 0; i < kReads; ++i) {
+      epoch_domain::guard guard;
+      sum += shared.load(std::memory_order_acquire)->value;
+    }
+  });
+  double hazard = per_op_ns(kReads, [&] {
+    hazard_domain::hazard_pointer slot;
+    for (long i = 0; i < kReads; ++i) {
+      sum += slot.protect(shared)->value;
+    }
+    slot.reset();
+  });
+
+  double epoch_retire = per_op_ns(kRetires, [&] {
+    auto &domain = epoch_domain::global();
+    for (long i = 0; i < kRetires; ++i) {
+      epoch_domain::guard guard;
+      domain.retire(new item{i});
+    }
+    domain.collect();
+  });
+  double hazard_retire = per_op_ns(kRetires, [&] {
+    auto &domain = hazard_domain::global();
+    for (long i = 0; i < kRetires; ++i) domain.retire(new item{i});
+    domain.collect();
+  });
+  delete shared.load();
+
+  std::printf("read:   plain %5.2f ns  epoch %5.2f ns  hazard %5.2f ns\n",
+              plain, epoch, hazard);
+  std::printf("retire: epoch %5.2f ns  hazard %5.2f ns\n", epoch_retire,
+              hazard_retire);
+  return sum == 0 ? 1 : 0;
+}
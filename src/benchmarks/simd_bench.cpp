@@ -0,0 +1,95 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+#include "../s21_algorithm.h"
+#include "../s21_vector.h"
+
+// Сравнение векторных ядер s21_algorithm.h со скалярными циклами по
+// begin()/end() на буфере из kSize элементов
+
+namespace {
+
+const std::size_t kSize = 1 << 20;
+const int kRepeats = 50;
+
+// Не дает компилятору выбросить результат замера
+volatile double sink;
+
+template <typename F>
+double measure(F body) {
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kRepeats; ++i) sink = double(body());
+  std::chrono::duration<double, std::milli> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return elapsed.count() / kRepeats;
+}
+
+void report(const char *name, double scalar, double simd) {
+  std::printf("  %-6s scalar %8.3f ms  simd %8.3f ms  x%.2f\n", name, scalar,
+              simd, scalar / simd);
+}
+
+template <typename T>
+void run(const char *type) {
+  s21::vector<T> a(kSize), b(kSize), c(kSize);
+  for (std::size_t i = 0; i < kSize; ++i) a[i] = c[i] = T(i % 1000);
+  const T missing = T(-1);
+
+  const char *isa_names[] = {"scalar", "sse2", "avx2"};
+  std::printf("%s, %s\n", type, isa_names[int(s21::simd::current_isa())]);
+  report("find",
+         measure([&] {
+           auto it = a.begin();
+           while (it != a.end() && *it != missing) ++it;
+           return it - a.begin();
+         }),
+         measure([&] { return s21::find(a, missing) - a.data(); }));
+  report("count",
+         measure([&] {
+           std::size_t n = 0;
+           for (auto it = a.begin(); it != a.end(); ++it) n += *it == T(7);
+           return n;
+         }),
+         measure([&] { return s21::count(a, T(7)); }));
+  report("min",
+         measure([&] {
+           auto best = a.begin();
+           for (auto it = a.begin(); it != a.end(); ++it)
+             if (*it < *best) best = it;
+           return *best;
+         }),
+         measure([&] { return *s21::min_element(a); }));
+  report("sum",
+         measure([&] {
+           typename s21::simd::traits<T>::sum_type s{};
+           for (auto it = a.begin(); it != a.end(); ++it) s += *it;
+           return s;
+         }),
+         measure([&] { return s21::sum(a); }));
+  report("fill",
+         measure([&] {
+           for (auto it = b.begin(); it != b.end(); ++it) *it = T(3);
+           return b[kSize / 2];
+         }),
+         measure([&] {
+           s21::fill(b, T(3));
+           return b[kSize / 2];
+         }));
+  report("equal",
+         measure([&] {
+           auto it = a.begin(), jt = c.begin();
+           while (it != a.end() && *it == *jt) ++it, ++jt;
+           return it == a.end();
+         }),
+         measure([&] { return s21::equal(a, c); }));
+}
+
+}  // namespace
+
+int main() {
+  run<std::int32_t>("int32_t");
+  run<float>("float");
+  run<double>("double");
+  return 0;
+}
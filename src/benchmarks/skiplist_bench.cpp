@@ -0,0 +1,95 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "../s21_concurrent_skiplist.h"
+#include "../s21_set.h"
+
+// Смешанная нагрузка (80% поиска, 10% вставки, 10% удаления) на
+// concurrent_skiplist_set и на s21::set под одним мьютексом при разном
+// числе потоков
+
+namespace {
+
+const std::uint64_t kKeys = 1 << 16;
+const std::size_t kOpsPerThread = 1 << 18;
+
+// s21::set под глобальной блокировкой - то, что лист с пропусками заменяет
+class locked_set {
+ public:
+  bool contains(std::uint64_t key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return set_.contains(key);
+  }
+  void insert(std::uint64_t key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    set_.insert(key);
+  }
+  void erase(std::uint64_t key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = set_.find(key);
+    if (it != set_.end()) set_.erase(it);
+  }
+
+ private:
+  std::mutex mutex_;
+  s21::set<std::uint64_t> set_;
+};
+
+template <typename Set>
+double run(Set &set, unsigned threads, std::size_t &hits) {
+  for (std::uint64_t key = 0; key < kKeys; key += 2) set.insert(key);
+  std::vector<std::size_t> found(threads);
+  auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> workers;
+  for (unsigned t = 0; t < threads; ++t) {
+    workers.emplace_back([&set, &found, t] {
+      std::mt19937_64 gen(t + 1);
+      std::size_t local = 0;
+      for (std::size_t i = 0; i < kOpsPerThread; ++i) {
+        std::uint64_t draw = gen();
+        std::uint64_t key = draw % kKeys;
+        unsigned op = unsigned(draw >> 60);
+        if (op < 13) {
+          local += set.contains(key);
+        } else if (op < 15) {
+          set.insert(key);
+        } else {
+          set.erase(key);
+        }
+      }
+      found[t] = local;
+    });
+  }
+  for (std::thread &worker : workers) worker.join();
+  std::chrono::duration<double, std::milli> elapsed =
+      std::chrono::steady_clock::now() - start;
+  hits = 0;
+  for (std::size_t value : found) hits += value;
+  return elapsed.count();
+}
+
+}  // namespace
+
+int main() {
+  unsigned cores = std::thread::hardware_concurrency();
+  std::printf("%llu keys, %zu ops per thread, %u cores\n",
+              (unsigned long long)kKeys, kOpsPerThread, cores);
+  for (unsigned threads = 1; threads <= 16; threads *= 2) {
+    std::size_t a = 0, b = 0;
+    s21::concurrent_skiplist_set<std::uint64_t> skiplist;
+    locked_set locked;
+    double lock_free = run(skiplist, threads, a);
+    double mutex = run(locked, threads, b);
+    // миллионы операций в секунду
+    double ops = double(threads) * kOpsPerThread / 1000.0;
+    std::printf("  %2u threads  skiplist %6.2f Mops/s  locked %6.2f Mops/s\n",
+                threads, ops / lock_free, ops / mutex);
+    if (a == 0 || b == 0) return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,61 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <vector>
+
+#include "../s21_sort.h"
+#include "../s21_vector.h"
+
+// Сравнение s21::sort с копированием в std::vector и std::sort
+
+namespace {
+
+const std::size_t kSize = 1 << 22;
+
+template <typename F>
+double measure(F body) {
+  auto start = std::chrono::steady_clock::now();
+  body();
+  std::chrono::duration<double, std::milli> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return elapsed.count();
+}
+
+template <typename T, typename Compare>
+void run(const char *name, const s21::vector<T> &data, Compare comp) {
+  s21::vector<T> a = data;
+  double copy_std = measure([&] {
+    std::vector<T> tmp(a.begin(), a.end());
+    std::sort(tmp.begin(), tmp.end(), comp);
+    std::copy(tmp.begin(), tmp.end(), a.begin());
+  });
+  s21::vector<T> b = data;
+  double s21_time = measure([&] { s21::sort(b.begin(), b.end(), comp); });
+  std::printf("  %-22s std::sort %8.1f ms  s21::sort %8.1f ms  x%.2f\n", name,
+              copy_std, s21_time, copy_std / s21_time);
+}
+
+}  // namespace
+
+int main() {
+  std::mt19937_64 gen(1);
+  s21::vector<std::uint64_t> keys(kSize);
+  for (auto &key : keys) key = gen();
+  s21::vector<std::uint64_t> small(kSize);
+  for (auto &key : small) key = gen() % 100000;
+  s21::vector<double> reals(kSize);
+  for (auto &x : reals) x = double(std::int64_t(gen())) / 1e9;
+  s21::vector<std::uint64_t> sorted = keys;
+  std::sort(sorted.begin(), sorted.end());
+
+  std::printf("%zu elements\n", kSize);
+  run("uint64 radix", keys, std::less<>());
+  run("uint64 < 10^5 radix", small, std::less<>());
+  run("double radix", reals, std::less<>());
+  run("uint64 pdqsort (>)", keys, std::greater<>());
+  run("sorted pdqsort (>)", sorted, std::greater<>());
+  return 0;
+}
@@ -0,0 +1,90 @@
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../s21_concurrent_stack.h"
+#include "../s21_stack.h"
+
+// Пары push/pop на concurrent_stack и на s21::stack под мьютексом при
+// числе потоков от 1 до 64
+
+namespace {
+
+const long kPairsTotal = 1 << 21;
+
+class locked_stack {
+ public:
+  void push(long value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stack_.push(value);
+  }
+  bool pop(long &value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (stack_.empty()) return false;
+    value = stack_.top();
+    stack_.pop();
+    return true;
+  }
+
+ private:
+  std::mutex mutex_;
+  s21::stack<long> stack_;
+};
+
+bool pop_from(s21::concurrent_stack<long> &stack, long &value) {
+  auto popped = stack.pop();
+  if (popped) value = *popped;
+  return bool(popped);
+}
+
+bool pop_from(locked_stack &stack, long &value) { return stack.pop(value); }
+
+// Общий объем работы делится между потоками поровну
+template <typename Stack>
+double run(Stack &stack, unsigned threads, long &sum) {
+  long pairs = kPairsTotal / threads;
+  std::vector<long> sums(threads);
+  auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> workers;
+  for (unsigned t = 0; t < threads; ++t) {
+    workers.emplace_back([&stack, &sums, pairs, t] {
+      long local = 0;
+      for (long i = 0; i < pairs; ++i) {
+        long value = 0;
+        stack.push(i);
+        if (pop_from(stack, value)) local += value;
+      }
+      sums[t] = local;
+    });
+  }
+  for (std::thread &worker : workers) worker.join();
+  std::chrono::duration<double, std::milli> elapsed =
+      std::chrono::steady_clock::now() - start;
+  long value = 0;
+  while (pop_from(stack, value)) sums[0] += value;
+  sum = 0;
+  for (long part : sums) sum += part;
+  return elapsed.count();
+}
+
+}  // namespace
+
+int main() {
+  std::printf("%ld push/pop pairs, %u cores\n", kPairsTotal,
+              std::thread::hardware_concurrency());
+  for (unsigned threads = 1; threads <= 64; threads *= 2) {
+    s21::concurrent_stack<long> lock_free;
+    locked_stack locked;
+    long a = 0, b = 0;
+    double fast = run(lock_free, threads, a);
+    double slow = run(locked, threads, b);
+    // миллионы пар в секунду
+    double pairs = double(kPairsTotal / threads * threads) / 1000.0;
+    std::printf("  %2u threads  treiber %6.2f Mpairs/s  locked %6.2f\n",
+                threads, pairs / fast, pairs / slow);
+    if (a != b) return 1;
+  }
+  return 0;
+}
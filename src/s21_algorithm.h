@@ -0,0 +1,633 @@
+#ifndef S21_ALGORITHM_H_
+#define S21_ALGORITHM_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+// Векторные ядра собираются только на x86 с SSE2 и компилятором, который
+// понимает атрибут target: AVX2 включается для отдельных функций, поэтому
+// -mavx2 при сборке не нужен
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__SSE2__) && \
+    (defined(__GNUC__) || defined(__clang__))
+#define S21_SIMD_X86 1
+#include <immintrin.h>
+#define S21_SIMD_SSE2_TARGET
+#define S21_SIMD_AVX2_TARGET __attribute__((target("avx2")))
+#else
+#define S21_SIMD_X86 0
+#endif
+
+namespace s21 {
+namespace simd {
+
+// Набор инструкций, которым выполняются ядра
+enum class isa { scalar, sse2, avx2 };
+
+// Типы, для которых есть векторные ядра. sum_type - тип накопителя суммы:
+// int32_t суммируется в int64_t, чтобы не переполниться
+template <typename T>
+struct traits {
+  static constexpr bool supported = false;
+  using sum_type = T;
+};
+
+template <>
+struct traits<std::int32_t> {
+  static constexpr bool supported = true;
+  using sum_type = std::int64_t;
+};
+
+template <>
+struct traits<float> {
+  static constexpr bool supported = true;
+  using sum_type = float;
+};
+
+template <>
+struct traits<double> {
+  static constexpr bool supported = true;
+  using sum_type = double;
+};
+
+// Лучший набор инструкций, который поддерживает процессор
+inline isa detected_isa() noexcept {
+  static const isa level = [] {
+#if S21_SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return isa::avx2;
+    return isa::sse2;
+#else
+    return isa::scalar;
+#endif
+  }();
+  return level;
+}
+
+namespace detail {
+inline isa &active_isa() noexcept {
+  static isa level = detected_isa();
+  return level;
+}
+}  // namespace detail
+
+// Текущий набор инструкций для диспетчеризации
+inline isa current_isa() noexcept { return detail::active_isa(); }
+
+// Ограничивает диспетчеризацию набором не выше level (для тестов и
+// сравнения со скалярной версией). Уровень выше поддерживаемого процессором
+// не включается
+inline void set_isa(isa level) noexcept {
+  detail::active_isa() = level < detected_isa() ? level : detected_isa();
+}
+
+namespace detail {
+
+template <typename T>
+struct non_deduced {
+  using type = T;
+};
+
+template <typename T>
+using value_t = typename non_deduced<std::remove_const_t<T>>::type;
+
+// -------- Скалярные ядра --------
+
+template <typename T>
+std::size_t scalar_find(const T *data, std::size_t n, T value) {
+  std::size_t i = 0;
+  while (i < n && !(data[i] == value)) ++i;
+  return i;
+}
+
+template <typename T>
+std::size_t scalar_count(const T *data, std::size_t n, T value) {
+  std::size_t result = 0;
+  for (std::size_t i = 0; i < n; ++i) result += data[i] == value;
+  return result;
+}
+
+template <typename T>
+std::size_t scalar_min_index(const T *data, std::size_t n) {
+  std::size_t best = 0;
+  for (std::size_t i = 1; i < n; ++i)
+    if (data[i] < data[best]) best = i;
+  return n ? best : n;
+}
+
+template <typename T>
+std::size_t scalar_max_index(const T *data, std::size_t n) {
+  std::size_t best = 0;
+  for (std::size_t i = 1; i < n; ++i)
+    if (data[best] < data[i]) best = i;
+  return n ? best : n;
+}
+
+template <typename T>
+typename traits<T>::sum_type scalar_sum(const T *data, std::size_t n) {
+  typename traits<T>::sum_type result{};
+  for (std::size_t i = 0; i < n; ++i) result += data[i];
+  return result;
+}
+
+template <typename T>
+void scalar_fill(T *data, std::size_t n, const T &value) {
+  for (std::size_t i = 0; i < n; ++i) data[i] = value;
+}
+
+template <typename T>
+bool scalar_equal(const T *lhs, const T *rhs, std::size_t n) {
+  for (std::size_t i = 0; i < n; ++i)
+    if (!(lhs[i] == rhs[i])) return false;
+  return true;
+}
+
+#if S21_SIMD_X86
+
+// -------- Обертки над регистрами --------
+// Каждая обертка дает одинаковый набор операций над регистром из lanes
+// элементов: загрузку, запись, сравнение с маской по элементам, min/max и
+// накопление суммы в регистре acc_reg из acc_lanes элементов sum_type
+
+template <typename T>
+struct sse2_ops;
+
+template <>
+struct sse2_ops<std::int32_t> {
+  using value_type = std::int32_t;
+  using reg = __m128i;
+  using acc_reg = __m128i;
+  static constexpr std::size_t lanes = 4;
+  static constexpr std::size_t acc_lanes = 2;
+
+  static reg load(const value_type *p) {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+  }
+  static void store(value_type *p, reg v) {
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(p), v);
+  }
+  static reg set1(value_type value) { return _mm_set1_epi32(value); }
+  static unsigned eq_mask(reg a, reg b) {
+    return _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(a, b)));
+  }
+  // В SSE2 нет pminsd/pmaxsd, выбираем элементы по маске сравнения
+  static reg min(reg a, reg b) {
+    reg gt = _mm_cmpgt_epi32(a, b);
+    return _mm_or_si128(_mm_and_si128(gt, b), _mm_andnot_si128(gt, a));
+  }
+  static reg max(reg a, reg b) {
+    reg gt = _mm_cmpgt_epi32(a, b);
+    return _mm_or_si128(_mm_and_si128(gt, a), _mm_andnot_si128(gt, b));
+  }
+  static acc_reg acc_zero() { return _mm_setzero_si128(); }
+  // Расширяет элементы до int64 знаком и прибавляет к накопителю
+  static acc_reg acc_add(acc_reg acc, reg v) {
+    reg sign = _mm_srai_epi32(v, 31);
+    acc = _mm_add_epi64(acc, _mm_unpacklo_epi32(v, sign));
+    return _mm_add_epi64(acc, _mm_unpackhi_epi32(v, sign));
+  }
+  static void acc_store(std::int64_t *p, acc_reg acc) {
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(p), acc);
+  }
+};
+
+template <>
+struct sse2_ops<float> {
+  using value_type = float;
+  using reg = __m128;
+  using acc_reg = __m128;
+  static constexpr std::size_t lanes = 4;
+  static constexpr std::size_t acc_lanes = 4;
+
+  static reg load(const value_type *p) { return _mm_loadu_ps(p); }
+  static void store(value_type *p, reg v) { _mm_storeu_ps(p, v); }
+  static reg set1(value_type value) { return _mm_set1_ps(value); }
+  static unsigned eq_mask(reg a, reg b) {
+    return _mm_movemask_ps(_mm_cmpeq_ps(a, b));
+  }
+  static reg min(reg a, reg b) { return _mm_min_ps(a, b); }
+  static reg max(reg a, reg b) { return _mm_max_ps(a, b); }
+  static acc_reg acc_zero() { return _mm_setzero_ps(); }
+  static acc_reg acc_add(acc_reg acc, reg v) { return _mm_add_ps(acc, v); }
+  static void acc_store(float *p, acc_reg acc) { _mm_storeu_ps(p, acc); }
+};
+
+template <>
+struct sse2_ops<double> {
+  using value_type = double;
+  using reg = __m128d;
+  using acc_reg = __m128d;
+  static constexpr std::size_t lanes = 2;
+  static constexpr std::size_t acc_lanes = 2;
+
+  static reg load(const value_type *p) { return _mm_loadu_pd(p); }
+  static void store(value_type *p, reg v) { _mm_storeu_pd(p, v); }
+  static reg set1(value_type value) { return _mm_set1_pd(value); }
+  static unsigned eq_mask(reg a, reg b) {
+    return _mm_movemask_pd(_mm_cmpeq_pd(a, b));
+  }
+  static reg min(reg a, reg b) { return _mm_min_pd(a, b); }
+  static reg max(reg a, reg b) { return _mm_max_pd(a, b); }
+  static acc_reg acc_zero() { return _mm_setzero_pd(); }
+  static acc_reg acc_add(acc_reg acc, reg v) { return _mm_add_pd(acc, v); }
+  static void acc_store(double *p, acc_reg acc) { _mm_storeu_pd(p, acc); }
+};
+
+template <typename T>
+struct avx2_ops;
+
+template <>
+struct avx2_ops<std::int32_t> {
+  using value_type = std::int32_t;
+  using reg = __m256i;
+  using acc_reg = __m256i;
+  static constexpr std::size_t lanes = 8;
+  static constexpr std::size_t acc_lanes = 4;
+
+  S21_SIMD_AVX2_TARGET static reg load(const value_type *p) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+  }
+  S21_SIMD_AVX2_TARGET static void store(value_type *p, reg v) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), v);
+  }
+  S21_SIMD_AVX2_TARGET static reg set1(value_type value) {
+    return _mm256_set1_epi32(value);
+  }
+  S21_SIMD_AVX2_TARGET static unsigned eq_mask(reg a, reg b) {
+    return _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(a, b)));
+  }
+  S21_SIMD_AVX2_TARGET static reg min(reg a, reg b) {
+    return _mm256_min_epi32(a, b);
+  }
+  S21_SIMD_AVX2_TARGET static reg max(reg a, reg b) {
+    return _mm256_max_epi32(a, b);
+  }
+  S21_SIMD_AVX2_TARGET static acc_reg acc_zero() {
+    return _mm256_setzero_si256();
+  }
+  S21_SIMD_AVX2_TARGET static acc_reg acc_add(acc_reg acc, reg v) {
+    acc = _mm256_add_epi64(
+        acc, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(v)));
+    return _mm256_add_epi64(
+        acc, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(v, 1)));
+  }
+  S21_SIMD_AVX2_TARGET static void acc_store(std::int64_t *p, acc_reg acc) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), acc);
+  }
+};
+
+template <>
+struct avx2_ops<float> {
+  using value_type = float;
+  using reg = __m256;
+  using acc_reg = __m256;
+  static constexpr std::size_t lanes = 8;
+  static constexpr std::size_t acc_lanes = 8;
+
+  S21_SIMD_AVX2_TARGET static reg load(const value_type *p) {
+    return _mm256_loadu_ps(p);
+  }
+  S21_SIMD_AVX2_TARGET static void store(value_type *p, reg v) {
+    _mm256_storeu_ps(p, v);
+  }
+  S21_SIMD_AVX2_TARGET static reg set1(value_type value) {
+    return _mm256_set1_ps(value);
+  }
+  S21_SIMD_AVX2_TARGET static unsigned eq_mask(reg a, reg b) {
+    return _mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_EQ_OQ));
+  }
+  S21_SIMD_AVX2_TARGET static reg min(reg a, reg b) {
+    return _mm256_min_ps(a, b);
+  }
+  S21_SIMD_AVX2_TARGET static reg max(reg a, reg b) {
+    return _mm256_max_ps(a, b);
+  }
+  S21_SIMD_AVX2_TARGET static acc_reg acc_zero() {
+    return _mm256_setzero_ps();
+  }
+  S21_SIMD_AVX2_TARGET static acc_reg acc_add(acc_reg acc, reg v) {
+    return _mm256_add_ps(acc, v);
+  }
+  S21_SIMD_AVX2_TARGET static void acc_store(float *p, acc_reg acc) {
+    _mm256_storeu_ps(p, acc);
+  }
+};
+
+template <>
+struct avx2_ops<double> {
+  using value_type = double;
+  using reg = __m256d;
+  using acc_reg = __m256d;
+  static constexpr std::size_t lanes = 4;
+  static constexpr std::size_t acc_lanes = 4;
+
+  S21_SIMD_AVX2_TARGET static reg load(const value_type *p) {
+    return _mm256_loadu_pd(p);
+  }
+  S21_SIMD_AVX2_TARGET static void store(value_type *p, reg v) {
+    _mm256_storeu_pd(p, v);
+  }
+  S21_SIMD_AVX2_TARGET static reg set1(value_type value) {
+    return _mm256_set1_pd(value);
+  }
+  S21_SIMD_AVX2_TARGET static unsigned eq_mask(reg a, reg b) {
+    return _mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_EQ_OQ));
+  }
+  S21_SIMD_AVX2_TARGET static reg min(reg a, reg b) {
+    return _mm256_min_pd(a, b);
+  }
+  S21_SIMD_AVX2_TARGET static reg max(reg a, reg b) {
+    return _mm256_max_pd(a, b);
+  }
+  S21_SIMD_AVX2_TARGET static acc_reg acc_zero() {
+    return _mm256_setzero_pd();
+  }
+  S21_SIMD_AVX2_TARGET static acc_reg acc_add(acc_reg acc, reg v) {
+    return _mm256_add_pd(acc, v);
+  }
+  S21_SIMD_AVX2_TARGET static void acc_store(double *p, acc_reg acc) {
+    _mm256_storeu_pd(p, acc);
+  }
+};
+
+// -------- Векторные ядра --------
+// Тело ядер общее для всех наборов инструкций, отличается только атрибут
+// target, поэтому оно разворачивается макросом в пространствах имен sse2 и
+// avx2. Хвост короче регистра обрабатывается скалярно. Для чисел с
+// плавающей точкой min/max считаются без учета NaN
+
+#define S21_SIMD_DEFINE_KERNELS(TARGET, OPS)                                  \
+  template <typename T>                                                       \
+  TARGET std::size_t find(const T *data, std::size_t n, T value) {            \
+    using ops = OPS<T>;                                                       \
+    const typename ops::reg needle = ops::set1(value);                        \
+    std::size_t i = 0;                                                        \
+    for (; i + ops::lanes <= n; i += ops::lanes) {                            \
+      unsigned mask = ops::eq_mask(ops::load(data + i), needle);              \
+      if (mask) return i + __builtin_ctz(mask);                               \
+    }                                                                         \
+    return i + scalar_find(data + i, n - i, value);                           \
+  }                                                                           \
+                                                                              \
+  template <typename T>                                                       \
+  TARGET std::size_t count(const T *data, std::size_t n, T value) {           \
+    using ops = OPS<T>;                                                       \
+    const typename ops::reg needle = ops::set1(value);                        \
+    std::size_t result = 0, i = 0;                                            \
+    for (; i + ops::lanes <= n; i += ops::lanes)                              \
+      result += __builtin_popcount(ops::eq_mask(ops::load(data + i), needle)); \
+    return result + scalar_count(data + i, n - i, value);                     \
+  }                                                                           \
+                                                                              \
+  /* Сначала находит минимальное значение, затем его первое вхождение */     \
+  template <typename T>                                                       \
+  TARGET std::size_t min_index(const T *data, std::size_t n) {                \
+    using ops = OPS<T>;                                                       \
+    if (n < ops::lanes) return scalar_min_index(data, n);                     \
+    typename ops::reg best = ops::load(data);                                 \
+    std::size_t i = ops::lanes;                                               \
+    for (; i + ops::lanes <= n; i += ops::lanes)                              \
+      best = ops::min(best, ops::load(data + i));                             \
+    T lanes[ops::lanes];                                                      \
+    ops::store(lanes, best);                                                  \
+    T value = lanes[scalar_min_index(lanes, ops::lanes)];                     \
+    for (; i < n; ++i)                                                        \
+      if (data[i] < value) value = data[i];                                   \
+    return find(data, n, value);                                              \
+  }                                                                           \
+                                                                              \
+  template <typename T>                                                       \
+  TARGET std::size_t max_index(const T *data, std::size_t n) {                \
+    using ops = OPS<T>;                                                       \
+    if (n < ops::lanes) return scalar_max_index(data, n);                     \
+    typename ops::reg best = ops::load(data);                                 \
+    std::size_t i = ops::lanes;                                               \
+    for (; i + ops::lanes <= n; i += ops::lanes)                              \
+      best = ops::max(best, ops::load(data + i));                             \
+    T lanes[ops::lanes];                                                      \
+    ops::store(lanes, best);                                                  \
+    T value = lanes[scalar_max_index(lanes, ops::lanes)];                     \
+    for (; i < n; ++i)                                                        \
+      if (value < data[i]) value = data[i];                                   \
+    return find(data, n, value);                                              \
+  }                                                                           \
+                                                                              \
+  template <typename T>                                                       \
+  TARGET typename traits<T>::sum_type sum(const T *data, std::size_t n) {     \
+    using ops = OPS<T>;                                                       \
+    typename ops::acc_reg acc = ops::acc_zero();                              \
+    std::size_t i = 0;                                                        \
+    for (; i + ops::lanes <= n; i += ops::lanes)                              \
+      acc = ops::acc_add(acc, ops::load(data + i));                           \
+    typename traits<T>::sum_type lanes[ops::acc_lanes];                       \
+    ops::acc_store(lanes, acc);                                               \
+    typename traits<T>::sum_type result = scalar_sum(data + i, n - i);        \
+    for (std::size_t j = 0; j < ops::acc_lanes; ++j) result += lanes[j];      \
+    return result;                                                            \
+  }                                                                           \
+                                                                              \
+  template <typename T>                                                       \
+  TARGET void fill(T *data, std::size_t n, T value) {                         \
+    using ops = OPS<T>;                                                       \
+    const typename ops::reg v = ops::set1(value);                             \
+    std::size_t i = 0;                                                        \
+    for (; i + ops::lanes <= n; i += ops::lanes) ops::store(data + i, v);     \
+    scalar_fill(data + i, n - i, value);                                      \
+  }                                                                           \
+                                                                              \
+  template <typename T>                                                       \
+  TARGET bool equal(const T *lhs, const T *rhs, std::size_t n) {              \
+    using ops = OPS<T>;                                                       \
+    constexpr unsigned all = (1u << ops::lanes) - 1;                          \
+    std::size_t i = 0;                                                        \
+    for (; i + ops::lanes <= n; i += ops::lanes)                              \
+      if (ops::eq_mask(ops::load(lhs + i), ops::load(rhs + i)) != all)        \
+        return false;                                                         \
+    return scalar_equal(lhs + i, rhs + i, n - i);                             \
+  }
+
+namespace sse2 {
+S21_SIMD_DEFINE_KERNELS(S21_SIMD_SSE2_TARGET, sse2_ops)
+}  // namespace sse2
+
+namespace avx2 {
+S21_SIMD_DEFINE_KERNELS(S21_SIMD_AVX2_TARGET, avx2_ops)
+}  // namespace avx2
+
+#undef S21_SIMD_DEFINE_KERNELS
+
+// Вызывает ядро KERNEL для активного набора инструкций
+#define S21_SIMD_DISPATCH(KERNEL, ...)                  \
+  switch (current_isa()) {                              \
+    case isa::avx2:                                     \
+      return avx2::KERNEL(__VA_ARGS__);                 \
+    case isa::sse2:                                     \
+      return sse2::KERNEL(__VA_ARGS__);                 \
+    default:                                            \
+      break;                                            \
+  }
+#else
+#define S21_SIMD_DISPATCH(KERNEL, ...)
+#endif
+
+// -------- Диспетчеры --------
+// Векторное ядро выбирается, если тип есть в traits, иначе сразу
+// используется скалярный цикл
+
+template <typename T>
+std::size_t find(const T *data, std::size_t n, const T &value) {
+  if constexpr (traits<T>::supported) {
+    S21_SIMD_DISPATCH(find, data, n, value)
+  }
+  return scalar_find(data, n, value);
+}
+
+template <typename T>
+std::size_t count(const T *data, std::size_t n, const T &value) {
+  if constexpr (traits<T>::supported) {
+    S21_SIMD_DISPATCH(count, data, n, value)
+  }
+  return scalar_count(data, n, value);
+}
+
+template <typename T>
+std::size_t min_index(const T *data, std::size_t n) {
+  if constexpr (traits<T>::supported) {
+    S21_SIMD_DISPATCH(min_index, data, n)
+  }
+  return scalar_min_index(data, n);
+}
+
+template <typename T>
+std::size_t max_index(const T *data, std::size_t n) {
+  if constexpr (traits<T>::supported) {
+    S21_SIMD_DISPATCH(max_index, data, n)
+  }
+  return scalar_max_index(data, n);
+}
+
+template <typename T>
+typename traits<T>::sum_type sum(const T *data, std::size_t n) {
+  if constexpr (traits<T>::supported) {
+    S21_SIMD_DISPATCH(sum, data, n)
+  }
+  return scalar_sum(data, n);
+}
+
+template <typename T>
+void fill(T *data, std::size_t n, const T &value) {
+  if constexpr (traits<T>::supported) {
+    S21_SIMD_DISPATCH(fill, data, n, value)
+  }
+  scalar_fill(data, n, value);
+}
+
+template <typename T>
+bool equal(const T *lhs, const T *rhs, std::size_t n) {
+  if constexpr (traits<T>::supported) {
+    S21_SIMD_DISPATCH(equal, lhs, rhs, n)
+  }
+  return scalar_equal(lhs, rhs, n);
+}
+
+#undef S21_SIMD_DISPATCH
+
+}  // namespace detail
+}  // namespace simd
+
+// -------- Алгоритмы над непрерывными диапазонами --------
+// Принимают указатели (например, vector::data() и array::data()) или сам
+// контейнер. Для int32_t, float и double выполняются векторными ядрами
+
+// Возвращает указатель на первый элемент, равный value, или last
+template <typename T>
+T *find(T *first, T *last, const simd::detail::value_t<T> &value) {
+  return first + simd::detail::find<std::remove_const_t<T>>(
+                     first, last - first, value);
+}
+
+// Возвращает количество элементов, равных value
+template <typename T>
+std::size_t count(const T *first, const T *last,
+                  const simd::detail::value_t<T> &value) {
+  return simd::detail::count<T>(first, last - first, value);
+}
+
+// Возвращает указатель на первый наименьший элемент или last
+template <typename T>
+T *min_element(T *first, T *last) {
+  return first + simd::detail::min_index<std::remove_const_t<T>>(
+                     first, last - first);
+}
+
+// Возвращает указатель на первый наибольший элемент или last
+template <typename T>
+T *max_element(T *first, T *last) {
+  return first + simd::detail::max_index<std::remove_const_t<T>>(
+                     first, last - first);
+}
+
+// Возвращает сумму элементов. Для float и double порядок сложения
+// отличается от последовательного, результат может отличаться в последних
+// разрядах
+template <typename T>
+typename simd::traits<T>::sum_type sum(const T *first, const T *last) {
+  return simd::detail::sum<T>(first, last - first);
+}
+
+// Присваивает value всем элементам диапазона
+template <typename T>
+void fill(T *first, T *last, const simd::detail::value_t<T> &value) {
+  simd::detail::fill<T>(first, last - first, value);
+}
+
+// Сравнивает диапазон [first1, last1) с диапазоном той же длины от first2
+template <typename T>
+bool equal(const T *first1, const T *last1, const T *first2) {
+  return simd::detail::equal<T>(first1, first2, last1 - first1);
+}
+
+// Перегрузки для контейнеров с непрерывным хранением (vector, array)
+
+template <typename Container, typename T>
+auto find(Container &c, const T &value) -> decltype(c.data()) {
+  return s21::find(c.data(), c.data() + c.size(), value);
+}
+
+template <typename Container, typename T>
+auto count(const Container &c, const T &value)
+    -> decltype(c.data(), std::size_t()) {
+  return s21::count(c.data(), c.data() + c.size(), value);
+}
+
+template <typename Container>
+auto min_element(Container &c) -> decltype(c.data()) {
+  return s21::min_element(c.data(), c.data() + c.size());
+}
+
+template <typename Container>
+auto max_element(Container &c) -> decltype(c.data()) {
+  return s21::max_element(c.data(), c.data() + c.size());
+}
+
+template <typename Container>
+auto sum(const Container &c) {
+  return s21::sum(c.data(), c.data() + c.size());
+}
+
+template <typename Container, typename T>
+auto fill(Container &c, const T &value) -> decltype(c.data(), void()) {
+  s21::fill(c.data(), c.data() + c.size(), value);
+}
+
+// Контейнеры равны, если совпадают размеры и все элементы
+template <typename Container>
+auto equal(const Container &lhs, const Container &rhs)
+    -> decltype(lhs.data(), bool()) {
+  return lhs.size() == rhs.size() &&
+         s21::equal(lhs.data(), lhs.data() + lhs.size(), rhs.data());
+}
+
+}  // namespace s21
+
+#endif
@@ -0,0 +1,305 @@
+#ifndef S21_CONCURRENT_MAP_H_
+#define S21_CONCURRENT_MAP_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/*
+    Реализация конкурентной хеш-таблицы с шардами
+    concurrent_map делит ключи между степенью двойки шардов по старшим
+   битам перемешанного хеша. Шард - это мьютекс и хеш-таблица с открытой
+   адресацией и линейным пробированием, выровненные по кеш-линии, чтобы
+   соседние шарды не делили линию. Потоки, работающие с разными шардами, не
+   мешают друг другу, поэтому пропускная способность растет с числом ядер,
+   в отличие от s21::map под одним мьютексом. Удаление сдвигает следующие
+   элементы цепочки назад, так что надгробий нет и поиск не замедляется.
+   Значения наружу отдаются копиями, а менять значение на месте можно
+   только через update под блокировкой шарда. Пакетные multi_get и
+   multi_put группируют ключи по шардам и берут блокировку каждого шарда
+   один раз на пакет.
+*/
+
+namespace s21 {
+
+template <typename Key, typename T, typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>>
+class concurrent_map {
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const Key, T>;
+  using size_type = std::size_t;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+
+  // shards округляется вверх до степени двойки. 0 - по четыре шарда на
+  // аппаратный поток
+  explicit concurrent_map(size_type shards = 0, const Hash &hash = Hash(),
+                          const KeyEqual &equal = KeyEqual())
+      : hash_(hash), equal_(equal) {
+    if (shards == 0) {
+      shards = size_type(std::thread::hardware_concurrency()) * 4;
+    }
+    shard_bits_ = 0;
+    while ((size_type(1) << shard_bits_) < shards) ++shard_bits_;
+    shards_.reset(new shard[size_type(1) << shard_bits_]);
+  }
+
+  concurrent_map(const concurrent_map &) = delete;
+  concurrent_map &operator=(const concurrent_map &) = delete;
+
+  // Capacity
+
+  // Число элементов. При параллельных изменениях - приблизительное
+  size_type size() const noexcept {
+    size_type total = 0;
+    for (size_type i = 0; i < shard_count(); ++i) {
+      total += shards_[i].size.load(std::memory_order_relaxed);
+    }
+    return total;
+  }
+
+  bool empty() const noexcept { return size() == 0; }
+
+  size_type shard_count() const noexcept {
+    return size_type(1) << shard_bits_;
+  }
+
+  hasher hash_function() const { return hash_; }
+  key_equal key_eq() const { return equal_; }
+
+  // Lookup
+
+  // Копия значения ключа или пустой optional
+  std::optional<T> find(const Key &key) const {
+    std::uint64_t hash = mix(key);
+    const shard &owner = shard_for(hash);
+    std::lock_guard<std::mutex> lock(owner.mutex);
+    const slot *found = owner.find(*this, key, hash);
+    if (found == nullptr) return std::nullopt;
+    return found->item->second;
+  }
+
+  bool contains(const Key &key) const {
+    std::uint64_t hash = mix(key);
+    const shard &owner = shard_for(hash);
+    std::lock_guard<std::mutex> lock(owner.mutex);
+    return owner.find(*this, key, hash) != nullptr;
+  }
+
+  // Modifiers
+
+  // Добавляет пару или заменяет значение. Возвращает true, если ключ
+  // добавлен
+  bool insert_or_assign(const Key &key, const T &obj) {
+    std::uint64_t hash = mix(key);
+    shard &owner = shard_for(hash);
+    std::lock_guard<std::mutex> lock(owner.mutex);
+    return owner.assign(*this, key, obj, hash);
+  }
+
+  size_type erase(const Key &key) {
+    std::uint64_t hash = mix(key);
+    shard &owner = shard_for(hash);
+    std::lock_guard<std::mutex> lock(owner.mutex);
+    return owner.erase(*this, key, hash);
+  }
+
+  // Вызывает fn(T &) для значения ключа под блокировкой его шарда, так
+  // что чтение и запись значения атомарны для других потоков. Возвращает
+  // false, если ключа нет. fn не должна обращаться к этой же таблице
+  template <typename Function>
+  bool update(const Key &key, Function fn) {
+    std::uint64_t hash = mix(key);
+    shard &owner = shard_for(hash);
+    std::lock_guard<std::mutex> lock(owner.mutex);
+    slot *found = owner.find(*this, key, hash);
+    if (found == nullptr) return false;
+    fn(found->item->second);
+    return true;
+  }
+
+  // Пишет в out[i] значение keys[i] или пустой optional
+  void multi_get(const Key *keys, size_type count,
+                 std::optional<T> *out) const {
+    std::vector<std::uint64_t> hashes(count);
+    for (size_type i = 0; i < count; ++i) hashes[i] = mix(keys[i]);
+    for_each_shard(hashes, [&](size_type index, const size_type *batch,
+                               size_type size) {
+      const shard &owner = shards_[index];
+      std::lock_guard<std::mutex> lock(owner.mutex);
+      for (size_type k = 0; k < size; ++k) {
+        size_type i = batch[k];
+        const slot *found = owner.find(*this, keys[i], hashes[i]);
+        out[i] = found == nullptr ? std::nullopt
+                                  : std::optional<T>(found->item->second);
+      }
+    });
+  }
+
+  // Добавляет или заменяет пары. Повторы ключа в пакете применяются по
+  // порядку
+  void multi_put(const value_type *items, size_type count) {
+    std::vector<std::uint64_t> hashes(count);
+    for (size_type i = 0; i < count; ++i) hashes[i] = mix(items[i].first);
+    for_each_shard(hashes, [&](size_type index, const size_type *batch,
+                               size_type size) {
+      shard &owner = shards_[index];
+      std::lock_guard<std::mutex> lock(owner.mutex);
+      for (size_type k = 0; k < size; ++k) {
+        size_type i = batch[k];
+        owner.assign(*this, items[i].first, items[i].second, hashes[i]);
+      }
+    });
+  }
+
+  void clear() {
+    for (size_type i = 0; i < shard_count(); ++i) {
+      std::lock_guard<std::mutex> lock(shards_[i].mutex);
+      shards_[i].slots.clear();
+      shards_[i].size.store(0, std::memory_order_relaxed);
+    }
+  }
+
+ private:
+  struct slot {
+    std::optional<std::pair<Key, T>> item;
+  };
+
+  // Шард занимает свои кеш-линии целиком
+  struct alignas(64) shard {
+    mutable std::mutex mutex;
+    std::vector<slot> slots;
+    std::atomic<size_type> size{0};
+
+    size_type mask() const noexcept { return slots.size() - 1; }
+
+    size_type home(std::uint64_t hash) const noexcept {
+      return size_type(hash & mask());
+    }
+
+    const slot *find(const concurrent_map &table, const Key &key,
+                     std::uint64_t hash) const {
+      if (slots.empty()) return nullptr;
+      for (size_type i = home(hash);; i = (i + 1) & mask()) {
+        const slot &current = slots[i];
+        if (!current.item) return nullptr;
+        if (table.equal_(current.item->first, key)) return &current;
+      }
+    }
+
+    slot *find(const concurrent_map &table, const Key &key,
+               std::uint64_t hash) {
+      return const_cast<slot *>(
+          std::as_const(*this).find(table, key, hash));
+    }
+
+    bool assign(const concurrent_map &table, const Key &key, const T &obj,
+                std::uint64_t hash) {
+      slot *found = find(table, key, hash);
+      if (found != nullptr) {
+        found->item->second = obj;
+        return false;
+      }
+      // заполнение не выше 3/4
+      size_type count = size.load(std::memory_order_relaxed) + 1;
+      if (count * 4 > slots.size() * 3) grow(table);
+      size_type i = home(hash);
+      while (slots[i].item) i = (i + 1) & mask();
+      slots[i].item.emplace(key, obj);
+      size.store(count, std::memory_order_relaxed);
+      return true;
+    }
+
+    // Удаляет ключ и сдвигает назад элементы, которые можно приблизить к
+    // их начальной позиции
+    size_type erase(const concurrent_map &table, const Key &key,
+                    std::uint64_t hash) {
+      slot *found = find(table, key, hash);
+      if (found == nullptr) return 0;
+      size_type hole = size_type(found - slots.data());
+      slots[hole].item.reset();
+      for (size_type i = (hole + 1) & mask(); slots[i].item;
+           i = (i + 1) & mask()) {
+        size_type start = home(table.mix(slots[i].item->first));
+        if (((i - start) & mask()) >= ((i - hole) & mask())) {
+          slots[hole].item = std::move(slots[i].item);
+          slots[i].item.reset();
+          hole = i;
+        }
+      }
+      size.fetch_sub(1, std::memory_order_relaxed);
+      return 1;
+    }
+
+    void grow(const concurrent_map &table) {
+      std::vector<slot> old(slots.empty() ? 8 : slots.size() * 2);
+      old.swap(slots);
+      for (slot &current : old) {
+        if (!current.item) continue;
+        size_type i = home(table.mix(current.item->first));
+        while (slots[i].item) i = (i + 1) & mask();
+        slots[i].item = std::move(current.item);
+      }
+    }
+  };
+
+  std::unique_ptr<shard[]> shards_;
+  unsigned shard_bits_;
+  Hash hash_;
+  KeyEqual equal_;
+
+  // Перемешивает биты хеша (финализатор MurmurHash3): std::hash для целых
+  // - тождественное отображение, а шард и позиция берутся из разных битов.
+  // Результат 64-битный и на 32-битных платформах: шард берется из
+  // старших битов, позиция в шарде - из младших
+  std::uint64_t mix(const Key &key) const {
+    std::uint64_t hash = std::uint64_t(hash_(key));
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ULL;
+    hash ^= hash >> 33;
+    return hash;
+  }
+
+  size_type shard_index(std::uint64_t hash) const noexcept {
+    return shard_bits_ == 0 ? 0 : size_type(hash >> (64 - shard_bits_));
+  }
+
+  shard &shard_for(std::uint64_t hash) const noexcept {
+    return shards_[shard_index(hash)];
+  }
+
+  // Раскладывает элементы пакета по шардам устойчивой сортировкой
+  // подсчетом и для каждого непустого шарда вызывает
+  // visit(index, batch, size) с индексами его элементов по порядку
+  template <typename Visit>
+  void for_each_shard(const std::vector<std::uint64_t> &hashes,
+                      Visit visit) const {
+    std::vector<size_type> starts(shard_count() + 1, 0);
+    for (std::uint64_t hash : hashes) ++starts[shard_index(hash) + 1];
+    for (size_type i = 0; i < shard_count(); ++i) starts[i + 1] += starts[i];
+    std::vector<size_type> order(hashes.size());
+    std::vector<size_type> fill(starts.begin(), starts.end() - 1);
+    for (size_type i = 0; i < hashes.size(); ++i) {
+      order[fill[shard_index(hashes[i])]++] = i;
+    }
+    for (size_type index = 0; index < shard_count(); ++index) {
+      size_type size = starts[index + 1] - starts[index];
+      if (size != 0) visit(index, order.data() + starts[index], size);
+    }
+  }
+};
+
+}  // namespace s21
+
+#endif
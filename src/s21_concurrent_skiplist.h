@@ -0,0 +1,441 @@
+#ifndef S21_CONCURRENT_SKIPLIST_H_
+#define S21_CONCURRENT_SKIPLIST_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <new>
+#include <utility>
+
+#include "s21_reclaim.h"
+
+/*
+    Реализация конкурентных упорядоченных множества и словаря
+    concurrent_skiplist_set и concurrent_skiplist_map - списки с пропусками
+   без блокировок: вставка, удаление, поиск и обход по возрастанию ключей
+   работают из любого числа потоков одновременно. Удаление сначала
+   помечает узел младшим битом ссылок на следующие узлы, а потом любой
+   проходящий поток вырезает помеченный узел одним CAS. Вырезанный узел
+   освобождается не сразу, а через reclaim::epoch_domain: поток на время
+   операции или жизни итератора объявляет текущую эпоху, и узел, удаленный
+   в эпоху e, освобождается, когда общая эпоха дошла до e + 2: тогда ни
+   один поток, видевший узел, уже не находится в секции.
+   Значения словаря после вставки не меняются: итератор отдает их по
+   константной ссылке. Итератор удерживает эпоху своего потока, поэтому
+   его нельзя передавать в другой поток, а долгоживущий итератор
+   задерживает освобождение памяти.
+*/
+
+namespace s21 {
+namespace detail {
+
+template <typename Key>
+struct skiplist_set_traits {
+  using value_type = Key;
+  static const Key &key(const value_type &value) noexcept { return value; }
+};
+
+template <typename Key, typename T>
+struct skiplist_map_traits {
+  using value_type = std::pair<const Key, T>;
+  static const Key &key(const value_type &value) noexcept {
+    return value.first;
+  }
+};
+
+// Список с пропусками без блокировок (Herlihy, Shavit). Ссылки на
+// следующие узлы хранятся как uintptr_t, младший бит - пометка удаления
+// узла, которому принадлежит ссылка
+template <typename Key, typename Traits>
+class skiplist {
+  using link = std::atomic<std::uintptr_t>;
+
+ public:
+  using value_type = typename Traits::value_type;
+  using size_type = std::size_t;
+
+  static constexpr int kMaxLevel = 20;
+
+  class iterator;
+
+  skiplist() : size_(0) {
+    for (link &head : head_) head.store(0, std::memory_order_relaxed);
+  }
+
+  skiplist(const skiplist &) = delete;
+  skiplist &operator=(const skiplist &) = delete;
+
+  // Разрушать список можно только без параллельных операций
+  ~skiplist() {
+    node *current = to_node(head_[0].load(std::memory_order_acquire));
+    while (current != nullptr) {
+      node *next = to_node(current->next()[0].load(std::memory_order_relaxed));
+      destroy_node(current);
+      current = next;
+    }
+  }
+
+  size_type size() const noexcept {
+    return size_.load(std::memory_order_relaxed);
+  }
+
+  bool insert(const value_type &value) {
+    reclaim::epoch_domain::guard guard;
+    const Key &key = Traits::key(value);
+    link *preds[kMaxLevel];
+    node *succs[kMaxLevel];
+    int levels = random_level();
+    node *fresh = nullptr;
+    while (true) {
+      if (search(key, preds, succs)) {
+        if (fresh != nullptr) destroy_node(fresh);
+        return false;
+      }
+      if (fresh == nullptr) fresh = create_node(levels, value);
+      for (int level = 0; level < levels; ++level) {
+        fresh->next()[level].store(to_link(succs[level]),
+                                   std::memory_order_relaxed);
+      }
+      std::uintptr_t expected = to_link(succs[0]);
+      if (preds[0][0].compare_exchange_strong(expected, to_link(fresh))) {
+        break;
+      }
+    }
+    size_.fetch_add(1, std::memory_order_relaxed);
+    link_upper(fresh, preds, succs);
+    release(fresh);
+    return true;
+  }
+
+  size_type erase(const Key &key) {
+    reclaim::epoch_domain::guard guard;
+    link *preds[kMaxLevel];
+    node *succs[kMaxLevel];
+    if (!search(key, preds, succs)) return 0;
+    node *victim = succs[0];
+    for (int level = victim->height - 1; level > 0; --level) {
+      victim->next()[level].fetch_or(1);
+    }
+    // узел удален в момент пометки нижнего уровня, и удалил его тот, кто
+    // поставил эту пометку
+    if ((victim->next()[0].fetch_or(1) & 1) != 0) return 0;
+    size_.fetch_sub(1, std::memory_order_relaxed);
+    search(key, preds, succs);
+    release(victim);
+    return 1;
+  }
+
+  bool contains(const Key &key) const {
+    reclaim::epoch_domain::guard guard;
+    const node *found = lower(key, false);
+    return found != nullptr && !(key < Traits::key(found->value));
+  }
+
+  iterator begin() const {
+    reclaim::epoch_domain::guard guard;
+    std::uintptr_t first = head_[0].load(std::memory_order_acquire);
+    return iterator(guard, first_live(first));
+  }
+  iterator end() const noexcept { return iterator(); }
+
+  iterator find(const Key &key) const {
+    reclaim::epoch_domain::guard guard;
+    node *found = lower(key, false);
+    if (found == nullptr || key < Traits::key(found->value)) return end();
+    return iterator(guard, found);
+  }
+
+  // Первый элемент с ключом не меньше key
+  iterator lower_bound(const Key &key) const {
+    reclaim::epoch_domain::guard guard;
+    return iterator(guard, lower(key, false));
+  }
+
+  // Первый элемент с ключом больше key
+  iterator upper_bound(const Key &key) const {
+    reclaim::epoch_domain::guard guard;
+    return iterator(guard, lower(key, true));
+  }
+
+ private:
+  struct alignas(link) node {
+    node(int levels, const value_type &item)
+        : value(item), height(levels), refs(2) {}
+
+    // Ссылки уровней лежат сразу за узлом
+    link *next() noexcept { return reinterpret_cast<link *>(this + 1); }
+
+    value_type value;
+    int height;
+    // Вставка и членство в списке: узел отдается домену, когда
+    // закончились и вставка, и удаление
+    std::atomic<int> refs;
+  };
+
+ public:
+  class iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = typename Traits::value_type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const value_type *;
+    using reference = const value_type &;
+
+    iterator() noexcept : guard_(nullptr), current_(nullptr) {}
+
+    reference operator*() const noexcept { return current_->value; }
+    pointer operator->() const noexcept { return &current_->value; }
+
+    iterator &operator++() {
+      std::uintptr_t next =
+          current_->next()[0].load(std::memory_order_acquire);
+      current_ = first_live(next);
+      if (current_ == nullptr) guard_.reset();
+      return *this;
+    }
+    iterator operator++(int) {
+      iterator old = *this;
+      ++*this;
+      return old;
+    }
+
+    bool operator==(const iterator &other) const noexcept {
+      return current_ == other.current_;
+    }
+    bool operator!=(const iterator &other) const noexcept {
+      return current_ != other.current_;
+    }
+
+   private:
+    friend class skiplist;
+
+    iterator(const reclaim::epoch_domain::guard &guard, node *current)
+        : guard_(guard), current_(current) {
+      if (current_ == nullptr) guard_.reset();
+    }
+
+    reclaim::epoch_domain::guard guard_;
+    node *current_;
+  };
+
+ private:
+  link head_[kMaxLevel];
+  std::atomic<size_type> size_;
+
+  static node *to_node(std::uintptr_t value) noexcept {
+    return reinterpret_cast<node *>(unmarked(value));
+  }
+  static std::uintptr_t unmarked(std::uintptr_t value) noexcept {
+    return value & ~std::uintptr_t(1);
+  }
+  static std::uintptr_t to_link(const node *value) noexcept {
+    return reinterpret_cast<std::uintptr_t>(value);
+  }
+  static bool marked(std::uintptr_t value) noexcept {
+    return (value & 1) != 0;
+  }
+
+  static node *create_node(int levels, const value_type &value) {
+    void *raw = ::operator new(sizeof(node) + sizeof(link) * levels);
+    node *fresh = nullptr;
+    try {
+      fresh = new (raw) node(levels, value);
+    } catch (...) {
+      ::operator delete(raw);
+      throw;
+    }
+    for (int level = 0; level < levels; ++level) {
+      new (&fresh->next()[level]) link(0);
+    }
+    return fresh;
+  }
+
+  static void destroy_node(void *object) {
+    node *victim = static_cast<node *>(object);
+    victim->~node();
+    ::operator delete(object);
+  }
+
+  static void release(node *item) {
+    if (item->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      reclaim::epoch_domain::global().retire(item, &destroy_node);
+    }
+  }
+
+  // Вероятность подняться на уровень выше - 1/4
+  static int random_level() noexcept {
+    thread_local std::uint64_t state =
+        reinterpret_cast<std::uintptr_t>(&state) | 1;
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    int zeros = __builtin_ctzll(state | (std::uint64_t(1) << 38));
+    return 1 + zeros / 2;
+  }
+
+  // Первый непомеченный узел, начиная с value
+  static node *first_live(std::uintptr_t value) noexcept {
+    node *current = to_node(value);
+    while (current != nullptr) {
+      std::uintptr_t next = current->next()[0].load(std::memory_order_acquire);
+      if (!marked(next)) break;
+      current = to_node(next);
+    }
+    return current;
+  }
+
+  // Находит на каждом уровне последнюю ссылку перед key и узел за ней,
+  // по пути вырезая помеченные узлы
+  bool search(const Key &key, link **preds, node **succs) {
+  retry:
+    link *pred = head_;
+    for (int level = kMaxLevel - 1; level >= 0; --level) {
+      node *current = to_node(pred[level].load(std::memory_order_acquire));
+      while (current != nullptr) {
+        std::uintptr_t succ =
+            current->next()[level].load(std::memory_order_acquire);
+        if (marked(succ)) {
+          std::uintptr_t expected = to_link(current);
+          if (!pred[level].compare_exchange_strong(expected, unmarked(succ))) {
+            goto retry;
+          }
+          current = to_node(succ);
+        } else if (Traits::key(current->value) < key) {
+          pred = current->next();
+          current = to_node(succ);
+        } else {
+          break;
+        }
+      }
+      preds[level] = pred;
+      succs[level] = current;
+    }
+    return succs[0] != nullptr && !(key < Traits::key(succs[0]->value));
+  }
+
+  // Поиск без изменений списка: помеченные узлы пропускаются
+  node *lower(const Key &key, bool strict) const {
+    const link *pred = head_;
+    node *current = nullptr;
+    for (int level = kMaxLevel - 1; level >= 0; --level) {
+      current = to_node(pred[level].load(std::memory_order_acquire));
+      while (current != nullptr) {
+        std::uintptr_t succ =
+            current->next()[level].load(std::memory_order_acquire);
+        const Key &here = Traits::key(current->value);
+        if (marked(succ)) {
+          current = to_node(succ);
+        } else if (here < key || (strict && !(key < here))) {
+          pred = current->next();
+          current = to_node(succ);
+        } else {
+          break;
+        }
+      }
+    }
+    return current;
+  }
+
+  // Вставляет уже связанный снизу узел в верхние уровни. Если узел
+  // удаляют параллельно, вставка прекращается, а связанные уровни
+  // вырезаются повторным поиском
+  void link_upper(node *fresh, link **preds, node **succs) {
+    const Key &key = Traits::key(fresh->value);
+    for (int level = 1; level < fresh->height; ++level) {
+      while (true) {
+        std::uintptr_t succ = to_link(succs[level]);
+        std::uintptr_t current =
+            fresh->next()[level].load(std::memory_order_acquire);
+        if (marked(current)) break;
+        if (current != succ &&
+            !fresh->next()[level].compare_exchange_strong(current, succ)) {
+          continue;
+        }
+        std::uintptr_t expected = succ;
+        if (preds[level][level].compare_exchange_strong(expected,
+                                                        to_link(fresh))) {
+          break;
+        }
+        search(key, preds, succs);
+        if (succs[0] != fresh) break;
+      }
+      if (marked(fresh->next()[level].load(std::memory_order_acquire))) break;
+    }
+    if (marked(fresh->next()[0].load(std::memory_order_acquire))) {
+      search(key, preds, succs);
+    }
+  }
+};
+
+}  // namespace detail
+
+template <typename Key>
+class concurrent_skiplist_set {
+  using list = detail::skiplist<Key, detail::skiplist_set_traits<Key>>;
+
+ public:
+  using key_type = Key;
+  using value_type = Key;
+  using size_type = std::size_t;
+  using iterator = typename list::iterator;
+  using const_iterator = iterator;
+
+  concurrent_skiplist_set() = default;
+
+  // Число элементов. При параллельных изменениях - приблизительное
+  size_type size() const noexcept { return list_.size(); }
+  bool empty() const noexcept { return size() == 0; }
+
+  bool insert(const Key &key) { return list_.insert(key); }
+  size_type erase(const Key &key) { return list_.erase(key); }
+  bool contains(const Key &key) const { return list_.contains(key); }
+
+  iterator begin() const { return list_.begin(); }
+  iterator end() const noexcept { return list_.end(); }
+  iterator find(const Key &key) const { return list_.find(key); }
+  iterator lower_bound(const Key &key) const { return list_.lower_bound(key); }
+  iterator upper_bound(const Key &key) const { return list_.upper_bound(key); }
+
+ private:
+  list list_;
+};
+
+template <typename Key, typename T>
+class concurrent_skiplist_map {
+  using list = detail::skiplist<Key, detail::skiplist_map_traits<Key, T>>;
+
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const Key, T>;
+  using size_type = std::size_t;
+  using iterator = typename list::iterator;
+  using const_iterator = iterator;
+
+  concurrent_skiplist_map() = default;
+
+  // Число элементов. При параллельных изменениях - приблизительное
+  size_type size() const noexcept { return list_.size(); }
+  bool empty() const noexcept { return size() == 0; }
+
+  // Добавляет пару, если ключа нет. Значение существующего ключа не меняется
+  bool insert(const Key &key, const T &obj) {
+    return list_.insert(value_type(key, obj));
+  }
+  size_type erase(const Key &key) { return list_.erase(key); }
+  bool contains(const Key &key) const { return list_.contains(key); }
+
+  iterator begin() const { return list_.begin(); }
+  iterator end() const noexcept { return list_.end(); }
+  iterator find(const Key &key) const { return list_.find(key); }
+  iterator lower_bound(const Key &key) const { return list_.lower_bound(key); }
+  iterator upper_bound(const Key &key) const { return list_.upper_bound(key); }
+
+ private:
+  list list_;
+};
+
+}  // namespace s21
+
+#endif
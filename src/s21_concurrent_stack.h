@@ -0,0 +1,171 @@
+#ifndef S21_CONCURRENT_STACK_H_
+#define S21_CONCURRENT_STACK_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <utility>
+
+#include "s21_reclaim.h"
+
+/*
+    Реализация конкурентного стека
+    concurrent_stack - стек Трайбера: вершина - атомарный указатель на
+   односвязный список, push и pop меняют ее одним CAS. Узел, который pop
+   читает перед CAS, защищен указателем опасности из s21::reclaim. Пока
+   он защищен, узел не освобождается и его адрес не может вернуться в
+   стек, поэтому CAS не путает старую вершину с новой (проблема ABA), а
+   снятый узел удаляется, когда его больше никто не читает. Под нагрузкой
+   CAS на вершине становится узким местом, поэтому после неудачного CAS
+   поток идет в массив исключения: push выкладывает узел в случайную
+   ячейку и немного ждет, а pop забирает выложенный узел. Такая пара
+   завершается, не трогая вершину, и стек масштабируется с числом
+   потоков. Порядок LIFO сохраняется для операций, которые не
+   пересекаются по времени.
+*/
+
+namespace s21 {
+
+template <typename T>
+class concurrent_stack {
+ public:
+  using value_type = T;
+  using size_type = std::size_t;
+
+  concurrent_stack() : head_(nullptr) {
+    unsigned threads = std::thread::hardware_concurrency();
+    width_ = 1;
+    while (width_ < kMaxWidth && width_ * 2 <= threads) width_ *= 2;
+    slots_.reset(new slot[width_]);
+  }
+
+  concurrent_stack(const concurrent_stack &) = delete;
+  concurrent_stack &operator=(const concurrent_stack &) = delete;
+
+  // Разрушать стек можно только без параллельных операций
+  ~concurrent_stack() {
+    node *current = head_.load(std::memory_order_relaxed);
+    while (current != nullptr) {
+      node *next = current->next;
+      delete current;
+      current = next;
+    }
+  }
+
+  // Приблизительно: при параллельных изменениях ответ мог устареть
+  bool empty() const noexcept {
+    return head_.load(std::memory_order_acquire) == nullptr;
+  }
+
+  void push(const T &value) { push_node(new node(value)); }
+  void push(T &&value) { push_node(new node(std::move(value))); }
+
+  template <typename... Args>
+  void emplace(Args &&...args) {
+    push_node(new node(std::forward<Args>(args)...));
+  }
+
+  // Снимает вершину. Пустой optional, если стек пуст
+  std::optional<T> pop() {
+    reclaim::hazard_domain::hazard_pointer hazard;
+    while (true) {
+      node *top = hazard.protect(head_);
+      if (top == nullptr) return std::nullopt;
+      if (head_.compare_exchange_weak(top, top->next,
+                                      std::memory_order_acquire,
+                                      std::memory_order_relaxed)) {
+        hazard.reset();
+        std::optional<T> value(std::move(top->value));
+        reclaim::hazard_domain::global().retire(top);
+        return value;
+      }
+      // узел из массива исключения в стеке не был: он сразу наш
+      node *taken = take_offer();
+      if (taken != nullptr) {
+        std::optional<T> value(std::move(taken->value));
+        delete taken;
+        return value;
+      }
+    }
+  }
+
+ private:
+  struct node {
+    template <typename... Args>
+    explicit node(Args &&...args) : value(std::forward<Args>(args)...) {}
+    T value;
+    node *next = nullptr;
+  };
+
+  // Ячейка массива исключения на своей кеш-линии
+  struct alignas(64) slot {
+    std::atomic<node *> offer{nullptr};
+  };
+
+  static constexpr unsigned kMaxWidth = 16;
+  // Сколько раз push проверяет, не забрали ли его узел
+  static constexpr int kOfferSpins = 64;
+
+  std::atomic<node *> head_;
+  std::unique_ptr<slot[]> slots_;
+  // Используемых ячеек, степень двойки
+  unsigned width_;
+
+  void push_node(node *fresh) {
+    fresh->next = head_.load(std::memory_order_relaxed);
+    while (!head_.compare_exchange_weak(fresh->next, fresh,
+                                        std::memory_order_release,
+                                        std::memory_order_relaxed)) {
+      if (offer(fresh)) return;
+      fresh->next = head_.load(std::memory_order_relaxed);
+    }
+  }
+
+  // Выкладывает узел в случайную ячейку и ждет pop. true, если узел забрали
+  bool offer(node *fresh) {
+    slot &cell = slots_[random_index()];
+    node *empty = nullptr;
+    if (!cell.offer.compare_exchange_strong(empty, fresh,
+                                            std::memory_order_release,
+                                            std::memory_order_relaxed)) {
+      return false;
+    }
+    for (int spin = 0; spin < kOfferSpins; ++spin) {
+      if (cell.offer.load(std::memory_order_acquire) != fresh) return true;
+    }
+    // забрать узел обратно не удалось - его уже взял pop
+    node *mine = fresh;
+    return !cell.offer.compare_exchange_strong(mine, nullptr,
+                                               std::memory_order_acquire,
+                                               std::memory_order_relaxed);
+  }
+
+  // Забирает узел, выложенный push, из случайной ячейки
+  node *take_offer() {
+    slot &cell = slots_[random_index()];
+    node *offered = cell.offer.load(std::memory_order_acquire);
+    if (offered == nullptr ||
+        !cell.offer.compare_exchange_strong(offered, nullptr,
+                                            std::memory_order_acquire,
+                                            std::memory_order_relaxed)) {
+      return nullptr;
+    }
+    return offered;
+  }
+
+  unsigned random_index() const noexcept {
+    thread_local std::uint32_t state =
+        std::uint32_t(reinterpret_cast<std::uintptr_t>(&state)) | 1;
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state & (width_ - 1);
+  }
+};
+
+}  // namespace s21
+
+#endif
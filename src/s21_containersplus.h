@@ -1,7 +1,26 @@
 #ifndef S21_CONTAINERSPLUS_H
 #define S21_CONTAINERSPLUS_H
 
+#include "s21_algorithm.h"
 #include "s21_array.h"
+#include "s21_concurrent_map.h"
+#include "s21_concurrent_skiplist.h"
+#include "s21_concurrent_stack.h"
+#include "s21_executor.h"
+#include "s21_external_sort.h"
+#include "s21_frozen.h"
+#include "s21_mmap_vector.h"
 #include "s21_multiset.h"
+#include "s21_parallel.h"
+#include "s21_persistent_map.h"
+#include "s21_persistent_vector.h"
+#include "s21_pinned_vector.h"
+#include "s21_rcu.h"
+#include "s21_reclaim.h"
+#include "s21_serialize.h"
+#include "s21_shm.h"
+#include "s21_sort.h"
+#include "s21_spilling_queue.h"
+#include "s21_work_stealing_deque.h"
 
 #endif
\ No newline at end of file
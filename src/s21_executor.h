@@ -0,0 +1,641 @@
+#ifndef S21_EXECUTOR_H_
+#define S21_EXECUTOR_H_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "s21_queue.h"
+#include "s21_work_stealing_deque.h"
+
+/*
+    Реализация исполнителя задач с кражей работы
+    executor держит рабочие потоки, у каждого своя work_stealing_deque с
+   указателями на задачи. Задача, поставленная из рабочего потока, кладется
+   в его деку, а из внешнего потока - в общую очередь s21::queue под
+   мьютексом. Поток берет работу из своей деки, затем из общей очереди,
+   затем крадет до половины задач у случайного соседа. Незанятый поток
+   сначала несколько раз ищет работу, уступая процессор, потом засыпает
+   на условной переменной. Постановка задачи будит поток, только если
+   кто-то спит, так что под нагрузкой она обходится без блокировок и
+   системных вызовов. submit возвращает s21::future с результатом, к
+   которому then добавляет продолжение. Рабочий поток, ожидающий future
+   или parallel_for, в это время выполняет другие задачи, поэтому
+   вложенные ожидания не блокируют пул.
+*/
+
+namespace s21 {
+
+template <typename R>
+class future;
+
+namespace detail {
+
+// Задача executor. invoke выполняет ее и удаляет, если она создана в куче
+struct executor_task {
+  using invoke_type = void (*)(executor_task *) noexcept;
+  explicit executor_task(invoke_type function) noexcept : invoke(function) {}
+  invoke_type invoke;
+};
+
+template <typename R>
+class future_state;
+
+// Общее состояние parallel_for: части индексов [first, first + count)
+template <typename Body>
+struct range_state {
+  struct chunk : executor_task {
+    chunk() noexcept : executor_task(&run) {}
+
+    static void run(executor_task *task) noexcept {
+      chunk *self = static_cast<chunk *>(task);
+      self->owner->work(self->index);
+    }
+
+    range_state *owner = nullptr;
+    std::size_t index = 0;
+  };
+
+  range_state(Body &function, std::size_t start, std::size_t size,
+              std::size_t parts)
+      : body(function),
+        first(start),
+        count(size),
+        chunks(parts),
+        left(parts) {
+    for (std::size_t i = 0; i < parts; ++i) {
+      chunks[i].owner = this;
+      chunks[i].index = i;
+    }
+  }
+
+  void work(std::size_t index) noexcept {
+    if (!failed.load(std::memory_order_relaxed)) {
+      std::size_t begin = first + count * index / chunks.size();
+      std::size_t end = first + count * (index + 1) / chunks.size();
+      try {
+        for (std::size_t i = begin; i < end; ++i) body(i);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(error_mutex);
+        if (!error) error = std::current_exception();
+        failed.store(true, std::memory_order_relaxed);
+      }
+    }
+    // после этого состояние может быть уже разрушено
+    left.fetch_sub(1, std::memory_order_acq_rel);
+  }
+
+  Body &body;
+  std::size_t first;
+  std::size_t count;
+  std::vector<chunk> chunks;
+  std::atomic<std::size_t> left;
+  std::atomic<bool> failed{false};
+  std::mutex error_mutex;
+  std::exception_ptr error;
+};
+
+}  // namespace detail
+
+class executor {
+ public:
+  using size_type = std::size_t;
+
+  // threads рабочих потоков, 0 - по числу аппаратных потоков
+  explicit executor(size_type threads = 0)
+      : count_(threads ? threads : default_threads()),
+        workers_(new worker[count_]) {
+    for (size_type i = 0; i < count_; ++i) {
+      workers_[i].thread = std::thread([this, i] { worker_loop(i); });
+    }
+  }
+
+  executor(const executor &) = delete;
+  executor &operator=(const executor &) = delete;
+
+  // Дожидается всех поставленных задач и останавливает потоки. Нельзя
+  // вызывать из задачи этого же executor
+  ~executor() {
+    stop_.store(true, std::memory_order_seq_cst);
+    wake_all();
+    for (size_type i = 0; i < count_; ++i) workers_[i].thread.join();
+  }
+
+  // Число рабочих потоков
+  size_type size() const noexcept { return count_; }
+
+  static size_type default_threads() noexcept {
+    size_type threads = std::thread::hardware_concurrency();
+    return threads ? threads : 1;
+  }
+
+  // Ставит fn() в очередь без результата. Исключение из fn завершает
+  // программу, как в std::thread
+  template <typename F>
+  void post(F &&fn) {
+    schedule(new post_task<std::decay_t<F>>(std::forward<F>(fn)));
+  }
+
+  // Ставит fn() в очередь. Результат или исключение придут в future
+  template <typename F>
+  auto submit(F &&fn) -> future<std::invoke_result_t<std::decay_t<F> &>> {
+    using result_type = std::invoke_result_t<std::decay_t<F> &>;
+    auto state = std::make_shared<detail::future_state<result_type>>(*this);
+    schedule(new submit_task<std::decay_t<F>, result_type>(
+        std::forward<F>(fn), state));
+    return future<result_type>(std::move(state));
+  }
+
+  // Вызывает body(i) для каждого i из [first, last) частями не меньше
+  // grain и ждет завершения. Вызывающий поток тоже выполняет части.
+  // Первое исключение из body пробрасывается, когда завершатся все части
+  template <typename Body>
+  void parallel_for(size_type first, size_type last, Body body,
+                    size_type grain = 1) {
+    if (first >= last) return;
+    size_type count = last - first;
+    if (grain == 0) grain = 1;
+    size_type chunks = std::min((count + grain - 1) / grain,
+                                (count_ + 1) * kChunksPerThread);
+    if (chunks == 1) {
+      for (size_type i = first; i < last; ++i) body(i);
+      return;
+    }
+    detail::range_state<Body> state(body, first, count, chunks);
+    schedule_all(state.chunks);
+    worker *self = local_worker();
+    while (state.left.load(std::memory_order_acquire) != 0) {
+      if (!run_one(self)) std::this_thread::yield();
+    }
+    if (state.error) std::rethrow_exception(state.error);
+  }
+
+ private:
+  template <typename R>
+  friend class detail::future_state;
+
+  // Рабочий поток со своей декой на отдельных кеш-линиях
+  struct alignas(64) worker {
+    work_stealing_deque<detail::executor_task *> tasks{256};
+    std::thread thread;
+  };
+
+  template <typename F>
+  struct post_task : detail::executor_task {
+    template <typename G>
+    explicit post_task(G &&fn)
+        : executor_task(&run), function(std::forward<G>(fn)) {}
+
+    static void run(executor_task *task) noexcept {
+      post_task *self = static_cast<post_task *>(task);
+      self->function();
+      delete self;
+    }
+
+    F function;
+  };
+
+  template <typename F, typename R>
+  struct submit_task : detail::executor_task {
+    template <typename G>
+    submit_task(G &&fn, std::shared_ptr<detail::future_state<R>> result)
+        : executor_task(&run),
+          function(std::forward<G>(fn)),
+          state(std::move(result)) {}
+
+    static void run(executor_task *task) noexcept {
+      submit_task *self = static_cast<submit_task *>(task);
+      self->state->fulfill(self->function);
+      delete self;
+    }
+
+    F function;
+    std::shared_ptr<detail::future_state<R>> state;
+  };
+
+  // Сколько частей parallel_for приходится на поток
+  static constexpr size_type kChunksPerThread = 4;
+  // Сколько задач можно украсть за раз
+  static constexpr size_type kStealBatch = 8;
+  // Сколько раз незанятый поток ищет работу перед сном
+  static constexpr int kSpins = 64;
+
+  size_type count_;
+  std::unique_ptr<worker[]> workers_;
+
+  std::mutex injected_mutex_;
+  s21::queue<detail::executor_task *> injected_;
+  std::atomic<size_type> injected_size_{0};
+
+  // Поставленные и еще не завершенные задачи
+  std::atomic<size_type> pending_{0};
+  std::atomic<bool> stop_{false};
+
+  // Сон незанятых потоков: поток запоминает epoch_, объявляет себя в
+  // sleepers_, еще раз ищет работу и спит, пока epoch_ не изменится
+  std::mutex park_mutex_;
+  std::condition_variable park_;
+  std::atomic<std::uint64_t> epoch_{0};
+  std::atomic<size_type> sleepers_{0};
+
+  static inline thread_local executor *local_owner_ = nullptr;
+  static inline thread_local worker *local_self_ = nullptr;
+
+  worker *local_worker() const noexcept {
+    return local_owner_ == this ? local_self_ : nullptr;
+  }
+
+  void schedule(detail::executor_task *task) {
+    pending_.fetch_add(1, std::memory_order_relaxed);
+    worker *self = local_worker();
+    if (self != nullptr) {
+      self->tasks.push(task);
+    } else {
+      std::lock_guard<std::mutex> lock(injected_mutex_);
+      injected_.push(task);
+      injected_size_.fetch_add(1, std::memory_order_relaxed);
+    }
+    notify(1);
+  }
+
+  // Ставит все задачи пакета и будит спящих один раз
+  template <typename Task>
+  void schedule_all(std::vector<Task> &tasks) {
+    pending_.fetch_add(tasks.size(), std::memory_order_relaxed);
+    worker *self = local_worker();
+    if (self != nullptr) {
+      for (Task &task : tasks) self->tasks.push(&task);
+    } else {
+      std::lock_guard<std::mutex> lock(injected_mutex_);
+      for (Task &task : tasks) injected_.push(&task);
+      injected_size_.fetch_add(tasks.size(), std::memory_order_relaxed);
+    }
+    notify(tasks.size());
+  }
+
+  // Рабочий поток executor выполняет задачи, пока done() не вернет true.
+  // Для внешнего потока возвращает false, не выполняя ничего
+  template <typename Predicate>
+  bool help_until(Predicate done) {
+    worker *self = local_worker();
+    if (self == nullptr) return false;
+    while (!done()) {
+      if (!run_one(self)) std::this_thread::yield();
+    }
+    return true;
+  }
+
+  // Находит и выполняет одну задачу. self - nullptr для внешнего потока
+  bool run_one(worker *self) {
+    detail::executor_task *task = find_task(self);
+    if (task == nullptr) return false;
+    task->invoke(task);
+    if (pending_.fetch_sub(1, std::memory_order_acq_rel) == 1 &&
+        stop_.load(std::memory_order_seq_cst)) {
+      wake_all();
+    }
+    return true;
+  }
+
+  detail::executor_task *find_task(worker *self) {
+    if (self != nullptr) {
+      if (auto task = self->tasks.pop()) return *task;
+    }
+    if (injected_size_.load(std::memory_order_relaxed) != 0) {
+      std::lock_guard<std::mutex> lock(injected_mutex_);
+      if (!injected_.empty()) {
+        detail::executor_task *task = injected_.front();
+        injected_.pop();
+        injected_size_.fetch_sub(1, std::memory_order_relaxed);
+        return task;
+      }
+    }
+    return steal(self);
+  }
+
+  // Обходит соседей со случайного. Рабочий поток забирает до половины
+  // задач соседа: первую выполняет, остальные кладет в свою деку
+  detail::executor_task *steal(worker *self) {
+    size_type start = random_index();
+    for (size_type k = 0; k < count_; ++k) {
+      worker &victim = workers_[(start + k) % count_];
+      if (&victim == self) continue;
+      if (self == nullptr) {
+        if (auto task = victim.tasks.steal()) return *task;
+        continue;
+      }
+      detail::executor_task *batch[kStealBatch];
+      size_type taken = victim.tasks.steal_half(batch, kStealBatch);
+      if (taken == 0) continue;
+      for (size_type i = 1; i < taken; ++i) self->tasks.push(batch[i]);
+      if (taken > 1) notify(taken - 1);
+      return batch[0];
+    }
+    return nullptr;
+  }
+
+  bool has_work() const noexcept {
+    if (injected_size_.load(std::memory_order_relaxed) != 0) return true;
+    for (size_type i = 0; i < count_; ++i) {
+      if (!workers_[i].tasks.empty()) return true;
+    }
+    return false;
+  }
+
+  bool finished() const noexcept {
+    return stop_.load(std::memory_order_seq_cst) &&
+           pending_.load(std::memory_order_seq_cst) == 0;
+  }
+
+  void worker_loop(size_type index) {
+    local_owner_ = this;
+    local_self_ = &workers_[index];
+    while (true) {
+      if (run_one(local_self_)) continue;
+      bool found = false;
+      for (int spin = 0; spin < kSpins && !found; ++spin) {
+        std::this_thread::yield();
+        found = run_one(local_self_);
+      }
+      if (!found && !park()) break;
+    }
+    local_owner_ = nullptr;
+    local_self_ = nullptr;
+  }
+
+  // Засыпает до новой работы. false - executor остановлен и задач нет
+  bool park() {
+    std::uint64_t ticket = epoch_.load(std::memory_order_acquire);
+    sleepers_.fetch_add(1, std::memory_order_relaxed);
+    // парный барьеру в notify: либо постановщик увидит спящего, либо
+    // поток здесь увидит задачу
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (has_work()) {
+      sleepers_.fetch_sub(1, std::memory_order_relaxed);
+      return true;
+    }
+    std::unique_lock<std::mutex> lock(park_mutex_);
+    park_.wait(lock, [&] {
+      return epoch_.load(std::memory_order_relaxed) != ticket || finished();
+    });
+    sleepers_.fetch_sub(1, std::memory_order_relaxed);
+    return !finished();
+  }
+
+  // Будит до tasks спящих потоков, если они есть
+  void notify(size_type tasks) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleepers_.load(std::memory_order_relaxed) == 0) return;
+    {
+      std::lock_guard<std::mutex> lock(park_mutex_);
+      epoch_.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (tasks == 1) {
+      park_.notify_one();
+    } else {
+      park_.notify_all();
+    }
+  }
+
+  void wake_all() {
+    {
+      std::lock_guard<std::mutex> lock(park_mutex_);
+      epoch_.fetch_add(1, std::memory_order_relaxed);
+    }
+    park_.notify_all();
+  }
+
+  size_type random_index() const noexcept {
+    thread_local std::uint32_t state =
+        std::uint32_t(reinterpret_cast<std::uintptr_t>(&state)) | 1;
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state % count_;
+  }
+};
+
+namespace detail {
+
+// Результат задачи executor: значение или исключение и продолжение,
+// которое ставится в очередь после готовности
+template <typename R>
+class future_state {
+ public:
+  using stored_type = std::conditional_t<std::is_void_v<R>, bool, R>;
+
+  explicit future_state(executor &owner) : owner_(owner) {}
+
+  // Вызывает fn(args...) и сохраняет результат или исключение
+  template <typename F, typename... Args>
+  void fulfill(F &fn, Args &&...args) noexcept {
+    try {
+      if constexpr (std::is_void_v<R>) {
+        fn(std::forward<Args>(args)...);
+        value_.emplace(true);
+      } else {
+        value_.emplace(fn(std::forward<Args>(args)...));
+      }
+    } catch (...) {
+      error_ = std::current_exception();
+    }
+    complete();
+  }
+
+  void fail(std::exception_ptr error) noexcept {
+    error_ = std::move(error);
+    complete();
+  }
+
+  bool ready() const noexcept {
+    return ready_.load(std::memory_order_acquire);
+  }
+
+  // Рабочий поток executor ждет, выполняя другие задачи, внешний сначала
+  // недолго уступает процессор, затем спит
+  void wait() {
+    if (ready() || owner_.help_until([this] { return ready(); })) return;
+    for (int spin = 0; spin < kSpins && !ready(); ++spin) {
+      std::this_thread::yield();
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    ++waiters_;
+    done_.wait(lock, [this] { return ready_.load(std::memory_order_relaxed); });
+    --waiters_;
+  }
+
+  // Исключение задачи или пустой указатель. Только после готовности
+  const std::exception_ptr &error() const noexcept { return error_; }
+
+  // Забирает результат или пробрасывает исключение. Только после
+  // готовности и только один раз
+  stored_type take() {
+    if (error_) std::rethrow_exception(error_);
+    return std::move(*value_);
+  }
+
+  // Ставит continuation в очередь сразу или после готовности
+  void then(executor_task *continuation) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!ready_.load(std::memory_order_relaxed)) {
+        continuation_ = continuation;
+        return;
+      }
+    }
+    owner_.schedule(continuation);
+  }
+
+  executor &owner() const noexcept { return owner_; }
+
+ private:
+  static constexpr int kSpins = 64;
+
+  executor &owner_;
+  std::optional<stored_type> value_;
+  std::exception_ptr error_;
+  std::atomic<bool> ready_{false};
+  std::mutex mutex_;
+  std::condition_variable done_;
+  unsigned waiters_ = 0;
+  executor_task *continuation_ = nullptr;
+
+  void complete() noexcept {
+    executor_task *next = nullptr;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      ready_.store(true, std::memory_order_release);
+      std::swap(next, continuation_);
+      if (waiters_ != 0) done_.notify_all();
+    }
+    if (next != nullptr) owner_.schedule(next);
+  }
+};
+
+template <typename F, typename R>
+struct continuation_result {
+  using type = std::invoke_result_t<F &, R>;
+};
+
+template <typename F>
+struct continuation_result<F, void> {
+  using type = std::invoke_result_t<F &>;
+};
+
+// Продолжение: вызывает fn с результатом antecedent или передает дальше
+// его исключение
+template <typename F, typename R, typename U>
+struct continuation_task : executor_task {
+  template <typename G>
+  continuation_task(G &&fn, std::shared_ptr<future_state<R>> from,
+                    std::shared_ptr<future_state<U>> to)
+      : executor_task(&run),
+        function(std::forward<G>(fn)),
+        antecedent(std::move(from)),
+        next(std::move(to)) {}
+
+  static void run(executor_task *task) noexcept {
+    continuation_task *self = static_cast<continuation_task *>(task);
+    if (self->antecedent->error()) {
+      self->next->fail(self->antecedent->error());
+    } else if constexpr (std::is_void_v<R>) {
+      self->next->fulfill(self->function);
+    } else {
+      self->next->fulfill(self->function, self->antecedent->take());
+    }
+    delete self;
+  }
+
+  F function;
+  std::shared_ptr<future_state<R>> antecedent;
+  std::shared_ptr<future_state<U>> next;
+};
+
+}  // namespace detail
+
+// Результат задачи executor. Пустой future (valid() == false) получается
+// конструктором по умолчанию и после get или then
+template <typename R>
+class future {
+ public:
+  using value_type = R;
+
+  future() noexcept = default;
+
+  bool valid() const noexcept { return bool(state_); }
+
+  // true, если результат готов и get не будет ждать
+  bool ready() const { return state().ready(); }
+
+  void wait() const { state().wait(); }
+
+  // Ждет и возвращает результат или пробрасывает исключение задачи
+  R get() {
+    state().wait();
+    std::shared_ptr<detail::future_state<R>> state = std::move(state_);
+    if constexpr (std::is_void_v<R>) {
+      state->take();
+    } else {
+      return state->take();
+    }
+  }
+
+  // Ставит fn(результат) на тот же executor после готовности. Если задача
+  // завершилась исключением, fn не вызывается, а исключение переходит в
+  // возвращаемый future
+  template <typename F>
+  auto then(F &&fn)
+      -> future<typename detail::continuation_result<std::decay_t<F>,
+                                                     R>::type> {
+    using next_type =
+        typename detail::continuation_result<std::decay_t<F>, R>::type;
+    detail::future_state<R> &current = state();
+    auto next =
+        std::make_shared<detail::future_state<next_type>>(current.owner());
+    current.then(new detail::continuation_task<std::decay_t<F>, R, next_type>(
+        std::forward<F>(fn), std::move(state_), next));
+    return future<next_type>(std::move(next));
+  }
+
+ private:
+  friend class executor;
+  template <typename>
+  friend class future;
+
+  explicit future(std::shared_ptr<detail::future_state<R>> state) noexcept
+      : state_(std::move(state)) {}
+
+  detail::future_state<R> &state() const {
+    if (!state_) throw std::logic_error("s21::future has no state");
+    return *state_;
+  }
+
+  std::shared_ptr<detail::future_state<R>> state_;
+};
+
+// Ждет все future из диапазона
+template <typename It, typename = decltype(std::declval<It &>()->wait())>
+void wait_all(It first, It last) {
+  for (; first != last; ++first) first->wait();
+}
+
+// Ждет все переданные future
+template <typename... R>
+void wait_all(const future<R> &...futures) {
+  (futures.wait(), ...);
+}
+
+}  // namespace s21
+
+#endif
@@ -0,0 +1,491 @@
+#ifndef S21_EXTERNAL_SORT_H_
+#define S21_EXTERNAL_SORT_H_
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "s21_serialize.h"
+#include "s21_sort.h"
+#include "s21_vector.h"
+
+/*
+    Внешняя сортировка слиянием
+    external_sorter сортирует больше элементов, чем помещается в память.
+   Элементы копятся в s21::vector, пока не кончится бюджет памяти, затем
+   порция сортируется s21::sort и сбрасывается во временный файл как
+   отсортированная серия. В конце серии сливаются через кучу, каждая читается
+   последовательно большими блоками. Если серий больше, чем позволяет память
+   под буферы, сначала идут промежуточные проходы слияния. Результат уходит в
+   функцию-приемник или в файл. Временные файлы удаляются из каталога сразу
+   после создания и исчезают вместе с дескрипторами. Элементы пишутся
+   побайтно, поэтому тип должен быть тривиально копируемым.
+*/
+
+namespace s21 {
+
+// Настройки внешней сортировки
+struct external_sort_options {
+  // Память под сортируемую порцию и буферы слияния
+  std::size_t memory_bytes = std::size_t(256) << 20;
+  // Предел места под временные файлы, 0 - без предела
+  std::uint64_t temp_bytes = 0;
+  // Каталог временных файлов, пустой - TMPDIR или /tmp
+  std::string temp_dir;
+  // Писать серии с O_DIRECT мимо страничного кеша. Где O_DIRECT нет или
+  // файловая система его не поддерживает, запись идет обычным путем
+  bool direct_io = false;
+};
+
+namespace detail {
+
+[[noreturn]] inline void throw_sort_errno(const char *what) {
+  throw std::system_error(errno, std::generic_category(), what);
+}
+
+// Временный файл серии: имя удаляется сразу, файл живет до закрытия
+class run_file {
+ public:
+  run_file(const std::string &dir, bool direct) : fd_(-1), count_(0) {
+    std::string pattern = dir + "/s21_sort_XXXXXX";
+    std::vector<char> name(pattern.begin(), pattern.end());
+    name.push_back('\0');
+    fd_ = mkstemp(name.data());
+    if (fd_ < 0) throw_sort_errno("external_sort: cannot create run file");
+    ::unlink(name.data());
+#ifdef O_DIRECT
+    if (direct) {
+      int flags = fcntl(fd_, F_GETFL);
+      if (flags >= 0) fcntl(fd_, F_SETFL, flags | O_DIRECT);
+    }
+#else
+    (void)direct;
+#endif
+  }
+
+  run_file(const run_file &) = delete;
+  run_file &operator=(const run_file &) = delete;
+  ~run_file() {
+    if (fd_ >= 0) ::close(fd_);
+  }
+
+  int fd() const noexcept { return fd_; }
+  std::uint64_t count() const noexcept { return count_; }
+  void set_count(std::uint64_t count) noexcept { count_ = count; }
+
+  // Выключает O_DIRECT, например для хвоста не кратного блоку. Возвращает
+  // true, если флаг был и снят
+  bool drop_direct() noexcept {
+#ifdef O_DIRECT
+    int flags = fcntl(fd_, F_GETFL);
+    if (flags >= 0 && (flags & O_DIRECT)) {
+      return fcntl(fd_, F_SETFL, flags & ~O_DIRECT) == 0;
+    }
+#endif
+    return false;
+  }
+
+ private:
+  int fd_;
+  std::uint64_t count_;
+};
+
+// Буфер, выровненный под O_DIRECT
+struct aligned_delete {
+  void operator()(unsigned char *data) const noexcept {
+    ::operator delete(data, std::align_val_t(kDirectAlignment));
+  }
+  static constexpr std::size_t kDirectAlignment = 4096;
+};
+
+using aligned_buffer = std::unique_ptr<unsigned char[], aligned_delete>;
+
+inline aligned_buffer make_aligned_buffer(std::size_t bytes) {
+  return aligned_buffer(static_cast<unsigned char *>(::operator new(
+      bytes, std::align_val_t(aligned_delete::kDirectAlignment))));
+}
+
+// Пишет серию целыми блоками, с O_DIRECT блоки и смещения остаются
+// выровненными
+template <typename T>
+class run_writer {
+ public:
+  explicit run_writer(run_file &run)
+      : run_(run), buffer_(make_aligned_buffer(kBlockBytes)), used_(0) {}
+
+  void write(const T *data, std::size_t count) {
+    const unsigned char *bytes = reinterpret_cast<const unsigned char *>(data);
+    std::size_t size = count * sizeof(T);
+    while (size > 0) {
+      std::size_t free = kBlockBytes - used_;
+      std::size_t part = free < size ? free : size;
+      std::memcpy(buffer_.get() + used_, bytes, part);
+      used_ += part;
+      bytes += part;
+      size -= part;
+      if (used_ == kBlockBytes) flush_block();
+    }
+    written_ += count;
+  }
+
+  void push(const T &value) { write(&value, 1); }
+
+  // Дописывает хвост и запоминает число элементов в серии. Хвост не
+  // кратен блоку, а серия дальше читается в обычные буферы, поэтому
+  // O_DIRECT здесь снимается
+  void finish() {
+    run_.drop_direct();
+    if (used_ > 0) flush_block();
+    run_.set_count(written_);
+  }
+
+ private:
+  static constexpr std::size_t kBlockBytes = std::size_t(1) << 20;
+
+  run_file &run_;
+  aligned_buffer buffer_;
+  std::size_t used_;
+  std::uint64_t written_ = 0;
+
+  void flush_block() {
+    const unsigned char *data = buffer_.get();
+    std::size_t size = used_;
+    while (size > 0) {
+      ssize_t done = ::write(run_.fd(), data, size);
+      if (done < 0) {
+        if (errno == EINTR) continue;
+        // файловая система отказалась от O_DIRECT, продолжаем обычной
+        // записью
+        if (errno == EINVAL && run_.drop_direct()) continue;
+        throw_sort_errno("external_sort: cannot write run");
+      }
+      data += done;
+      size -= std::size_t(done);
+    }
+    used_ = 0;
+  }
+};
+
+// Читает серию последовательно блоками заданного размера
+template <typename T>
+class run_reader {
+ public:
+  run_reader(const run_file &run, std::size_t buffer_elements)
+      : fd_(run.fd()),
+        left_(run.count()),
+        offset_(0),
+        capacity_(buffer_elements ? buffer_elements : 1),
+        buffer_(static_cast<T *>(::operator new(capacity_ * sizeof(T)))),
+        pos_(0),
+        end_(0) {
+#ifdef POSIX_FADV_SEQUENTIAL
+    posix_fadvise(fd_, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+    fill();
+  }
+
+  run_reader(run_reader &&other) noexcept
+      : fd_(other.fd_),
+        left_(other.left_),
+        offset_(other.offset_),
+        capacity_(other.capacity_),
+        buffer_(other.buffer_),
+        pos_(other.pos_),
+        end_(other.end_) {
+    other.buffer_ = nullptr;
+  }
+
+  run_reader(const run_reader &) = delete;
+  run_reader &operator=(const run_reader &) = delete;
+  run_reader &operator=(run_reader &&) = delete;
+  ~run_reader() { ::operator delete(buffer_); }
+
+  bool empty() const noexcept { return pos_ == end_; }
+  const T &head() const noexcept { return buffer_[pos_]; }
+
+  void advance() {
+    if (++pos_ == end_) fill();
+  }
+
+ private:
+  int fd_;
+  std::uint64_t left_;
+  std::uint64_t offset_;
+  std::size_t capacity_;
+  T *buffer_;
+  std::size_t pos_;
+  std::size_t end_;
+
+  void fill() {
+    std::size_t count = left_ < capacity_ ? std::size_t(left_) : capacity_;
+    unsigned char *data = reinterpret_cast<unsigned char *>(buffer_);
+    std::size_t size = count * sizeof(T);
+    while (size > 0) {
+      ssize_t done = ::pread(fd_, data, size, off_t(offset_));
+      if (done < 0 && errno == EINTR) continue;
+      if (done < 0) throw_sort_errno("external_sort: cannot read run");
+      if (done == 0) throw std::runtime_error("external_sort: run truncated");
+      data += done;
+      offset_ += std::uint64_t(done);
+      size -= std::size_t(done);
+    }
+    left_ -= count;
+    pos_ = 0;
+    end_ = count;
+  }
+};
+
+}  // namespace detail
+
+template <typename T, typename Compare = std::less<T>>
+class external_sorter {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "external_sorter stores only trivially copyable types");
+
+ public:
+  using value_type = T;
+  using size_type = std::size_t;
+
+  explicit external_sorter(const external_sort_options &options = {},
+                           Compare comp = Compare())
+      : options_(options), comp_(comp), size_(0), temp_used_(0) {
+    if (options_.temp_dir.empty()) {
+      const char *dir = std::getenv("TMPDIR");
+      options_.temp_dir = dir != nullptr && *dir != '\0' ? dir : "/tmp";
+    }
+    // половина бюджета - порция, вторая половина - буфер поразрядной
+    // сортировки
+    chunk_limit_ = options_.memory_bytes / (2 * sizeof(T));
+    if (chunk_limit_ < kMinChunk) chunk_limit_ = kMinChunk;
+  }
+
+  external_sorter(const external_sorter &) = delete;
+  external_sorter &operator=(const external_sorter &) = delete;
+
+  // Добавляет элемент. Когда порция заполнена, она сортируется и уходит
+  // во временный файл
+  void push(const T &value) {
+    if (chunk_.size() == chunk_limit_) spill();
+    if (chunk_.capacity() == 0) chunk_.reserve(chunk_limit_);
+    chunk_.push_back(value);
+    ++size_;
+  }
+
+  void push(const T *data, size_type count) {
+    for (size_type i = 0; i < count; ++i) push(data[i]);
+  }
+
+  // Сколько элементов добавлено
+  size_type size() const noexcept { return size_; }
+
+  // Сколько отсортированных серий уже лежит на диске
+  size_type runs() const noexcept { return runs_.size(); }
+
+  // Отдает элементы по возрастанию в sink(const T&) и очищает сортировщик
+  template <typename Sink>
+  void finish(Sink sink) {
+    if (runs_.empty()) {
+      s21::sort(chunk_.begin(), chunk_.end(), comp_);
+      for (const T &value : chunk_) sink(value);
+    } else {
+      if (!chunk_.empty()) spill();
+      // память порции больше не нужна, она уходит под буферы слияния
+      vector<T>().swap(chunk_);
+      size_type fan_in = max_fan_in();
+      while (runs_.size() > fan_in) merge_pass(fan_in);
+      merge(0, runs_.size(), sink);
+    }
+    reset();
+  }
+
+  // Пишет элементы по возрастанию в файл path как массив T
+  void finish(const std::string &path) {
+    int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC,
+                    0644);
+    if (fd < 0) detail::throw_sort_errno("external_sort: cannot open output");
+    try {
+      fd_writer out(fd);
+      finish([&out](const T &value) { out.write(&value, sizeof(T)); });
+      out.flush();
+    } catch (...) {
+      ::close(fd);
+      throw;
+    }
+    if (::close(fd) != 0) {
+      detail::throw_sort_errno("external_sort: cannot close output");
+    }
+  }
+
+ private:
+  // Порция не меньше этой, даже при крошечном бюджете
+  static constexpr size_type kMinChunk = 1024;
+  // Буфер чтения одной серии не меньше этого при слиянии
+  static constexpr size_type kMinMergeBuffer = size_type(256) << 10;
+  // Больше серий одновременно не открывается для чтения
+  static constexpr size_type kMaxFanIn = 512;
+
+  external_sort_options options_;
+  Compare comp_;
+  vector<T> chunk_;
+  size_type chunk_limit_;
+  size_type size_;
+  std::uint64_t temp_used_;
+  std::vector<std::unique_ptr<detail::run_file>> runs_;
+
+  size_type max_fan_in() const noexcept {
+    size_type fan_in = options_.memory_bytes / kMinMergeBuffer;
+    if (fan_in < 2) fan_in = 2;
+    return fan_in < kMaxFanIn ? fan_in : kMaxFanIn;
+  }
+
+  // Проверяет бюджет временного места перед записью count элементов
+  void reserve_temp(std::uint64_t count) {
+    std::uint64_t bytes = count * sizeof(T);
+    if (options_.temp_bytes != 0 &&
+        temp_used_ + bytes > options_.temp_bytes) {
+      throw std::length_error("external_sort: temporary space exhausted");
+    }
+    temp_used_ += bytes;
+  }
+
+  std::unique_ptr<detail::run_file> new_run() {
+    return std::make_unique<detail::run_file>(options_.temp_dir,
+                                              options_.direct_io);
+  }
+
+  // Сортирует порцию и сбрасывает ее в новую серию
+  void spill() {
+    reserve_temp(chunk_.size());
+    s21::sort(chunk_.begin(), chunk_.end(), comp_);
+    std::unique_ptr<detail::run_file> run = new_run();
+    detail::run_writer<T> writer(*run);
+    writer.write(chunk_.data(), chunk_.size());
+    writer.finish();
+    runs_.push_back(std::move(run));
+    chunk_.clear();
+  }
+
+  // Сливает серии [first, last) и отдает элементы в sink. Куча хранит
+  // номера серий с наименьшей головой наверху, после каждого элемента
+  // просеивается только вершина
+  template <typename Sink>
+  void merge(size_type first, size_type last, Sink &sink) {
+    size_type ways = last - first;
+    size_type buffer_bytes = options_.memory_bytes / (ways + 1);
+    if (buffer_bytes < kMinMergeBuffer) buffer_bytes = kMinMergeBuffer;
+    std::vector<detail::run_reader<T>> readers;
+    readers.reserve(ways);
+    std::vector<size_type> heap;
+    heap.reserve(ways);
+    for (size_type i = first; i < last; ++i) {
+      readers.emplace_back(*runs_[i], buffer_bytes / sizeof(T));
+      if (!readers.back().empty()) heap.push_back(readers.size() - 1);
+    }
+    auto greater = [this, &readers](size_type a, size_type b) {
+      return comp_(readers[b].head(), readers[a].head());
+    };
+    for (size_type i = heap.size() / 2; i-- > 0;) sift_down(heap, i, greater);
+    while (!heap.empty()) {
+      detail::run_reader<T> &top = readers[heap[0]];
+      sink(top.head());
+      top.advance();
+      if (top.empty()) {
+        heap[0] = heap.back();
+        heap.pop_back();
+      }
+      if (!heap.empty()) sift_down(heap, 0, greater);
+    }
+  }
+
+  template <typename Greater>
+  static void sift_down(std::vector<size_type> &heap, size_type i,
+                        Greater greater) {
+    size_type n = heap.size();
+    size_type item = heap[i];
+    for (size_type child = 2 * i + 1; child < n; child = 2 * i + 1) {
+      if (child + 1 < n && greater(heap[child], heap[child + 1])) ++child;
+      if (!greater(item, heap[child])) break;
+      heap[i] = heap[child];
+      i = child;
+    }
+    heap[i] = item;
+  }
+
+  // Промежуточный проход: первые fan_in серий сливаются в одну новую
+  void merge_pass(size_type fan_in) {
+    std::uint64_t count = 0;
+    for (size_type i = 0; i < fan_in; ++i) count += runs_[i]->count();
+    reserve_temp(count);
+    std::unique_ptr<detail::run_file> run = new_run();
+    detail::run_writer<T> writer(*run);
+    auto sink = [&writer](const T &value) { writer.push(value); };
+    merge(0, fan_in, sink);
+    writer.finish();
+    // слитые серии закрываются, их место освобождается
+    for (size_type i = 0; i < fan_in; ++i) {
+      temp_used_ -= runs_[i]->count() * sizeof(T);
+    }
+    runs_.erase(runs_.begin(), runs_.begin() + fan_in);
+    runs_.push_back(std::move(run));
+  }
+
+  void reset() noexcept {
+    runs_.clear();
+    chunk_.clear();
+    size_ = 0;
+    temp_used_ = 0;
+  }
+};
+
+// Сортирует файл input из элементов T и пишет результат в output
+template <typename T, typename Compare = std::less<T>>
+void external_sort(const std::string &input, const std::string &output,
+                   const external_sort_options &options = {},
+                   Compare comp = Compare()) {
+  int fd = ::open(input.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) detail::throw_sort_errno("external_sort: cannot open input");
+  external_sorter<T, Compare> sorter(options, comp);
+  try {
+    struct stat st;
+    if (fstat(fd, &st) != 0) detail::throw_sort_errno("external_sort: fstat");
+    if (std::uint64_t(st.st_size) % sizeof(T) != 0) {
+      throw std::runtime_error("external_sort: input size is not a multiple "
+                               "of the element size");
+    }
+    std::uint64_t count = std::uint64_t(st.st_size) / sizeof(T);
+    fd_reader in(fd);
+    for (std::uint64_t i = 0; i < count; ++i) {
+      T value;
+      in.read(&value, sizeof(T));
+      sorter.push(value);
+    }
+  } catch (...) {
+    ::close(fd);
+    throw;
+  }
+  ::close(fd);
+  sorter.finish(output);
+}
+
+}  // namespace s21
+
+#endif  // defined(__unix__) || defined(__APPLE__)
+
+#endif
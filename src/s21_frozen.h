@@ -0,0 +1,531 @@
+#ifndef S21_FROZEN_H_
+#define S21_FROZEN_H_
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define S21_FROZEN_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#define S21_FROZEN_MMAP 0
+#endif
+
+#include "s21_map.h"
+#include "s21_set.h"
+
+/*
+    Реализация замороженных множества и словаря
+    frozen_set и frozen_map - неизменяемые копии set и map для справочных
+   данных, которые строятся один раз. Ключи лежат в порядке Эйтцингера
+   (дерево поиска, уложенное в массив по уровням): спуск идет от индекса k к
+   2k или 2k + 1 без ветвлений, а первые уровни всех поисков попадают в одни и
+   те же строки кеша. Весь контейнер - один непрерывный образ без указателей:
+   заголовок, массив ключей и массив значений в том же порядке. save пишет
+   образ в файл, open отображает файл в память только на чтение, и поиск сразу
+   работает по отображенным байтам, без разбора и построения дерева. Поэтому
+   ключи и значения должны быть тривиально копируемыми.
+*/
+
+namespace s21 {
+namespace detail {
+
+// Пустое значение для frozen_set, в образ не пишется
+struct frozen_no_value {};
+
+// Заголовок образа, массивы выравниваются на 64 байта от его начала
+struct frozen_header {
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t kind;
+  std::uint32_t key_size;
+  std::uint32_t value_size;
+  std::uint64_t size;
+  std::uint64_t keys_offset;
+  std::uint64_t values_offset;
+  std::uint64_t image_bytes;
+  char reserved[8];
+};
+
+static_assert(sizeof(frozen_header) == 64, "unexpected frozen header layout");
+
+// Общая часть frozen_set и frozen_map: образ и поиск по нему. Индексы
+// ключей начинаются с 1, 0 означает "нет элемента"
+template <typename Key, typename T, std::uint32_t Kind>
+class frozen_table {
+  static_assert(std::is_trivially_copyable_v<Key> &&
+                    std::is_trivially_copyable_v<T>,
+                "frozen containers store only trivially copyable types");
+  static_assert(alignof(Key) <= 64 && alignof(T) <= 64,
+                "element alignment is too big");
+
+ public:
+  using size_type = std::size_t;
+
+  frozen_table() noexcept
+      : image_(nullptr),
+        bytes_(0),
+        mapped_(false),
+        keys_(nullptr),
+        values_(nullptr),
+        size_(0) {}
+
+  frozen_table(const frozen_table &) = delete;
+  frozen_table &operator=(const frozen_table &) = delete;
+
+  frozen_table(frozen_table &&other) noexcept : frozen_table() {
+    swap(other);
+  }
+
+  frozen_table &operator=(frozen_table &&other) noexcept {
+    if (this != &other) {
+      frozen_table moved(std::move(other));
+      swap(moved);
+    }
+    return *this;
+  }
+
+  ~frozen_table() { release(); }
+
+  void swap(frozen_table &other) noexcept {
+    std::swap(image_, other.image_);
+    std::swap(bytes_, other.bytes_);
+    std::swap(mapped_, other.mapped_);
+    std::swap(keys_, other.keys_);
+    std::swap(values_, other.values_);
+    std::swap(size_, other.size_);
+  }
+
+  size_type size() const noexcept { return size_; }
+
+  // Работает ли контейнер прямо по отображенному файлу
+  bool mapped() const noexcept { return mapped_; }
+
+  // Образ целиком, его можно передать по сети или записать самостоятельно
+  const void *image() const noexcept { return image_; }
+  size_type image_size() const noexcept { return bytes_; }
+
+  const Key &key(size_type k) const noexcept { return keys_[k]; }
+  const T &value(size_type k) const noexcept { return values_[k]; }
+
+  // Строит образ из n пар, которые source выдает в порядке возрастания
+  // ключей. Ключи раскладываются сразу по местам обходом дерева в порядке
+  // возрастания
+  template <typename Source>
+  void build(size_type n, Source source) {
+    release();
+    size_type keys_offset = sizeof(frozen_header);
+    size_type values_offset = align(keys_offset + (n + 1) * sizeof(Key));
+    size_type bytes = kHasValues
+                          ? align(values_offset + (n + 1) * sizeof(T))
+                          : values_offset;
+    image_ = static_cast<unsigned char *>(
+        ::operator new(bytes, std::align_val_t(kAlignment)));
+    std::memset(image_, 0, bytes);
+    bytes_ = bytes;
+    frozen_header *head = reinterpret_cast<frozen_header *>(image_);
+    std::memcpy(head->magic, kMagic, sizeof(kMagic));
+    head->version = kVersion;
+    head->kind = Kind;
+    head->key_size = sizeof(Key);
+    head->value_size = kHasValues ? sizeof(T) : 0;
+    head->size = n;
+    head->keys_offset = keys_offset;
+    head->values_offset = kHasValues ? values_offset : 0;
+    head->image_bytes = bytes;
+    attach(head);
+    Key *keys = reinterpret_cast<Key *>(image_ + keys_offset);
+    T *values = reinterpret_cast<T *>(image_ + values_offset);
+    for (size_type k = first(); k != 0; k = next(k)) {
+      if constexpr (kHasValues) {
+        source(keys[k], values[k]);
+      } else {
+        T none;
+        source(keys[k], none);
+      }
+    }
+  }
+
+  // Пишет образ в файл
+  void save(const std::string &path) const {
+    std::FILE *file = std::fopen(path.c_str(), "wb");
+    if (file == nullptr) throw_errno("frozen: cannot create " + path);
+    bool written = std::fwrite(image_, 1, bytes_, file) == bytes_;
+    if (std::fclose(file) != 0 || !written) {
+      throw_errno("frozen: cannot write " + path);
+    }
+  }
+
+  // Открывает образ из файла. Где есть mmap, файл отображается только на
+  // чтение и не копируется, иначе читается в память
+  void open(const std::string &path) {
+    release();
+#if S21_FROZEN_MMAP
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) throw_errno("frozen: cannot open " + path);
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+      ::close(fd);
+      throw_errno("frozen: fstat failed");
+    }
+    size_type bytes = size_type(st.st_size);
+    void *pages = MAP_FAILED;
+    if (bytes >= sizeof(frozen_header)) {
+      pages = mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, 0);
+      if (pages == MAP_FAILED) {
+        ::close(fd);
+        throw_errno("frozen: mmap failed");
+      }
+    }
+    ::close(fd);
+    if (pages == MAP_FAILED) throw std::runtime_error("frozen: bad image");
+    image_ = static_cast<unsigned char *>(pages);
+    bytes_ = bytes;
+    mapped_ = true;
+#else
+    std::FILE *file = std::fopen(path.c_str(), "rb");
+    if (file == nullptr) throw_errno("frozen: cannot open " + path);
+    std::fseek(file, 0, SEEK_END);
+    long end = std::ftell(file);
+    std::fseek(file, 0, SEEK_SET);
+    size_type bytes = end > 0 ? size_type(end) : 0;
+    image_ = static_cast<unsigned char *>(
+        ::operator new(bytes ? bytes : 1, std::align_val_t(kAlignment)));
+    bytes_ = bytes;
+    bool read = std::fread(image_, 1, bytes, file) == bytes;
+    std::fclose(file);
+    if (!read) {
+      release();
+      throw std::runtime_error("frozen: cannot read " + path);
+    }
+#endif
+    try {
+      attach(checked_header());
+    } catch (...) {
+      release();
+      throw;
+    }
+  }
+
+  // Индекс первого ключа не меньше key, 0 если такого нет. Спуск без
+  // ветвлений: бит сравнения сразу выбирает левого или правого потомка,
+  // а потомки на четыре уровня вперед лежат рядом и подгружаются заранее
+  size_type lower_bound(const Key &key) const noexcept {
+    size_type k = 1;
+    while (k <= size_) {
+#if defined(__GNUC__)
+      if (k * kPrefetchStride <= size_) {
+        __builtin_prefetch(keys_ + k * kPrefetchStride);
+      }
+#endif
+      k = 2 * k + size_type(keys_[k] < key);
+    }
+    // подъем по последним правым поворотам приводит к ответу
+    k >>= __builtin_ffsll(static_cast<long long>(~k));
+    return k;
+  }
+
+  // Индекс ключа key, 0 если его нет
+  size_type find(const Key &key) const noexcept {
+    size_type k = lower_bound(key);
+    return k != 0 && !(key < keys_[k]) ? k : 0;
+  }
+
+  // Первый по порядку индекс, 0 для пустого образа
+  size_type first() const noexcept {
+    if (size_ == 0) return 0;
+    size_type k = 1;
+    while (2 * k <= size_) k *= 2;
+    return k;
+  }
+
+  // Следующий по порядку индекс, 0 после последнего
+  size_type next(size_type k) const noexcept {
+    if (2 * k + 1 <= size_) {
+      k = 2 * k + 1;
+      while (2 * k <= size_) k *= 2;
+      return k;
+    }
+    // поднимаемся, пока k - правый потомок
+    k >>= __builtin_ffsll(static_cast<long long>(~k));
+    return k;
+  }
+
+ private:
+  static constexpr bool kHasValues = !std::is_empty_v<T>;
+  static constexpr size_type kAlignment = 64;
+  // Потомки через 4 уровня: 16 ключей, одна-две строки кеша
+  static constexpr size_type kPrefetchStride = 16;
+  static constexpr char kMagic[8] = {'S', '2', '1', 'F', 'R', 'O', 'Z', '\0'};
+  static constexpr std::uint32_t kVersion = 1;
+
+  unsigned char *image_;
+  size_type bytes_;
+  bool mapped_;
+  const Key *keys_;
+  const T *values_;
+  size_type size_;
+
+  static size_type align(size_type bytes) noexcept {
+    return (bytes + kAlignment - 1) / kAlignment * kAlignment;
+  }
+
+  [[noreturn]] static void throw_errno(const std::string &what) {
+    throw std::system_error(errno, std::generic_category(), what);
+  }
+
+  void attach(const frozen_header *head) noexcept {
+    size_ = size_type(head->size);
+    keys_ = reinterpret_cast<const Key *>(image_ + head->keys_offset);
+    values_ = kHasValues
+                  ? reinterpret_cast<const T *>(image_ + head->values_offset)
+                  : nullptr;
+  }
+
+  // Проверяет, что заголовок описывает именно такой контейнер и массивы не
+  // выходят за пределы образа
+  const frozen_header *checked_header() const {
+    if (bytes_ < sizeof(frozen_header)) {
+      throw std::runtime_error("frozen: bad image");
+    }
+    const frozen_header *head = reinterpret_cast<const frozen_header *>(image_);
+    if (std::memcmp(head->magic, kMagic, sizeof(kMagic)) != 0 ||
+        head->version != kVersion || head->kind != Kind) {
+      throw std::runtime_error("frozen: not a frozen image of this kind");
+    }
+    if (head->key_size != sizeof(Key) ||
+        head->value_size != (kHasValues ? sizeof(T) : 0)) {
+      throw std::runtime_error("frozen: element size mismatch");
+    }
+    std::uint64_t slots = head->size + 1;
+    bool fits =
+        head->size < bytes_ && head->image_bytes == bytes_ &&
+        head->keys_offset % kAlignment == 0 &&
+        head->keys_offset <= bytes_ &&
+        slots <= (bytes_ - head->keys_offset) / sizeof(Key) &&
+        (!kHasValues || (head->values_offset % kAlignment == 0 &&
+                         head->values_offset <= bytes_ &&
+                         slots <= (bytes_ - head->values_offset) / sizeof(T)));
+    if (!fits) throw std::runtime_error("frozen: image is truncated");
+    return head;
+  }
+
+  void release() noexcept {
+    if (image_ != nullptr) {
+#if S21_FROZEN_MMAP
+      if (mapped_) {
+        munmap(image_, bytes_);
+      } else {
+        ::operator delete(image_, std::align_val_t(kAlignment));
+      }
+#else
+      ::operator delete(image_, std::align_val_t(kAlignment));
+#endif
+    }
+    image_ = nullptr;
+    bytes_ = 0;
+    mapped_ = false;
+    keys_ = nullptr;
+    values_ = nullptr;
+    size_ = 0;
+  }
+};
+
+// Итератор по возрастанию ключей. Разыменование дает ключ для множества и
+// пару ссылок на ключ и значение для словаря
+template <typename Table, typename Reference>
+class frozen_iterator {
+ public:
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = std::remove_cv_t<std::remove_reference_t<Reference>>;
+  using difference_type = std::ptrdiff_t;
+  using reference = Reference;
+
+  frozen_iterator() noexcept : table_(nullptr), index_(0) {}
+  frozen_iterator(const Table *table, std::size_t index) noexcept
+      : table_(table), index_(index) {}
+
+  reference operator*() const noexcept {
+    if constexpr (std::is_reference_v<Reference>) {
+      return table_->key(index_);
+    } else {
+      return reference(table_->key(index_), table_->value(index_));
+    }
+  }
+
+  frozen_iterator &operator++() noexcept {
+    index_ = table_->next(index_);
+    return *this;
+  }
+
+  frozen_iterator operator++(int) noexcept {
+    frozen_iterator old = *this;
+    ++*this;
+    return old;
+  }
+
+  bool operator==(const frozen_iterator &other) const noexcept {
+    return index_ == other.index_;
+  }
+  bool operator!=(const frozen_iterator &other) const noexcept {
+    return index_ != other.index_;
+  }
+
+ private:
+  const Table *table_;
+  std::size_t index_;
+};
+
+}  // namespace detail
+
+template <typename Key>
+class frozen_set {
+  using table = detail::frozen_table<Key, detail::frozen_no_value, 1>;
+
+ public:
+  using key_type = Key;
+  using value_type = Key;
+  using const_reference = const Key &;
+  using size_type = std::size_t;
+  using const_iterator = detail::frozen_iterator<table, const Key &>;
+  using iterator = const_iterator;
+
+  // Пустое множество
+  frozen_set() noexcept = default;
+
+  // Замораживает копию множества
+  explicit frozen_set(const set<Key> &items) {
+    auto it = items.begin();
+    table_.build(items.size(), [&it](Key &key, detail::frozen_no_value &) {
+      key = *it;
+      ++it;
+    });
+  }
+
+  // Открывает образ, записанный save. Ошибки открытия и отображения
+  // сообщаются std::system_error, чужой или поврежденный образ -
+  // std::runtime_error
+  static frozen_set open(const std::string &path) {
+    frozen_set result;
+    result.table_.open(path);
+    return result;
+  }
+
+  // Записывает образ в файл
+  void save(const std::string &path) const { table_.save(path); }
+
+  const_iterator begin() const noexcept {
+    return const_iterator(&table_, table_.first());
+  }
+  const_iterator end() const noexcept { return const_iterator(&table_, 0); }
+
+  bool empty() const noexcept { return table_.size() == 0; }
+  size_type size() const noexcept { return table_.size(); }
+  bool mapped() const noexcept { return table_.mapped(); }
+  const void *image() const noexcept { return table_.image(); }
+  size_type image_size() const noexcept { return table_.image_size(); }
+
+  bool contains(const Key &key) const noexcept {
+    return table_.find(key) != 0;
+  }
+  size_type count(const Key &key) const noexcept { return contains(key); }
+  const_iterator find(const Key &key) const noexcept {
+    return const_iterator(&table_, table_.find(key));
+  }
+  const_iterator lower_bound(const Key &key) const noexcept {
+    return const_iterator(&table_, table_.lower_bound(key));
+  }
+
+  void swap(frozen_set &other) noexcept { table_.swap(other.table_); }
+
+ private:
+  table table_;
+};
+
+template <typename Key, typename T>
+class frozen_map {
+  using table = detail::frozen_table<Key, T, 2>;
+
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const Key &, const T &>;
+  using size_type = std::size_t;
+  using const_iterator = detail::frozen_iterator<table, value_type>;
+  using iterator = const_iterator;
+
+  // Пустой словарь
+  frozen_map() noexcept = default;
+
+  // Замораживает копию словаря
+  explicit frozen_map(const map<Key, T> &items) {
+    auto it = items.begin();
+    table_.build(items.size(), [&it](Key &key, T &value) {
+      key = (*it).first;
+      value = (*it).second;
+      ++it;
+    });
+  }
+
+  // Открывает образ, записанный save. Ошибки открытия и отображения
+  // сообщаются std::system_error, чужой или поврежденный образ -
+  // std::runtime_error
+  static frozen_map open(const std::string &path) {
+    frozen_map result;
+    result.table_.open(path);
+    return result;
+  }
+
+  // Записывает образ в файл
+  void save(const std::string &path) const { table_.save(path); }
+
+  const_iterator begin() const noexcept {
+    return const_iterator(&table_, table_.first());
+  }
+  const_iterator end() const noexcept { return const_iterator(&table_, 0); }
+
+  bool empty() const noexcept { return table_.size() == 0; }
+  size_type size() const noexcept { return table_.size(); }
+  bool mapped() const noexcept { return table_.mapped(); }
+  const void *image() const noexcept { return table_.image(); }
+  size_type image_size() const noexcept { return table_.image_size(); }
+
+  // Доступ к значению по ключу, отсутствующий ключ - std::out_of_range
+  const T &at(const Key &key) const {
+    size_type k = table_.find(key);
+    if (k == 0) throw std::out_of_range("Key is not found");
+    return table_.value(k);
+  }
+
+  bool contains(const Key &key) const noexcept {
+    return table_.find(key) != 0;
+  }
+  size_type count(const Key &key) const noexcept { return contains(key); }
+  const_iterator find(const Key &key) const noexcept {
+    return const_iterator(&table_, table_.find(key));
+  }
+  const_iterator lower_bound(const Key &key) const noexcept {
+    return const_iterator(&table_, table_.lower_bound(key));
+  }
+
+  void swap(frozen_map &other) noexcept { table_.swap(other.table_); }
+
+ private:
+  table table_;
+};
+
+}  // namespace s21
+
+#endif
@@ -10,6 +10,7 @@ class list {
   // --------- Member types ---------
   class ListIterator;
   class ListConstIterator;
+  class ListNodeBase;
   class ListNode;
   // --------- PUBLIC ---------
  public:
@@ -21,10 +22,8 @@ class list {
   using const_iterator = ListConstIterator;
 
   // --------- Constructors & Destructors ---------
-  list() {
-    size_ = 0;
-    head_ = new ListNode;
-  }
+  // головной узел хранится внутри списка, пустой список не выделяет память
+  list() noexcept : size_(0), head_() {}
 
   explicit list(size_type count) : list() {
     for (size_type i = 0; i < count; i++) {
@@ -40,12 +39,9 @@ class list {
 
   list(const list& other) : list() { *this = other; }
 
-  list(list&& other) : list() { *this = std::move(other); }
+  list(list&& other) noexcept : list() { take_nodes(other); }
 
-  ~list() {
-    clear();
-    delete head_;
-  }
+  ~list() { clear(); }
 
   // --------- Public methods ---------
 
@@ -68,21 +64,21 @@ class list {
     return *this;
   }
 
-  list& operator=(list&& other) {
+  list& operator=(list&& other) noexcept {
     if (this != &other) {
       clear();
-      swap(other);
+      take_nodes(other);
     }
     return *this;
   }
-  const_reference front() const noexcept { return head_->next_->data_; }
+  const_reference front() const noexcept { return node_value(head_.next_); }
 
-  const_reference back() const noexcept { return head_->prev_->data_; }
+  const_reference back() const noexcept { return node_value(head_.prev_); }
 
-  iterator begin() noexcept { return iterator(head_->next_); }
-  const_iterator begin() const noexcept { return const_iterator(head_->next_); }
-  iterator end() noexcept { return iterator(head_); }
-  const_iterator end() const noexcept { return const_iterator(head_); }
+  iterator begin() noexcept { return iterator(head_.next_); }
+  const_iterator begin() const noexcept { return const_iterator(head_.next_); }
+  iterator end() noexcept { return iterator(end_node()); }
+  const_iterator end() const noexcept { return const_iterator(end_node()); }
 
   bool empty() const noexcept { return size_ == 0; }
   size_type size() const noexcept { return size_; }
@@ -97,30 +93,43 @@ class list {
   }
 
   iterator insert(iterator pos, const value_type& value) {
-    ListNode* newNode = new ListNode;
-    newNode->data_ = value;
-    newNode->next_ = pos.currentNode_;
-    newNode->prev_ = pos.currentNode_->prev_;
+    return emplace(pos, value);
+  }
 
-    if (pos.currentNode_->prev_ != nullptr) {
-      pos.currentNode_->prev_->next_ = newNode;
-    }
-    pos.currentNode_->prev_ = newNode;
+  iterator insert(iterator pos, value_type&& value) {
+    return emplace(pos, std::move(value));
+  }
+
+  // создает элемент из аргументов прямо в новом узле перед pos
+  template <typename... Args>
+  iterator emplace(const_iterator pos, Args&&... args) {
+    ListNodeBase* newNode = new ListNode(std::forward<Args>(args)...);
+    link_node(pos.currentNode_, newNode);
     size_++;
     return iterator(newNode);
   }
 
   void erase(iterator pos) {
-    if (pos.currentNode_ != head_) {
-      pos.currentNode_->prev_->next_ = pos.currentNode_->next_;
-      pos.currentNode_->next_->prev_ = pos.currentNode_->prev_;
+    if (pos.currentNode_ != end_node()) {
+      unlink_node(pos.currentNode_);
 
-      delete pos.currentNode_;
+      delete static_cast<ListNode*>(pos.currentNode_);
       size_--;
     }
   }
 
+  // удаляет узлы в диапазоне [first, last), перебалансировка не нужна
+  iterator erase(const_iterator first, const_iterator last) {
+    while (first != last) {
+      iterator current(first.currentNode_);
+      ++first;
+      erase(current);
+    }
+    return iterator(last.currentNode_);
+  }
+
   void push_back(const_reference value) { insert(end(), value); }
+  void push_back(value_type&& value) { insert(end(), std::move(value)); }
   void pop_back() {
     if (empty()) {
       throw std::out_of_range("list is empty");
@@ -129,16 +138,18 @@ class list {
   }
 
   void push_front(const_reference value) { insert(begin(), value); }
+  void push_front(value_type&& value) { insert(begin(), std::move(value)); }
   void pop_front() {
     if (empty()) {
       throw std::out_of_range("list is empty");
     }
     erase(begin());
   }
-  void swap(list& other) {
+  void swap(list& other) noexcept {
     if (this != &other) {
-      std::swap(size_, other.size_);
-      std::swap(head_, other.head_);
+      list temp(std::move(other));
+      other.take_nodes(*this);
+      take_nodes(temp);
     }
   }
 
@@ -151,8 +162,7 @@ class list {
         if (*iter_other < *iter) {
           iterator temp = iter_other;
           ++iter_other;
-          insert(iter, *temp);
-          other.erase(temp);
+          splice(iter, other, temp);
         } else {
           ++iter;
         }
@@ -175,8 +185,19 @@ class list {
 
       size_ += other.size_;
       other.size_ = 0;
-      other.head_->next_ = other.head_;
-      other.head_->prev_ = other.head_;
+      other.head_.next_ = other.end_node();
+      other.head_.prev_ = other.end_node();
+    }
+  }
+
+  // переносит один узел it из other перед pos без выделения памяти
+  void splice(const_iterator pos, list& other, const_iterator it) noexcept {
+    if (it.currentNode_ != other.end_node() &&
+        it.currentNode_ != pos.currentNode_) {
+      unlink_node(it.currentNode_);
+      link_node(pos.currentNode_, it.currentNode_);
+      other.size_--;
+      size_++;
     }
   }
 
@@ -250,12 +271,11 @@ class list {
     }
   }
 
+  // каждый аргумент передается прямо в конструктор своего узла
   template <typename... Args>
   iterator insert_many(const_iterator pos, Args&&... args) {
     iterator iter(pos.currentNode_);
-    for (auto elem : {std::forward<Args>(args)...}) {
-      insert(iter, elem);
-    }
+    (emplace(iter, std::forward<Args>(args)), ...);
     return iter;
   }
 
@@ -272,26 +292,68 @@ class list {
  private:
   // --------- Node class ---------
 
-  class ListNode {
+  // узел без данных, из него состоит головной узел списка
+  class ListNodeBase {
+   public:
+    ListNodeBase* next_;
+    ListNodeBase* prev_;
+    ListNodeBase() : next_(this), prev_(this) {}
+  };
+
+  class ListNode : public ListNodeBase {
    public:
     value_type data_;
-    ListNode* next_;
-    ListNode* prev_;
-    ListNode() {
-      data_ = value_type{};
-      next_ = this;
-      prev_ = this;
-    }
+    template <typename... Args>
+    explicit ListNode(Args&&... args)
+        : ListNodeBase(), data_(std::forward<Args>(args)...) {}
   };
 
+  // --------- Private methods ---------
+
+  ListNodeBase* end_node() const noexcept {
+    return const_cast<ListNodeBase*>(&head_);
+  }
+
+  static reference node_value(ListNodeBase* node) noexcept {
+    return static_cast<ListNode*>(node)->data_;
+  }
+
+  // прицепляет узел перед pos
+  static void link_node(ListNodeBase* pos, ListNodeBase* node) noexcept {
+    node->next_ = pos;
+    node->prev_ = pos->prev_;
+    pos->prev_->next_ = node;
+    pos->prev_ = node;
+  }
+
+  // отцепляет узел от соседей, не освобождая его
+  static void unlink_node(ListNodeBase* node) noexcept {
+    node->prev_->next_ = node->next_;
+    node->next_->prev_ = node->prev_;
+  }
+
+  // забирает узлы другого списка и перецепляет их к своему головному узлу
+  void take_nodes(list& other) noexcept {
+    if (!other.empty()) {
+      head_.next_ = other.head_.next_;
+      head_.prev_ = other.head_.prev_;
+      head_.next_->prev_ = end_node();
+      head_.prev_->next_ = end_node();
+      size_ = other.size_;
+      other.head_.next_ = other.end_node();
+      other.head_.prev_ = other.end_node();
+      other.size_ = 0;
+    }
+  }
+
   class ListIterator {
    private:
-    ListNode* currentNode_;
+    ListNodeBase* currentNode_;
     friend class list;
 
    public:
     ListIterator() { currentNode_ = nullptr; }
-    ListIterator(ListNode* node) { currentNode_ = node; }
+    ListIterator(ListNodeBase* node) { currentNode_ = node; }
     ListIterator(const iterator& other) { currentNode_ = other.currentNode_; }
 
     // --------- Operators ---------
@@ -324,7 +386,7 @@ class list {
       return temp;
     }
 
-    reference operator*() { return currentNode_->data_; }
+    reference operator*() { return node_value(currentNode_); }
 
     bool operator==(const iterator& other) const {
       return currentNode_ == other.currentNode_;
@@ -337,7 +399,7 @@ class list {
 
   class ListConstIterator {
    private:
-    ListNode* currentNode_;
+    ListNodeBase* currentNode_;
     friend list;
 
     friend bool operator==(const const_iterator& iter1,
@@ -351,14 +413,14 @@ class list {
 
    public:
     ListConstIterator() { currentNode_ = nullptr; }
-    ListConstIterator(ListNode* node) { currentNode_ = node; }
+    ListConstIterator(ListNodeBase* node) { currentNode_ = node; }
     ListConstIterator(const const_iterator& other) {
       currentNode_ = other.currentNode_;
     }
     ListConstIterator(const ListIterator& it) {
       currentNode_ = it.currentNode_;
     }
-    const_reference operator*() { return currentNode_->data_; }
+    const_reference operator*() { return node_value(currentNode_); }
 
     const_iterator& operator=(const const_iterator& other) {
       if (this != &other) {
@@ -391,8 +453,19 @@ class list {
   };
   // --------- Private fields ---------
   size_type size_;
-  ListNode* head_;
+  ListNodeBase head_;
 };
+
+// удаляет из списка все элементы, удовлетворяющие предикату
+template <typename T, typename Pred>
+std::size_t erase_if(list<T>& container, Pred pred) {
+  std::size_t old_size = container.size();
+  for (auto it = container.begin(); it != container.end();) {
+    auto current = it++;
+    if (pred(*current)) container.erase(current);
+  }
+  return old_size - container.size();
+}
 }  // namespace s21
 
 #endif
\ No newline at end of file
@@ -1,6 +1,10 @@
 #ifndef SRC_S21_MAP_H_
 #define SRC_S21_MAP_H_
 
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
 #include "s21_tree.h"
 
 /*
@@ -16,6 +20,13 @@
 */
 
 namespace s21 {
+template <typename Key, typename T>
+class map;
+
+// Удаляет из словаря все элементы, удовлетворяющие предикату
+template <typename Key, typename T, typename Pred>
+std::size_t erase_if(map<Key, T>& container, Pred pred);
+
 template <typename Key, typename T>
 class map {
   using key_type = Key;
@@ -23,15 +34,32 @@ class map {
   using value_type = std::pair<const key_type, mapped_type>;
   using reference = value_type&;
   using const_reference = const value_type&;
-  using tree = RBTree<value_type>;
+
+  // Сравнивает элементы словаря только по ключу, а также элементы с ключом,
+  // чтобы искать по ключу без создания пары
+  struct key_compare {
+    bool operator()(const value_type& a, const value_type& b) const {
+      return std::less<Key>{}(a.first, b.first);
+    }
+    bool operator()(const Key& a, const value_type& b) const {
+      return std::less<Key>{}(a, b.first);
+    }
+    bool operator()(const value_type& a, const Key& b) const {
+      return std::less<Key>{}(a.first, b);
+    }
+  };
+
+  using tree = RBTree<value_type, key_compare>;
   using size_type = std::size_t;
 
  public:
   using iterator = typename tree::iterator;
   using const_iterator = typename tree::const_iterator;
+  using node_type = typename tree::node_type;
+  using insert_return_type = typename tree::insert_return_type;
 
   // Конструктор по умолчанию, создает пустой словарь
-  map() : tree_() {}
+  map() noexcept : tree_() {}
 
   // Конструктор списка инициализации, создает словарь, инициализированный с
   // помощью std::initializer_list
@@ -45,7 +73,7 @@ class map {
   map(const map& m) : tree_(m.tree_) {}
 
   // Конструктор перемещения
-  map(map&& m) : tree_(std::move(m.tree_)) {}
+  map(map&& m) noexcept : tree_(std::move(m.tree_)) {}
 
   // Деструктор
   ~map() = default;
@@ -57,7 +85,7 @@ class map {
   }
 
   // Перегрузка оператора присваивания для перемещения объекта
-  map& operator=(map&& m) {
+  map& operator=(map&& m) noexcept {
     tree_ = std::move(m.tree_);
     return *this;
   }
@@ -77,15 +105,8 @@ class map {
   }
 
   // Доступ или вставка указанного элемента
-  T& operator[](const Key& key) {
-    value_type value = {key, mapped_type{}};
-    iterator it = map_find(key);
-    if (it == tree_.end()) {
-      auto res = tree_.insert(value);
-      return (*res.first).second;
-    }
-    return (*it).second;
-  }
+  // значение по умолчанию создается только для отсутствующего ключа
+  T& operator[](const Key& key) { return (*try_emplace(key).first).second; }
 
   // Возвращает итератор в начало
   iterator begin() noexcept { return tree_.begin(); }
@@ -114,47 +135,94 @@ class map {
   // Вставляет узел и возвращает итератор туда, где находится элемент,
   // и флаг, указывающий, произошла ли вставка
   std::pair<iterator, bool> insert(const value_type& value) {
-    iterator it = map_find(value.first);
-    if (it == end()) {
-      auto res = tree_.insert(value);
-      return res;
-    }
-    return {it, false};
+    return tree_.insert(value);
   }
 
   // Вставляет значение по ключу и возвращает итератор туда, где находится
   // элемент, и флаг, указывающий, произошла ли вставка
   std::pair<iterator, bool> insert(const Key& key, const T& obj) {
-    value_type value = {key, obj};
-    iterator it = map_find(value.first);
-    if (it == end()) {
-      auto res = tree_.insert(value);
-      return res;
-    }
-    return {it, false};
+    return try_emplace(key, obj);
   }
 
   // Вставляет элемент или присваивает текущему элементу, если ключ уже
   // существует
   std::pair<iterator, bool> insert_or_assign(const Key& key, const T& obj) {
-    value_type value = {key, obj};
-    iterator it = map_find(key);
-    if (it == tree_.end())
-      return tree_.insert(value);
-    else {
-      (*it).second = obj;
-      return {it, false};
+    std::pair<iterator, bool> res = try_emplace(key, obj);
+    if (!res.second) (*res.first).second = obj;
+    return res;
+  }
+
+  // Создает элемент из ключа и значения прямо в узле дерева и вставляет
+  // его, если ключа еще нет. Ключ ищется до создания значения, поэтому при
+  // повторе значение не конструируется
+  template <typename K, typename M>
+  std::pair<iterator, bool> emplace(K&& key, M&& obj) {
+    if constexpr (std::is_same_v<std::decay_t<K>, Key>) {
+      return try_emplace(std::forward<K>(key), std::forward<M>(obj));
+    } else {
+      return try_emplace(Key(std::forward<K>(key)), std::forward<M>(obj));
     }
   }
 
+  // То же для готовой пары
+  template <typename P>
+  std::pair<iterator, bool> emplace(P&& item) {
+    return emplace(std::get<0>(std::forward<P>(item)),
+                   std::get<1>(std::forward<P>(item)));
+  }
+
+  // То же для пары, собираемой из кортежей аргументов ключа и значения
+  template <typename... KeyArgs, typename... Args>
+  std::pair<iterator, bool> emplace(std::piecewise_construct_t,
+                                    std::tuple<KeyArgs...> key_args,
+                                    std::tuple<Args...> args) {
+    Key key = std::make_from_tuple<Key>(std::move(key_args));
+    return tree_.try_emplace(key, std::piecewise_construct,
+                             std::forward_as_tuple(std::move(key)),
+                             std::move(args));
+  }
+
+  // Ищет ключ и только при его отсутствии создает значение из аргументов,
+  // иначе аргументы не используются
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args) {
+    return tree_.try_emplace(
+        key, std::piecewise_construct, std::forward_as_tuple(key),
+        std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+
+  // То же для ключа, который можно переместить в узел
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(Key&& key, Args&&... args) {
+    return tree_.try_emplace(
+        key, std::piecewise_construct, std::forward_as_tuple(std::move(key)),
+        std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+
+  // Вставляет извлеченный узел без выделения памяти и копирования
+  insert_return_type insert(node_type&& nh) {
+    return tree_.insert(std::move(nh));
+  }
+
+  // Извлекает узел в позиции pos, не освобождая его
+  node_type extract(const_iterator pos) noexcept { return tree_.extract(pos); }
+
+  // Извлекает узел с ключом, если он есть
+  node_type extract(const Key& key) noexcept { return tree_.extract_key(key); }
+
   // Удаляет элемент в позиции pos
   void erase(iterator pos) {
     auto it = map_find((*pos).first);
     if (it != end()) tree_.erase(pos);
   }
 
+  // Удаляет элементы в диапазоне [first, last)
+  iterator erase(const_iterator first, const_iterator last) {
+    return tree_.erase(first, last);
+  }
+
   // Меняет содержимое местами
-  void swap(map& other) { tree_.swap(other.tree_); }
+  void swap(map& other) noexcept { tree_.swap(other.tree_); }
 
   // Объединяет узлы из другого контейнера
   void merge(map& other) { tree_.merge(other.tree_); }
@@ -165,6 +233,19 @@ class map {
     return it == end() ? 0 : 1;
   }
 
+  // Заменяет содержимое count элементами от next() в строго возрастающем
+  // порядке и строит дерево за O(n). Нарушение порядка - std::invalid_argument
+  template <typename Next>
+  void assign_sorted(size_type count, Next next) {
+    tree_.assign_sorted(count, next, true);
+  }
+
+  // Делит контейнер на примерно равные диапазоны по поддеревьям,
+  // возвращает их границы от begin() до end()
+  std::vector<const_iterator> split(size_type parts) const {
+    return tree_.split(parts);
+  }
+
   // Вставляет новые элементы в контейнер
   template <typename... Args>
   std::vector<std::pair<iterator, bool>> insert_many(Args&&... args) {
@@ -173,30 +254,24 @@ class map {
 
  private:
   // Находит элемент с заданным ключом
-  iterator map_find(const Key& key) noexcept {
-    iterator it = tree_.begin();
-    if (it == tree_.end() || it == nullptr) return end();
-    while (it != tree_.end()) {
-      if ((*it).first == key) return it;
-      it++;
-    }
-    return end();
-  }
+  iterator map_find(const Key& key) noexcept { return tree_.find_key(key); }
 
   // Находит элемент с заданным ключом для константного словаря
   const_iterator map_find(const Key& key) const noexcept {
-    const_iterator it = tree_.begin();
-    if (it == tree_.end()) return end();
-    while (it != tree_.end()) {
-      if ((*it).first == key) return it;
-      it++;
-    }
-    return end();
+    return tree_.find_key(key);
   }
 
+  template <typename K, typename V, typename Pred>
+  friend std::size_t erase_if(map<K, V>& container, Pred pred);
+
   // Переменная красно-черного дерева
   tree tree_;
 };
+
+template <typename Key, typename T, typename Pred>
+std::size_t erase_if(map<Key, T>& container, Pred pred) {
+  return container.tree_.erase_if(pred);
+}
 }  // namespace s21
 
 #endif  // SRC_S21_MAP_H_
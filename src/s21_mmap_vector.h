@@ -0,0 +1,363 @@
+#ifndef S21_MMAP_VECTOR_H_
+#define S21_MMAP_VECTOR_H_
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+/*
+    Реализация вектора в отображенном файле
+    mmap_vector хранит элементы прямо в файле, отображенном в память
+   (MAP_SHARED), поэтому данные переживают перезапуск, открываются без
+   чтения и разбора, а несколько процессов видят одни и те же страницы из
+   кеша. В начале файла лежит заголовок с сигнатурой, размером элемента и
+   числом элементов, за ним - сами элементы. Хранить можно только тривиально
+   копируемые типы без указателей на память процесса.
+*/
+
+namespace s21 {
+
+// Режим открытия файла
+enum class mmap_mode {
+  create,      // создать новый файл, существующий очищается
+  read_write,  // открыть существующий или создать, если его нет
+  read_only    // только чтение, например для процессов-аналитиков
+};
+
+template <typename T>
+class mmap_vector {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "mmap_vector stores only trivially copyable types");
+
+ public:
+  using value_type = T;
+  using reference = T &;
+  using const_reference = const T &;
+  using iterator = T *;
+  using const_iterator = const T *;
+  using size_type = std::size_t;
+
+  // Открывает или создает файл path. Ошибки открытия и отображения
+  // сообщаются std::system_error, чужой или поврежденный файл -
+  // std::runtime_error
+  explicit mmap_vector(const std::string &path,
+                       mmap_mode mode = mmap_mode::read_write)
+      : fd_(-1),
+        base_(nullptr),
+        mapped_bytes_(0),
+        capacity_(0),
+        writable_(mode != mmap_mode::read_only) {
+    int flags = writable_ ? O_RDWR | O_CREAT : O_RDONLY;
+    if (mode == mmap_mode::create) flags |= O_TRUNC;
+    fd_ = ::open(path.c_str(), flags | O_CLOEXEC, 0644);
+    if (fd_ < 0) throw_errno("mmap_vector: cannot open " + path);
+    try {
+      open_mapping();
+    } catch (...) {
+      close();
+      throw;
+    }
+  }
+
+  mmap_vector(const mmap_vector &) = delete;
+  mmap_vector &operator=(const mmap_vector &) = delete;
+
+  // Конструктор перемещения, other остается закрытым
+  mmap_vector(mmap_vector &&other) noexcept
+      : fd_(other.fd_),
+        base_(other.base_),
+        mapped_bytes_(other.mapped_bytes_),
+        capacity_(other.capacity_),
+        writable_(other.writable_) {
+    other.fd_ = -1;
+    other.base_ = nullptr;
+    other.mapped_bytes_ = other.capacity_ = 0;
+  }
+
+  mmap_vector &operator=(mmap_vector &&other) noexcept {
+    if (this != &other) {
+      close();
+      std::swap(fd_, other.fd_);
+      std::swap(base_, other.base_);
+      std::swap(mapped_bytes_, other.mapped_bytes_);
+      std::swap(capacity_, other.capacity_);
+      std::swap(writable_, other.writable_);
+    }
+    return *this;
+  }
+
+  // Деструктор обрезает файл по последнему элементу и закрывает его
+  ~mmap_vector() { close(); }
+
+  // Element access
+
+  // Доступ к элементу по индексу с проверкой выхода за пределы
+  reference at(size_type pos) {
+    if (pos >= size()) throw std::out_of_range("Index is out of range");
+    return data()[pos];
+  }
+
+  const_reference at(size_type pos) const {
+    if (pos >= size()) throw std::out_of_range("Index is out of range");
+    return data()[pos];
+  }
+
+  // Доступ к элементу по индексу. При открытии только на чтение запись
+  // через ссылку приводит к ошибке защиты памяти
+  reference operator[](size_type pos) noexcept { return data()[pos]; }
+  const_reference operator[](size_type pos) const noexcept {
+    return data()[pos];
+  }
+
+  // Доступ к первому элементу
+  const_reference front() const {
+    if (empty()) throw std::logic_error("The vector is empty");
+    return data()[0];
+  }
+
+  // Доступ к последнему элементу
+  const_reference back() const {
+    if (empty()) throw std::logic_error("The vector is empty");
+    return data()[size() - 1];
+  }
+
+  // Прямой доступ к элементам в отображении
+  iterator data() noexcept {
+    return base_ ? reinterpret_cast<T *>(base_ + kHeaderBytes) : nullptr;
+  }
+  const_iterator data() const noexcept {
+    return base_ ? reinterpret_cast<const T *>(base_ + kHeaderBytes)
+                 : nullptr;
+  }
+
+  // Iterators
+
+  iterator begin() noexcept { return data(); }
+  iterator end() noexcept { return data() + size(); }
+  const_iterator begin() const noexcept { return data(); }
+  const_iterator end() const noexcept { return data() + size(); }
+
+  // Capacity
+
+  bool empty() const noexcept { return size() == 0; }
+
+  // Число элементов из заголовка файла. Читатель не видит элементов за
+  // пределами своего отображения, пока не вызовет refresh. Элементы до
+  // прочитанного размера уже записаны: писатель публикует размер после
+  // них
+  size_type size() const noexcept {
+    if (base_ == nullptr) return 0;
+    size_type size = size_type(header()->size.load(std::memory_order_acquire));
+    return size < capacity_ ? size : capacity_;
+  }
+
+  // Сколько элементов помещается в файл без его расширения
+  size_type capacity() const noexcept { return capacity_; }
+
+  // Открыт ли файл на запись
+  bool writable() const noexcept { return writable_; }
+
+  // Расширяет файл под size элементов
+  void reserve(size_type size) {
+    check_writable();
+    if (size > capacity_) grow(size);
+  }
+
+  // Обрезает файл по последнему элементу
+  void shrink_to_fit() {
+    check_writable();
+    if (capacity_ > size()) resize_file(size());
+  }
+
+  // Modifiers
+
+  // Добавляет элемент в конец, при нехватке места файл растет вдвое
+  void push_back(const_reference value) {
+    check_writable();
+    size_type size = this->size();
+    if (size == capacity_) {
+      grow(size * 2 > kMinCapacity ? size * 2 : kMinCapacity);
+    }
+    data()[size] = value;
+    header()->size.store(size + 1, std::memory_order_release);
+  }
+
+  // Удаляет последний элемент
+  void pop_back() {
+    check_writable();
+    if (empty()) throw std::logic_error("Vector is empty!");
+    header()->size.store(size() - 1, std::memory_order_release);
+  }
+
+  // Удаляет все элементы, место в файле остается
+  void clear() {
+    check_writable();
+    header()->size.store(0, std::memory_order_release);
+  }
+
+  // Синхронно записывает измененные страницы в файл (msync)
+  void flush() {
+    if (base_ != nullptr && writable_ &&
+        msync(base_, mapped_bytes_, MS_SYNC) != 0) {
+      throw_errno("mmap_vector: msync failed");
+    }
+  }
+
+  // Отображает часть файла, дописанную другим процессом после открытия.
+  // Возвращает новый размер
+  size_type refresh() {
+    struct stat st;
+    if (fstat(fd_, &st) != 0) throw_errno("mmap_vector: fstat failed");
+    size_type file_bytes = size_type(st.st_size);
+    if (file_bytes > mapped_bytes_) {
+      remap(file_bytes);
+      capacity_ = (file_bytes - kHeaderBytes) / sizeof(T);
+    }
+    return size();
+  }
+
+ private:
+  // Заголовок файла, выравнивает элементы на 64 байта
+  struct file_header {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t element_size;
+    // Единственный писатель публикует размер с release, читатели в других
+    // процессах читают его с acquire
+    std::atomic<std::uint64_t> size;
+    char reserved[40];
+  };
+
+  static constexpr char kMagic[8] = {'S', '2', '1', 'M', 'V', 'E', 'C', '\0'};
+  static constexpr std::uint32_t kVersion = 1;
+  static constexpr size_type kHeaderBytes = sizeof(file_header);
+  static constexpr size_type kMinCapacity =
+      (size_type(64) << 10) / sizeof(T) ? (size_type(64) << 10) / sizeof(T)
+                                        : 1;
+  static_assert(kHeaderBytes == 64, "unexpected file header layout");
+  static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+                "file header size must be lock-free to be shared");
+  static_assert(alignof(T) <= kHeaderBytes, "element alignment is too big");
+
+  int fd_;
+  char *base_;
+  size_type mapped_bytes_;
+  size_type capacity_;
+  bool writable_;
+
+  file_header *header() noexcept {
+    return reinterpret_cast<file_header *>(base_);
+  }
+  const file_header *header() const noexcept {
+    return reinterpret_cast<const file_header *>(base_);
+  }
+
+  [[noreturn]] static void throw_errno(const std::string &what) {
+    throw std::system_error(errno, std::generic_category(), what);
+  }
+
+  void check_writable() const {
+    if (!writable_) throw std::logic_error("mmap_vector is read-only");
+  }
+
+  // Отображает файл и проверяет заголовок. Пустой файл получает новый
+  // заголовок
+  void open_mapping() {
+    struct stat st;
+    if (fstat(fd_, &st) != 0) throw_errno("mmap_vector: fstat failed");
+    size_type file_bytes = size_type(st.st_size);
+    if (file_bytes == 0) {
+      if (!writable_) throw std::runtime_error("mmap_vector: empty file");
+      if (ftruncate(fd_, kHeaderBytes) != 0)
+        throw_errno("mmap_vector: ftruncate failed");
+      remap(kHeaderBytes);
+      file_header *head = header();
+      std::memcpy(head->magic, kMagic, sizeof(kMagic));
+      head->version = kVersion;
+      head->element_size = sizeof(T);
+      head->size.store(0, std::memory_order_release);
+      return;
+    }
+    if (file_bytes < kHeaderBytes)
+      throw std::runtime_error("mmap_vector: file is too short");
+    remap(file_bytes);
+    const file_header *head = header();
+    if (std::memcmp(head->magic, kMagic, sizeof(kMagic)) != 0 ||
+        head->version != kVersion)
+      throw std::runtime_error("mmap_vector: not an mmap_vector file");
+    if (head->element_size != sizeof(T))
+      throw std::runtime_error("mmap_vector: element size mismatch");
+    capacity_ = (file_bytes - kHeaderBytes) / sizeof(T);
+    if (head->size.load(std::memory_order_acquire) > capacity_)
+      throw std::runtime_error("mmap_vector: file is truncated");
+  }
+
+  // Отображает первые bytes байт файла, на Linux расширяет отображение на
+  // месте через mremap
+  void remap(size_type bytes) {
+    int prot = writable_ ? PROT_READ | PROT_WRITE : PROT_READ;
+    void *pages = MAP_FAILED;
+#if defined(__linux__)
+    if (base_ != nullptr)
+      pages = mremap(base_, mapped_bytes_, bytes, MREMAP_MAYMOVE);
+#endif
+    if (pages == MAP_FAILED) {
+      pages = mmap(nullptr, bytes, prot, MAP_SHARED, fd_, 0);
+      if (pages == MAP_FAILED) throw_errno("mmap_vector: mmap failed");
+      if (base_ != nullptr) munmap(base_, mapped_bytes_);
+    }
+    base_ = static_cast<char *>(pages);
+    mapped_bytes_ = bytes;
+  }
+
+  // Меняет длину файла под capacity элементов и отображает его заново
+  void resize_file(size_type capacity) {
+    size_type bytes = kHeaderBytes + capacity * sizeof(T);
+    if (ftruncate(fd_, off_t(bytes)) != 0)
+      throw_errno("mmap_vector: ftruncate failed");
+    remap(bytes);
+    capacity_ = capacity;
+  }
+
+  void grow(size_type capacity) {
+    if (capacity > (size_type(-1) - kHeaderBytes) / sizeof(T))
+      throw std::length_error("Overflow! Enter a smaller size!");
+    resize_file(capacity);
+  }
+
+  // Обрезает файл по последнему элементу и освобождает ресурсы
+  void close() noexcept {
+    if (base_ != nullptr) {
+      size_type used = kHeaderBytes + size() * sizeof(T);
+      munmap(base_, mapped_bytes_);
+      if (writable_ && used < mapped_bytes_) {
+        int unused = ftruncate(fd_, off_t(used));
+        (void)unused;
+      }
+      base_ = nullptr;
+    }
+    if (fd_ >= 0) ::close(fd_);
+    fd_ = -1;
+    mapped_bytes_ = capacity_ = 0;
+  }
+};
+
+}  // namespace s21
+
+#endif  // defined(__unix__) || defined(__APPLE__)
+
+#endif
@@ -14,6 +14,13 @@
 */
 
 namespace s21 {
+template <typename Key>
+class multiset;
+
+// Удаляет из мультимножества все элементы, удовлетворяющие предикату
+template <typename Key, typename Pred>
+std::size_t erase_if(multiset<Key>& container, Pred pred);
+
 template <typename Key>
 class multiset {
   using key_type = Key;
@@ -26,9 +33,10 @@ class multiset {
  public:
   using iterator = typename tree::iterator;
   using const_iterator = typename tree::const_iterator;
+  using node_type = typename tree::node_type;
 
   // Конструктор по умолчанию, создает пустое множество
-  multiset() : tree_() {}
+  multiset() noexcept : tree_() {}
 
   // Конструктор списка инициализации, создает множество, инициализированное с
   // помощью std::initializer_list
@@ -42,7 +50,7 @@ class multiset {
   multiset(const multiset& s) : tree_(s.tree_) {}
 
   // Конструктор перемещения
-  multiset(multiset&& s) : tree_(std::move(s.tree_)) {}
+  multiset(multiset&& s) noexcept : tree_(std::move(s.tree_)) {}
 
   // Деструктор
   ~multiset() = default;
@@ -54,7 +62,7 @@ class multiset {
   }
 
   // Перегрузка оператора присваивания для перемещения объекта
-  multiset& operator=(multiset&& other) {
+  multiset& operator=(multiset&& other) noexcept {
     tree_ = std::move(other.tree_);
     return *this;
   }
@@ -63,9 +71,41 @@ class multiset {
   // контейнере
   iterator insert(const_reference key) { return tree_.insert_duplicate(key); }
 
+  // Создает элемент из аргументов прямо в узле дерева и вставляет его
+  template <typename... Args>
+  iterator emplace(Args&&... args) {
+    return tree_.emplace_duplicate(std::forward<Args>(args)...);
+  }
+
+  // То же, что emplace, но вставка начинается с позиции перед hint
+  template <typename... Args>
+  iterator emplace_hint(const_iterator hint, Args&&... args) {
+    return tree_.emplace_hint_duplicate(hint, std::forward<Args>(args)...);
+  }
+
+  // Вставляет извлеченный узел без выделения памяти и копирования
+  iterator insert(node_type&& nh) {
+    return tree_.insert_duplicate(std::move(nh));
+  }
+
   // Удаляет элемент в позиции pos
   void erase(iterator pos) { tree_.erase(pos); }
 
+  // Удаляет элементы в диапазоне [first, last)
+  iterator erase(const_iterator first, const_iterator last) {
+    return tree_.erase(first, last);
+  }
+
+  // Извлекает узел в позиции pos, не освобождая его
+  node_type extract(const_iterator pos) noexcept { return tree_.extract(pos); }
+
+  // Извлекает первый узел с ключом, если он есть
+  node_type extract(const key_type& key) noexcept {
+    iterator it = tree_.lower_bound(key);
+    if (it == end() || std::less<key_type>{}(key, *it)) return node_type();
+    return tree_.extract(it);
+  }
+
   // Проверяет, пуст ли контейнер
   bool empty() const noexcept { return tree_.empty(); }
 
@@ -79,7 +119,7 @@ class multiset {
   void clear() { tree_.clear(); }
 
   // Меняет содержимое местами
-  void swap(multiset& other) { tree_.swap(other.tree_); }
+  void swap(multiset& other) noexcept { tree_.swap(other.tree_); }
 
   // Объединяет узлы из другого контейнера
   void merge(multiset& other) { tree_.merge_duplicates(other.tree_); }
@@ -147,6 +187,19 @@ class multiset {
     return tree_.upper_bound(key);
   }
 
+  // Заменяет содержимое count элементами от next() в неубывающем порядке
+  // и строит дерево за O(n). Нарушение порядка - std::invalid_argument
+  template <typename Next>
+  void assign_sorted(size_type count, Next next) {
+    tree_.assign_sorted(count, next, false);
+  }
+
+  // Делит контейнер на примерно равные диапазоны по поддеревьям,
+  // возвращает их границы от begin() до end()
+  std::vector<const_iterator> split(size_type parts) const {
+    return tree_.split(parts);
+  }
+
   // Вставляет новые элементы в контейнер
   template <typename... Args>
   std::vector<std::pair<iterator, bool>> insert_many(Args&&... args) {
@@ -154,9 +207,17 @@ class multiset {
   }
 
  private:
+  template <typename K, typename Pred>
+  friend std::size_t erase_if(multiset<K>& container, Pred pred);
+
   // Переменная красно-черного дерева
   tree tree_;
 };
+
+template <typename Key, typename Pred>
+std::size_t erase_if(multiset<Key>& container, Pred pred) {
+  return container.tree_.erase_if(pred);
+}
 }  // namespace s21
 
 #endif  // SRC_S21_MULTISET_H
@@ -0,0 +1,354 @@
+#ifndef S21_PARALLEL_H_
+#define S21_PARALLEL_H_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "s21_sort.h"
+
+/*
+    Параллельные алгоритмы
+    Пул потоков создается один раз и переиспользуется между вызовами.
+   Алгоритмы делят диапазон на части и выполняют их в пуле, вызывающий поток
+   тоже берет части. Диапазоны s21::vector и s21::array делятся по индексам,
+   set, multiset и map - по поддеревьям (метод split). Первое исключение из
+   пользовательской функции пробрасывается в вызывающий поток.
+*/
+
+namespace s21 {
+namespace parallel {
+
+class thread_pool {
+ public:
+  using size_type = std::size_t;
+
+  // Создает пул, в котором вместе с вызывающим потоком работают threads
+  // потоков. По умолчанию по числу аппаратных потоков
+  explicit thread_pool(size_type threads = default_threads()) {
+    for (size_type i = 1; i < threads; ++i)
+      workers_.emplace_back([this] { worker_loop(); });
+  }
+
+  thread_pool(const thread_pool &) = delete;
+  thread_pool &operator=(const thread_pool &) = delete;
+
+  // Деструктор дожидается завершения рабочих потоков
+  ~thread_pool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    wake_.notify_all();
+    for (std::thread &worker : workers_) worker.join();
+  }
+
+  // Возвращает число потоков вместе с вызывающим
+  size_type size() const noexcept { return workers_.size() + 1; }
+
+  // Выполняет task(i) для каждого i из [0, count) и ждет завершения всех
+  // задач. Вызов из задачи пула выполняется в текущем потоке, чтобы
+  // вложенные алгоритмы не блокировали пул
+  template <typename Task>
+  void run(size_type count, Task &&task) {
+    if (count == 0) return;
+    if (count == 1 || workers_.empty() || inside_pool_) {
+      for (size_type i = 0; i < count; ++i) task(i);
+      return;
+    }
+    std::lock_guard<std::mutex> run_lock(run_mutex_);
+    batch job(count, &task, [](void *context, size_type i) {
+      (*static_cast<std::remove_reference_t<Task> *>(context))(i);
+    });
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      batch_ = &job;
+      ++generation_;
+    }
+    wake_.notify_all();
+    inside_pool_ = true;
+    job.work();
+    inside_pool_ = false;
+    {
+      // после сброса batch_ новые потоки к задаче не присоединятся
+      std::unique_lock<std::mutex> lock(mutex_);
+      batch_ = nullptr;
+      done_.wait(lock, [this] { return busy_ == 0; });
+    }
+    if (job.error) std::rethrow_exception(job.error);
+  }
+
+  // Общий пул по умолчанию
+  static thread_pool &default_pool() {
+    static thread_pool pool;
+    return pool;
+  }
+
+  static size_type default_threads() noexcept {
+    size_type threads = std::thread::hardware_concurrency();
+    return threads ? threads : 1;
+  }
+
+ private:
+  // Задача пула: счетчик следующего индекса общий для всех потоков
+  struct batch {
+    using invoke_type = void (*)(void *, size_type);
+
+    batch(size_type count, void *context, invoke_type invoke)
+        : count(count), context(context), invoke(invoke) {}
+
+    void work() noexcept {
+      for (size_type i = next++; i < count; i = next++) {
+        if (failed.load(std::memory_order_relaxed)) continue;
+        try {
+          invoke(context, i);
+        } catch (...) {
+          std::lock_guard<std::mutex> lock(error_mutex);
+          if (!error) error = std::current_exception();
+          failed = true;
+        }
+      }
+    }
+
+    size_type count;
+    void *context;
+    invoke_type invoke;
+    std::atomic<size_type> next{0};
+    std::atomic<bool> failed{false};
+    std::mutex error_mutex;
+    std::exception_ptr error;
+  };
+
+  void worker_loop() {
+    inside_pool_ = true;
+    size_type seen = 0;
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+      wake_.wait(lock, [&] { return stop_ || generation_ != seen; });
+      if (stop_) return;
+      seen = generation_;
+      batch *job = batch_;
+      if (job == nullptr) continue;
+      ++busy_;
+      lock.unlock();
+      job->work();
+      lock.lock();
+      if (--busy_ == 0) done_.notify_all();
+    }
+  }
+
+  std::vector<std::thread> workers_;
+  std::mutex run_mutex_;
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  std::condition_variable done_;
+  batch *batch_ = nullptr;
+  size_type generation_ = 0;
+  size_type busy_ = 0;
+  bool stop_ = false;
+  static inline thread_local bool inside_pool_ = false;
+};
+
+// Настройки разбиения на части
+struct options {
+  // Пул, в котором выполняется алгоритм, nullptr - общий пул
+  thread_pool *pool = nullptr;
+  // Минимальное число элементов в одной части
+  std::size_t grain = 1 << 14;
+  // Сколько частей приходится на поток, чтобы выровнять нагрузку
+  std::size_t chunks_per_thread = 4;
+};
+
+namespace detail {
+
+inline thread_pool &pool_of(const options &opt) {
+  return opt.pool ? *opt.pool : thread_pool::default_pool();
+}
+
+// Число частей для диапазона из n элементов
+inline std::size_t chunk_count(std::size_t n, const options &opt) {
+  std::size_t grain = opt.grain ? opt.grain : 1;
+  std::size_t by_grain = (n + grain - 1) / grain;
+  std::size_t by_threads =
+      pool_of(opt).size() * std::max<std::size_t>(opt.chunks_per_thread, 1);
+  return std::min(by_grain, by_threads);
+}
+
+// Выполняет body(begin, end) для каждой части индексов [0, n)
+template <typename Body>
+void for_chunks(std::size_t n, const options &opt, Body body) {
+  std::size_t chunks = chunk_count(n, opt);
+  pool_of(opt).run(chunks, [&](std::size_t i) {
+    body(n * i / chunks, n * (i + 1) / chunks);
+  });
+}
+
+template <typename Container>
+using tree_bounds_t =
+    decltype(std::declval<const Container &>().split(std::size_t()));
+
+}  // namespace detail
+
+// -------- Диапазоны с произвольным доступом (vector, array) --------
+
+// Вызывает f для каждого элемента
+template <typename It, typename F>
+void for_each(It first, It last, F f, const options &opt = options()) {
+  detail::for_chunks(last - first, opt, [&](std::size_t b, std::size_t e) {
+    for (It it = first + b, end = first + e; it != end; ++it) f(*it);
+  });
+}
+
+// Записывает op(x) для каждого элемента x в диапазон от d_first,
+// возвращает конец записанного диапазона
+template <typename It, typename OutIt, typename Op>
+OutIt transform(It first, It last, OutIt d_first, Op op,
+                const options &opt = options()) {
+  detail::for_chunks(last - first, opt, [&](std::size_t b, std::size_t e) {
+    OutIt out = d_first + b;
+    for (It it = first + b, end = first + e; it != end; ++it, ++out)
+      *out = op(*it);
+  });
+  return d_first + (last - first);
+}
+
+// Сворачивает диапазон операцией op. Части сворачиваются параллельно,
+// затем частичные результаты - по порядку, поэтому op достаточно быть
+// ассоциативной
+template <typename It, typename T, typename Op>
+T reduce(It first, It last, T init, Op op, const options &opt = options()) {
+  std::size_t n = last - first;
+  std::size_t chunks = detail::chunk_count(n, opt);
+  std::vector<T> partial(chunks, init);
+  detail::pool_of(opt).run(chunks, [&](std::size_t i) {
+    It it = first + n * i / chunks, end = first + n * (i + 1) / chunks;
+    T acc = *it;
+    for (++it; it != end; ++it) acc = op(std::move(acc), *it);
+    partial[i] = std::move(acc);
+  });
+  for (T &value : partial) init = op(std::move(init), std::move(value));
+  return init;
+}
+
+// Сумма элементов
+template <typename It, typename T>
+T reduce(It first, It last, T init, const options &opt = options()) {
+  return s21::parallel::reduce(first, last, std::move(init),
+                               [](T a, const T &b) { return a + b; }, opt);
+}
+
+// Сортирует диапазон: части сортируются s21::sort параллельно, затем соседние
+// отсортированные части сливаются попарно, каждый уровень слияния тоже
+// параллельно
+template <typename It, typename Compare>
+void sort(It first, It last, Compare comp, const options &opt = options()) {
+  std::size_t n = last - first;
+  std::size_t chunks = detail::chunk_count(n, opt);
+  if (chunks < 2) {
+    s21::sort(first, last, comp);
+    return;
+  }
+  thread_pool &pool = detail::pool_of(opt);
+  auto bound = [&](std::size_t i) { return first + n * i / chunks; };
+  pool.run(chunks,
+           [&](std::size_t i) { s21::sort(bound(i), bound(i + 1), comp); });
+  for (std::size_t width = 1; width < chunks; width *= 2) {
+    std::size_t pairs = (chunks + 2 * width - 1) / (2 * width);
+    pool.run(pairs, [&](std::size_t i) {
+      std::size_t left = 2 * width * i;
+      std::size_t middle = std::min(left + width, chunks);
+      std::size_t right = std::min(left + 2 * width, chunks);
+      if (middle < right)
+        std::inplace_merge(bound(left), bound(middle), bound(right), comp);
+    });
+  }
+}
+
+template <typename It>
+void sort(It first, It last, const options &opt = options()) {
+  s21::parallel::sort(first, last, std::less<>(), opt);
+}
+
+// Записывает префиксные свертки в диапазон от d_first. Первый проход
+// считает итог каждой части, второй - части со сдвигом на сумму
+// предыдущих. Возвращает конец записанного диапазона
+template <typename It, typename OutIt, typename Op>
+OutIt inclusive_scan(It first, It last, OutIt d_first, Op op,
+                     const options &opt = options()) {
+  using value_type = typename std::iterator_traits<It>::value_type;
+  std::size_t n = last - first;
+  std::size_t chunks = detail::chunk_count(n, opt);
+  if (chunks == 0) return d_first;
+  thread_pool &pool = detail::pool_of(opt);
+  auto bound = [&](std::size_t i) { return n * i / chunks; };
+  std::vector<value_type> totals(chunks);
+  pool.run(chunks - 1, [&](std::size_t i) {
+    It it = first + bound(i), end = first + bound(i + 1);
+    value_type acc = *it;
+    for (++it; it != end; ++it) acc = op(std::move(acc), *it);
+    totals[i] = std::move(acc);
+  });
+  for (std::size_t i = 1; i + 1 < chunks; ++i)
+    totals[i] = op(totals[i - 1], totals[i]);
+  pool.run(chunks, [&](std::size_t i) {
+    It it = first + bound(i), end = first + bound(i + 1);
+    OutIt out = d_first + bound(i);
+    value_type acc = i ? op(totals[i - 1], *it) : value_type(*it);
+    *out = acc;
+    for (++it, ++out; it != end; ++it, ++out) *out = acc = op(acc, *it);
+  });
+  return d_first + n;
+}
+
+template <typename It, typename OutIt>
+OutIt inclusive_scan(It first, It last, OutIt d_first,
+                     const options &opt = options()) {
+  return s21::parallel::inclusive_scan(first, last, d_first, std::plus<>(),
+                                       opt);
+}
+
+// -------- Деревья (set, multiset, map) --------
+// Контейнер делится методом split на поддеревья, каждое обходится
+// последовательно своим потоком. Размер части задает grain приблизительно
+
+// Вызывает f для каждого элемента контейнера
+template <typename Container, typename F,
+          typename = detail::tree_bounds_t<Container>>
+void for_each(const Container &c, F f, const options &opt = options()) {
+  auto bounds = c.split(detail::chunk_count(c.size(), opt));
+  detail::pool_of(opt).run(bounds.size() - 1, [&](std::size_t i) {
+    for (auto it = bounds[i]; it != bounds[i + 1]; ++it) f(*it);
+  });
+}
+
+// Сворачивает элементы контейнера: каждое поддерево сворачивается
+// операцией op(T, элемент), начиная с нейтрального identity, затем
+// частичные результаты объединяются по порядку обхода через combine(T, T)
+template <typename Container, typename T, typename Op, typename Combine,
+          typename = detail::tree_bounds_t<Container>>
+T reduce(const Container &c, T identity, Op op, Combine combine,
+         const options &opt = options()) {
+  auto bounds = c.split(detail::chunk_count(c.size(), opt));
+  std::vector<T> partial(bounds.size() - 1, identity);
+  detail::pool_of(opt).run(partial.size(), [&](std::size_t i) {
+    for (auto it = bounds[i]; it != bounds[i + 1]; ++it)
+      partial[i] = op(std::move(partial[i]), *it);
+  });
+  for (T &value : partial)
+    identity = combine(std::move(identity), std::move(value));
+  return identity;
+}
+
+}  // namespace parallel
+}  // namespace s21
+
+#endif
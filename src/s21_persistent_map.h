@@ -0,0 +1,506 @@
+#ifndef S21_PERSISTENT_MAP_H_
+#define S21_PERSISTENT_MAP_H_
+
+#include <atomic>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/*
+    Реализация персистентных множества и словаря
+    persistent_set и persistent_map - версии set и map, у которых снимок
+   делается за O(1): копия контейнера просто разделяет с оригиналом корень
+   дерева. Узлы считают ссылки на себя, и изменение копирует только путь от
+   корня до изменяемого узла, а остальное дерево остается общим со всеми
+   снимками. Узел, на который ссылается только эта версия, меняется на
+   месте, поэтому без снимков обновления почти не выделяют память. Старая
+   версия освобождается вместе с последним ее владельцем. Счетчики ссылок
+   атомарные: снимок можно читать в другом потоке, пока писатель меняет
+   свою версию. Одну и ту же версию из нескольких потоков менять нельзя.
+   Внутри - левостороннее красно-черное дерево: у него вся балансировка
+   рекурсивна сверху вниз и естественно ложится на копирование пути.
+*/
+
+namespace s21 {
+namespace detail {
+
+// Владеющая ссылка на узел со встроенным счетчиком
+template <typename Node>
+class persistent_ref {
+ public:
+  persistent_ref() noexcept : node_(nullptr) {}
+  // Забирает первую ссылку только что созданного узла
+  explicit persistent_ref(Node *node) noexcept : node_(node) {}
+  persistent_ref(const persistent_ref &other) noexcept : node_(other.node_) {
+    if (node_ != nullptr) node_->refs.fetch_add(1, std::memory_order_relaxed);
+  }
+  persistent_ref(persistent_ref &&other) noexcept : node_(other.node_) {
+    other.node_ = nullptr;
+  }
+  ~persistent_ref() { release(); }
+
+  persistent_ref &operator=(persistent_ref other) noexcept {
+    std::swap(node_, other.node_);
+    return *this;
+  }
+
+  Node *get() const noexcept { return node_; }
+  Node *operator->() const noexcept { return node_; }
+  explicit operator bool() const noexcept { return node_ != nullptr; }
+
+  void reset() noexcept {
+    release();
+    node_ = nullptr;
+  }
+
+  // Единственная ли это ссылка: тогда узел можно менять на месте
+  bool unique() const noexcept {
+    return node_->refs.load(std::memory_order_acquire) == 1;
+  }
+
+ private:
+  Node *node_;
+
+  void release() noexcept {
+    if (node_ != nullptr &&
+        node_->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      delete node_;
+    }
+  }
+};
+
+template <typename Value>
+struct persistent_node {
+  using ref = persistent_ref<persistent_node>;
+
+  explicit persistent_node(const Value &item)
+      : refs(1), red(true), value(item) {}
+  // Копия узла для изменения пути: дети становятся общими
+  persistent_node(const persistent_node &other)
+      : refs(1),
+        left(other.left),
+        right(other.right),
+        red(other.red),
+        value(other.value) {}
+  // Копия с новым значением
+  persistent_node(const persistent_node &other, const Value &item)
+      : refs(1),
+        left(other.left),
+        right(other.right),
+        red(other.red),
+        value(item) {}
+
+  std::atomic<std::size_t> refs;
+  ref left;
+  ref right;
+  bool red;
+  Value value;
+};
+
+template <typename Key>
+struct persistent_set_traits {
+  using value_type = Key;
+  static const Key &key(const value_type &value) noexcept { return value; }
+};
+
+template <typename Key, typename T>
+struct persistent_map_traits {
+  using value_type = std::pair<const Key, T>;
+  static const Key &key(const value_type &value) noexcept {
+    return value.first;
+  }
+};
+
+// Персистентное левостороннее красно-черное дерево. Каждая функция,
+// меняющая узел, сначала делает его собственным (own): общий узел
+// копируется, а ссылка в родителе, который уже собственный, заменяется
+template <typename Key, typename Traits>
+class persistent_tree {
+ public:
+  using value_type = typename Traits::value_type;
+  using node = persistent_node<value_type>;
+  using ref = typename node::ref;
+  using size_type = std::size_t;
+
+  persistent_tree() noexcept : size_(0) {}
+
+  static const Key &key_of(const value_type &value) noexcept {
+    return Traits::key(value);
+  }
+
+  size_type size() const noexcept { return size_; }
+  const node *root() const noexcept { return root_.get(); }
+
+  const node *find(const Key &key) const noexcept {
+    const node *current = root_.get();
+    while (current != nullptr) {
+      const Key &here = Traits::key(current->value);
+      if (key < here) {
+        current = current->left.get();
+      } else if (here < key) {
+        current = current->right.get();
+      } else {
+        return current;
+      }
+    }
+    return nullptr;
+  }
+
+  // Вставляет value, если ключа нет. При replace заменяет значение
+  // найденного ключа. Возвращает true, если ключ добавлен
+  bool insert(const value_type &value, bool replace) {
+    if (!replace && find(Traits::key(value)) != nullptr) return false;
+    bool inserted = false;
+    insert(root_, value, inserted);
+    root_->red = false;
+    if (inserted) ++size_;
+    return inserted;
+  }
+
+  size_type erase(const Key &key) {
+    if (find(key) == nullptr) return 0;
+    own(root_);
+    if (!is_red(root_->left) && !is_red(root_->right)) root_->red = true;
+    erase(root_, key);
+    if (root_) root_->red = false;
+    --size_;
+    return 1;
+  }
+
+  void clear() noexcept {
+    root_.reset();
+    size_ = 0;
+  }
+
+ private:
+  ref root_;
+  size_type size_;
+
+  static bool is_red(const ref &current) noexcept {
+    return current && current->red;
+  }
+
+  // Делает узел в слоте собственным для этой версии
+  static node *own(ref &slot) {
+    if (!slot.unique()) slot = ref(new node(*slot.get()));
+    return slot.get();
+  }
+
+  static void rotate_left(ref &h) {
+    own(h);
+    own(h->right);
+    ref x = std::move(h->right);
+    h->right = std::move(x->left);
+    x->red = h->red;
+    h->red = true;
+    x->left = std::move(h);
+    h = std::move(x);
+  }
+
+  static void rotate_right(ref &h) {
+    own(h);
+    own(h->left);
+    ref x = std::move(h->left);
+    h->left = std::move(x->right);
+    x->red = h->red;
+    h->red = true;
+    x->right = std::move(h);
+    h = std::move(x);
+  }
+
+  static void flip_colors(ref &h) {
+    own(h);
+    own(h->left)->red = !h->left->red;
+    own(h->right)->red = !h->right->red;
+    h->red = !h->red;
+  }
+
+  static void balance(ref &h) {
+    if (is_red(h->right) && !is_red(h->left)) rotate_left(h);
+    if (is_red(h->left) && is_red(h->left->left)) rotate_right(h);
+    if (is_red(h->left) && is_red(h->right)) flip_colors(h);
+  }
+
+  static void move_red_left(ref &h) {
+    flip_colors(h);
+    if (is_red(h->right->left)) {
+      rotate_right(h->right);
+      rotate_left(h);
+      flip_colors(h);
+    }
+  }
+
+  static void move_red_right(ref &h) {
+    flip_colors(h);
+    if (is_red(h->left->left)) {
+      rotate_right(h);
+      flip_colors(h);
+    }
+  }
+
+  static void insert(ref &h, const value_type &value, bool &inserted) {
+    if (!h) {
+      h = ref(new node(value));
+      inserted = true;
+      return;
+    }
+    const Key &key = Traits::key(value);
+    if (key < Traits::key(h->value)) {
+      own(h);
+      insert(h->left, value, inserted);
+    } else if (Traits::key(h->value) < key) {
+      own(h);
+      insert(h->right, value, inserted);
+    } else {
+      // ключ const, поэтому узел с новым значением создается заново
+      h = ref(new node(*h.get(), value));
+      return;
+    }
+    balance(h);
+  }
+
+  // Отцепляет наименьший узел поддерева в removed
+  static void detach_min(ref &h, ref &removed) {
+    own(h);
+    if (!h->left) {
+      removed = std::move(h);
+      h.reset();
+      return;
+    }
+    if (!is_red(h->left) && !is_red(h->left->left)) move_red_left(h);
+    detach_min(h->left, removed);
+    balance(h);
+  }
+
+  // Удаляет ключ, который точно есть в поддереве. Удаленный внутренний
+  // узел заменяется своим преемником перестановкой ссылок
+  static void erase(ref &h, const Key &key) {
+    own(h);
+    if (key < Traits::key(h->value)) {
+      if (!is_red(h->left) && !is_red(h->left->left)) move_red_left(h);
+      erase(h->left, key);
+    } else {
+      if (is_red(h->left)) rotate_right(h);
+      if (!(Traits::key(h->value) < key) && !h->right) {
+        h.reset();
+        return;
+      }
+      if (!is_red(h->right) && !is_red(h->right->left)) move_red_right(h);
+      if (!(Traits::key(h->value) < key)) {
+        ref successor;
+        detach_min(h->right, successor);
+        successor->left = std::move(h->left);
+        successor->right = std::move(h->right);
+        successor->red = h->red;
+        h = std::move(successor);
+      } else {
+        erase(h->right, key);
+      }
+    }
+    balance(h);
+  }
+};
+
+// Итератор по возрастанию ключей. Действителен, пока жива версия, из
+// которой он получен
+template <typename Tree, typename Value>
+class persistent_iterator {
+  using node = typename Tree::node;
+
+ public:
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = std::remove_const_t<Value>;
+  using difference_type = std::ptrdiff_t;
+  using pointer = Value *;
+  using reference = Value &;
+
+  persistent_iterator() noexcept = default;
+
+  // Итератор на наименьший элемент поддерева root
+  explicit persistent_iterator(const node *root) { push_left(root); }
+
+  // Итератор на элемент target, путь к которому строится от root
+  persistent_iterator(const node *root, const node *target) {
+    if (target == nullptr) return;
+    const auto &key = Tree::key_of(target->value);
+    while (root != target) {
+      if (key < Tree::key_of(root->value)) {
+        path_.push_back(root);
+        root = root->left.get();
+      } else {
+        root = root->right.get();
+      }
+    }
+    path_.push_back(target);
+  }
+
+  reference operator*() const noexcept { return path_.back()->value; }
+  pointer operator->() const noexcept { return &path_.back()->value; }
+
+  persistent_iterator &operator++() {
+    const node *current = path_.back();
+    path_.pop_back();
+    push_left(current->right.get());
+    return *this;
+  }
+
+  persistent_iterator operator++(int) {
+    persistent_iterator old = *this;
+    ++*this;
+    return old;
+  }
+
+  bool operator==(const persistent_iterator &other) const noexcept {
+    return current() == other.current();
+  }
+  bool operator!=(const persistent_iterator &other) const noexcept {
+    return current() != other.current();
+  }
+
+ private:
+  // Узлы, в левое поддерево которых мы спустились, сверху вниз
+  std::vector<const node *> path_;
+
+  const node *current() const noexcept {
+    return path_.empty() ? nullptr : path_.back();
+  }
+
+  void push_left(const node *current) {
+    while (current != nullptr) {
+      path_.push_back(current);
+      current = current->left.get();
+    }
+  }
+};
+
+}  // namespace detail
+
+template <typename Key>
+class persistent_set {
+  using traits = detail::persistent_set_traits<Key>;
+  using tree = detail::persistent_tree<Key, traits>;
+
+ public:
+  using key_type = Key;
+  using value_type = Key;
+  using const_reference = const Key &;
+  using size_type = std::size_t;
+  using const_iterator = detail::persistent_iterator<tree, const Key>;
+  using iterator = const_iterator;
+
+  persistent_set() noexcept = default;
+
+  persistent_set(std::initializer_list<value_type> const &items) {
+    for (const Key &key : items) insert(key);
+  }
+
+  // Копирование и снимок - O(1): копия разделяет дерево с оригиналом
+  persistent_set(const persistent_set &) = default;
+  persistent_set(persistent_set &&) noexcept = default;
+  persistent_set &operator=(const persistent_set &) = default;
+  persistent_set &operator=(persistent_set &&) noexcept = default;
+
+  // Неизменный снимок текущей версии
+  persistent_set snapshot() const { return *this; }
+
+  const_iterator begin() const { return const_iterator(tree_.root()); }
+  const_iterator end() const noexcept { return const_iterator(); }
+
+  bool empty() const noexcept { return tree_.size() == 0; }
+  size_type size() const noexcept { return tree_.size(); }
+
+  // Добавляет ключ, копируя путь от корня. Возвращает false, если ключ уже
+  // есть
+  bool insert(const Key &key) { return tree_.insert(key, false); }
+  size_type erase(const Key &key) { return tree_.erase(key); }
+  void clear() noexcept { tree_.clear(); }
+
+  bool contains(const Key &key) const noexcept {
+    return tree_.find(key) != nullptr;
+  }
+  const_iterator find(const Key &key) const {
+    return const_iterator(tree_.root(), tree_.find(key));
+  }
+
+  void swap(persistent_set &other) noexcept { std::swap(tree_, other.tree_); }
+
+ private:
+  tree tree_;
+};
+
+template <typename Key, typename T>
+class persistent_map {
+  using traits = detail::persistent_map_traits<Key, T>;
+  using tree = detail::persistent_tree<Key, traits>;
+
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const Key, T>;
+  using const_reference = const value_type &;
+  using size_type = std::size_t;
+  using const_iterator = detail::persistent_iterator<tree, const value_type>;
+  using iterator = const_iterator;
+
+  persistent_map() noexcept = default;
+
+  persistent_map(std::initializer_list<value_type> const &items) {
+    for (const value_type &item : items) insert(item.first, item.second);
+  }
+
+  // Копирование и снимок - O(1): копия разделяет дерево с оригиналом
+  persistent_map(const persistent_map &) = default;
+  persistent_map(persistent_map &&) noexcept = default;
+  persistent_map &operator=(const persistent_map &) = default;
+  persistent_map &operator=(persistent_map &&) noexcept = default;
+
+  // Неизменный снимок текущей версии
+  persistent_map snapshot() const { return *this; }
+
+  const_iterator begin() const { return const_iterator(tree_.root()); }
+  const_iterator end() const noexcept { return const_iterator(); }
+
+  bool empty() const noexcept { return tree_.size() == 0; }
+  size_type size() const noexcept { return tree_.size(); }
+
+  // Значения читаются только по константной ссылке: узлы могут быть общими
+  // со снимками. Отсутствующий ключ - std::out_of_range
+  const T &at(const Key &key) const {
+    auto *found = tree_.find(key);
+    if (found == nullptr) throw std::out_of_range("Key is not found");
+    return found->value.second;
+  }
+
+  // Добавляет пару, если ключа нет. Возвращает false, если ключ уже есть
+  bool insert(const Key &key, const T &obj) {
+    return tree_.insert(value_type(key, obj), false);
+  }
+
+  // Добавляет пару или заменяет значение ключа
+  bool insert_or_assign(const Key &key, const T &obj) {
+    return tree_.insert(value_type(key, obj), true);
+  }
+
+  size_type erase(const Key &key) { return tree_.erase(key); }
+  void clear() noexcept { tree_.clear(); }
+
+  bool contains(const Key &key) const noexcept {
+    return tree_.find(key) != nullptr;
+  }
+  const_iterator find(const Key &key) const {
+    return const_iterator(tree_.root(), tree_.find(key));
+  }
+
+  void swap(persistent_map &other) noexcept { std::swap(tree_, other.tree_); }
+
+ private:
+  tree tree_;
+};
+
+}  // namespace s21
+
+#endif
@@ -0,0 +1,402 @@
+#ifndef S21_PERSISTENT_VECTOR_H_
+#define S21_PERSISTENT_VECTOR_H_
+
+#include <atomic>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+#include "s21_persistent_map.h"
+
+/*
+    Реализация персистентного вектора
+    persistent_vector - вектор на 32-ичном префиксном дереве с буфером
+   хвоста. Доступ по индексу спускается по дереву за log32(n) шагов, а
+   push_back дописывает в хвост и только раз в 32 элемента вешает полный
+   хвост в дерево. Как и у persistent_map, узлы считают ссылки на себя:
+   снимок - O(1), изменение копирует только общие со снимками узлы на
+   пути к элементу, а узлы, которыми владеет одна эта версия, меняются на
+   месте. Поэтому серия изменений после снимка копирует каждый узел не
+   больше одного раза и дальше работает как обычный изменяемый вектор.
+*/
+
+namespace s21 {
+namespace detail {
+
+// Узел дерева: внутренний хранит ссылки на детей, лист - элементы
+template <typename T>
+struct persistent_vector_node {
+  static constexpr std::size_t kBits = 5;
+  static constexpr std::size_t kWidth = std::size_t(1) << kBits;
+  using ref = persistent_ref<persistent_vector_node>;
+
+  explicit persistent_vector_node(bool leaf_node)
+      : refs(1), leaf(leaf_node), count(0) {
+    if (!leaf) {
+      for (ref &child : children) new (&child) ref();
+    }
+  }
+
+  // Копия узла для изменения пути: дети становятся общими
+  persistent_vector_node(const persistent_vector_node &other)
+      : refs(1), leaf(other.leaf), count(0) {
+    if (!leaf) {
+      for (std::size_t i = 0; i < kWidth; ++i) {
+        new (&children[i]) ref(other.children[i]);
+      }
+      return;
+    }
+    try {
+      for (; count < other.count; ++count) {
+        new (&items[count]) T(other.items[count]);
+      }
+    } catch (...) {
+      destroy_items();
+      throw;
+    }
+  }
+
+  ~persistent_vector_node() {
+    if (!leaf) {
+      for (ref &child : children) child.~ref();
+    } else {
+      destroy_items();
+    }
+  }
+
+  void destroy_items() noexcept {
+    while (count > 0) items[--count].~T();
+  }
+
+  std::atomic<std::size_t> refs;
+  bool leaf;
+  // Число элементов листа
+  std::size_t count;
+  union {
+    ref children[kWidth];
+    T items[kWidth];
+  };
+};
+
+}  // namespace detail
+
+template <typename T>
+class persistent_vector {
+  using node = detail::persistent_vector_node<T>;
+  using ref = typename node::ref;
+
+ public:
+  using value_type = T;
+  using reference = T &;
+  using const_reference = const T &;
+  using size_type = std::size_t;
+
+  class const_iterator;
+  using iterator = const_iterator;
+
+  persistent_vector() noexcept : size_(0), shift_(kBits) {}
+
+  persistent_vector(std::initializer_list<value_type> const &items)
+      : persistent_vector() {
+    for (const T &item : items) push_back(item);
+  }
+
+  // Копирование и снимок - O(1): копия разделяет дерево с оригиналом
+  persistent_vector(const persistent_vector &) = default;
+  persistent_vector(persistent_vector &&other) noexcept
+      : persistent_vector() {
+    swap(other);
+  }
+  persistent_vector &operator=(const persistent_vector &) = default;
+  persistent_vector &operator=(persistent_vector &&other) noexcept {
+    persistent_vector moved(std::move(other));
+    swap(moved);
+    return *this;
+  }
+
+  // Неизменный снимок текущей версии
+  persistent_vector snapshot() const { return *this; }
+
+  // Element access
+
+  const_reference at(size_type pos) const {
+    if (pos >= size_) throw std::out_of_range("Index is out of range");
+    return (*this)[pos];
+  }
+
+  const_reference operator[](size_type pos) const {
+    return leaf_for(pos)->items[pos & kMask];
+  }
+
+  const_reference front() const {
+    if (empty()) throw std::logic_error("The vector is empty");
+    return (*this)[0];
+  }
+
+  const_reference back() const {
+    if (empty()) throw std::logic_error("The vector is empty");
+    return tail_->items[tail_->count - 1];
+  }
+
+  // Изменяемая ссылка на элемент: общие со снимками узлы на пути к нему
+  // копируются. Действительна до следующего изменения или снимка
+  reference edit(size_type pos) {
+    if (pos >= size_) throw std::out_of_range("Index is out of range");
+    if (pos >= tail_offset()) return own(tail_)->items[pos & kMask];
+    ref *slot = &root_;
+    for (size_type level = shift_; level > 0; level -= kBits) {
+      slot = &own(*slot)->children[(pos >> level) & kMask];
+    }
+    return own(*slot)->items[pos & kMask];
+  }
+
+  void set(size_type pos, const_reference value) { edit(pos) = value; }
+
+  // Iterators
+
+  const_iterator begin() const { return const_iterator(this, 0); }
+  const_iterator end() const { return const_iterator(this, size_); }
+
+  // Capacity
+
+  bool empty() const noexcept { return size_ == 0; }
+  size_type size() const noexcept { return size_; }
+
+  // Modifiers
+
+  // При исключении вектор не меняется
+  void push_back(const_reference value) {
+    if (size_ - tail_offset() == kWidth) {
+      // новый хвост с элементом строится до того, как полный хвост уйдет
+      // в дерево: после этого бросать уже нечему
+      ref fresh(new node(true));
+      new (&fresh->items[0]) T(value);
+      fresh->count = 1;
+      push_tail();
+      tail_ = std::move(fresh);
+      ++size_;
+      return;
+    }
+    if (!tail_) tail_ = ref(new node(true));
+    node *tail = own(tail_);
+    new (&tail->items[tail->count]) T(value);
+    ++tail->count;
+    ++size_;
+  }
+
+  void pop_back() {
+    if (empty()) throw std::logic_error("Vector is empty!");
+    if (size_ == 1) {
+      clear();
+      return;
+    }
+    if (size_ - tail_offset() > 1) {
+      node *tail = own(tail_);
+      tail->items[--tail->count].~T();
+      --size_;
+      return;
+    }
+    // хвост опустел: новым хвостом становится последний лист дерева
+    tail_ = *leaf_slot(size_ - 2);
+    pop_tail(shift_, root_);
+    if (shift_ > kBits && !root_->children[1]) {
+      ref child = root_->children[0];
+      root_ = std::move(child);
+      shift_ -= kBits;
+    }
+    --size_;
+  }
+
+  void clear() noexcept {
+    root_.reset();
+    tail_.reset();
+    size_ = 0;
+    shift_ = kBits;
+  }
+
+  void swap(persistent_vector &other) noexcept {
+    std::swap(root_, other.root_);
+    std::swap(tail_, other.tail_);
+    std::swap(size_, other.size_);
+    std::swap(shift_, other.shift_);
+  }
+
+  class const_iterator {
+   public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const T *;
+    using reference = const T &;
+
+    const_iterator() noexcept : owner_(nullptr), pos_(0), leaf_(nullptr) {}
+
+    reference operator*() const noexcept { return leaf_[pos_ & kMask]; }
+    pointer operator->() const noexcept { return &leaf_[pos_ & kMask]; }
+    reference operator[](difference_type n) const { return *(*this + n); }
+
+    const_iterator &operator++() {
+      ++pos_;
+      // end() не держит листа, поэтому с нее лист ищется заново
+      if (leaf_ == nullptr || (pos_ & kMask) == 0) sync();
+      return *this;
+    }
+    const_iterator operator++(int) {
+      const_iterator old = *this;
+      ++*this;
+      return old;
+    }
+    const_iterator &operator--() {
+      --pos_;
+      if (leaf_ == nullptr || (pos_ & kMask) == kMask) sync();
+      return *this;
+    }
+    const_iterator operator--(int) {
+      const_iterator old = *this;
+      --*this;
+      return old;
+    }
+
+    const_iterator &operator+=(difference_type n) {
+      pos_ += size_type(n);
+      sync();
+      return *this;
+    }
+    const_iterator &operator-=(difference_type n) { return *this += -n; }
+    const_iterator operator+(difference_type n) const {
+      const_iterator moved = *this;
+      return moved += n;
+    }
+    const_iterator operator-(difference_type n) const {
+      const_iterator moved = *this;
+      return moved -= n;
+    }
+    difference_type operator-(const const_iterator &other) const noexcept {
+      return difference_type(pos_) - difference_type(other.pos_);
+    }
+
+    bool operator==(const const_iterator &other) const noexcept {
+      return pos_ == other.pos_;
+    }
+    bool operator!=(const const_iterator &other) const noexcept {
+      return pos_ != other.pos_;
+    }
+    bool operator<(const const_iterator &other) const noexcept {
+      return pos_ < other.pos_;
+    }
+    bool operator>(const const_iterator &other) const noexcept {
+      return pos_ > other.pos_;
+    }
+    bool operator<=(const const_iterator &other) const noexcept {
+      return pos_ <= other.pos_;
+    }
+    bool operator>=(const const_iterator &other) const noexcept {
+      return pos_ >= other.pos_;
+    }
+
+   private:
+    friend class persistent_vector;
+
+    const_iterator(const persistent_vector *owner, size_type pos)
+        : owner_(owner), pos_(pos), leaf_(nullptr) {
+      sync();
+    }
+
+    // Находит лист текущей позиции: спуск по дереву раз на 32 элемента
+    void sync() {
+      leaf_ = pos_ < owner_->size_ ? owner_->leaf_for(pos_)->items : nullptr;
+    }
+
+    const persistent_vector *owner_;
+    size_type pos_;
+    const T *leaf_;
+  };
+
+ private:
+  static constexpr size_type kBits = node::kBits;
+  static constexpr size_type kWidth = node::kWidth;
+  static constexpr size_type kMask = kWidth - 1;
+
+  // Внутренние узлы от корня, листья на глубине shift_ / kBits
+  ref root_;
+  ref tail_;
+  size_type size_;
+  size_type shift_;
+
+  // Индекс первого элемента хвоста
+  size_type tail_offset() const noexcept {
+    return size_ < kWidth ? 0 : ((size_ - 1) >> kBits) << kBits;
+  }
+
+  static node *own(ref &slot) {
+    if (!slot.unique()) slot = ref(new node(*slot.get()));
+    return slot.get();
+  }
+
+  const node *leaf_for(size_type pos) const noexcept {
+    return leaf_slot(pos)->get();
+  }
+
+  const ref *leaf_slot(size_type pos) const noexcept {
+    if (pos >= tail_offset()) return &tail_;
+    const ref *slot = &root_;
+    for (size_type level = shift_; level > 0; level -= kBits) {
+      slot = &(*slot)->children[(pos >> level) & kMask];
+    }
+    return slot;
+  }
+
+  // Вешает полный хвост в дерево, при переполнении корня растет вверх.
+  // tail_ остается на месте, при исключении дерево не меняется
+  void push_tail() {
+    if (!root_) root_ = ref(new node(false));
+    if ((size_ >> kBits) > (size_type(1) << shift_)) {
+      ref grown(new node(false));
+      grown->children[1] = new_path(shift_, tail_);
+      grown->children[0] = std::move(root_);
+      root_ = std::move(grown);
+      shift_ += kBits;
+    } else {
+      push_tail(shift_, root_);
+    }
+  }
+
+  void push_tail(size_type level, ref &parent) {
+    ref &child = own(parent)->children[((size_ - 1) >> level) & kMask];
+    if (level == kBits) {
+      child = tail_;
+    } else if (child) {
+      push_tail(level - kBits, child);
+    } else {
+      child = new_path(level - kBits, tail_);
+    }
+  }
+
+  static ref new_path(size_type level, ref leaf) {
+    if (level == 0) return leaf;
+    ref branch(new node(false));
+    branch->children[0] = new_path(level - kBits, std::move(leaf));
+    return branch;
+  }
+
+  // Снимает из дерева последний лист, пустые узлы удаляются
+  void pop_tail(size_type level, ref &current) {
+    size_type index = ((size_ - 2) >> level) & kMask;
+    if (level > kBits) {
+      ref &child = own(current)->children[index];
+      pop_tail(level - kBits, child);
+      if (!child && index == 0) current.reset();
+    } else if (index == 0) {
+      current.reset();
+    } else {
+      own(current)->children[index].reset();
+    }
+  }
+};
+
+}  // namespace s21
+
+#endif
@@ -0,0 +1,316 @@
+#ifndef S21_PINNED_VECTOR_H_
+#define S21_PINNED_VECTOR_H_
+
+#include <cstddef>
+#include <initializer_list>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define S21_PINNED_MMAP 1
+#include <sys/mman.h>
+#include <unistd.h>
+#else
+#define S21_PINNED_MMAP 0
+#endif
+
+/*
+    Реализация вектора с закрепленными элементами
+    При первом добавлении pinned_vector резервирует непрерывный диапазон
+   адресов на max_size элементов, но не занимает под него память. Страницы
+   подключаются по мере роста, поэтому элементы никогда не перемещаются:
+   указатели, ссылки и итераторы на элементы остаются действительными, пока
+   элемент не удален, а push_back не копирует уже добавленные элементы.
+   Платой служит верхняя граница размера, заданная при создании. Там, где нет
+   mmap, зарезервировать адреса нельзя: буфер растет вдвое, как у обычного
+   вектора, элементы при росте переезжают, и закрепления адресов нет.
+*/
+
+namespace s21 {
+template <typename T>
+class pinned_vector {
+ public:
+  using value_type = T;
+  using reference = T &;
+  using const_reference = const T &;
+  using iterator = T *;
+  using const_iterator = const T *;
+  using size_type = std::size_t;
+
+  // Задает предел в max_size элементов, по умолчанию 16 ГиБ адресов на
+  // 64-битных платформах и 256 МиБ на 32-битных. Адреса резервируются при
+  // первом добавлении, память под них не выделяется
+  explicit pinned_vector(size_type max_size = kDefaultReserveBytes /
+                                              sizeof(value_type)) noexcept
+      : data_(nullptr), size_(0), capacity_(0), max_size_(max_size) {}
+
+  // Конструктор списка инициализации
+  pinned_vector(std::initializer_list<value_type> const &items)
+      : pinned_vector() {
+    reserve(items.size());
+    for (const_reference item : items) push_back(item);
+  }
+
+  // Конструктор копирования, резервирует столько же адресов
+  pinned_vector(const pinned_vector &other) : pinned_vector(other.max_size_) {
+    reserve(other.size_);
+    for (const_reference item : other) push_back(item);
+  }
+
+  // Конструктор перемещения: диапазон переходит целиком, поэтому указатели
+  // на элементы остаются действительными, а other становится пустым
+  pinned_vector(pinned_vector &&other) noexcept
+      : data_(other.data_),
+        size_(other.size_),
+        capacity_(other.capacity_),
+        max_size_(other.max_size_) {
+    other.data_ = nullptr;
+    other.size_ = other.capacity_ = 0;
+  }
+
+  ~pinned_vector() { release(); }
+
+  pinned_vector &operator=(const pinned_vector &other) {
+    if (this != &other) {
+      pinned_vector copy(other);
+      swap(copy);
+    }
+    return *this;
+  }
+
+  pinned_vector &operator=(pinned_vector &&other) noexcept {
+    if (this != &other) {
+      release();
+      data_ = other.data_;
+      size_ = other.size_;
+      capacity_ = other.capacity_;
+      max_size_ = other.max_size_;
+      other.data_ = nullptr;
+      other.size_ = other.capacity_ = 0;
+    }
+    return *this;
+  }
+
+  // Element access
+
+  // Доступ к элементу по индексу с проверкой выхода за пределы
+  reference at(size_type pos) {
+    if (pos >= size_) throw std::out_of_range("Index is out of range");
+    return data_[pos];
+  }
+
+  const_reference at(size_type pos) const {
+    if (pos >= size_) throw std::out_of_range("Index is out of range");
+    return data_[pos];
+  }
+
+  // Доступ к элементу по индексу
+  reference operator[](size_type pos) noexcept { return data_[pos]; }
+  const_reference operator[](size_type pos) const noexcept {
+    return data_[pos];
+  }
+
+  // Доступ к первому элементу
+  const_reference front() const {
+    if (empty()) throw std::logic_error("The vector is empty");
+    return data_[0];
+  }
+
+  // Доступ к последнему элементу
+  const_reference back() const {
+    if (empty()) throw std::logic_error("The vector is empty");
+    return data_[size_ - 1];
+  }
+
+  // Прямой доступ к массиву
+  iterator data() noexcept { return data_; }
+  const_iterator data() const noexcept { return data_; }
+
+  // Iterators
+
+  iterator begin() noexcept { return data_; }
+  iterator end() noexcept { return data_ + size_; }
+  const_iterator begin() const noexcept { return data_; }
+  const_iterator end() const noexcept { return data_ + size_; }
+
+  // Capacity
+
+  bool empty() const noexcept { return size_ == 0; }
+  size_type size() const noexcept { return size_; }
+
+  // Сколько элементов помещается в уже подключенные страницы
+  size_type capacity() const noexcept { return capacity_; }
+
+  // Размер зарезервированного диапазона, больше вектор вырасти не может
+  size_type max_size() const noexcept { return max_size_; }
+
+  // Подключает страницы под size элементов, элементы не перемещаются
+  void reserve(size_type size) {
+    if (size > max_size_) {
+      throw std::length_error("Overflow! Enter a smaller size!");
+    }
+    if (size > capacity_) commit(size);
+  }
+
+  // Возвращает системе целые страницы за последним элементом, адреса
+  // остаются зарезервированными
+  void shrink_to_fit() noexcept {
+#if S21_PINNED_MMAP
+    size_type used = round_to_page(size_ * sizeof(value_type));
+    size_type committed = round_to_page(capacity_ * sizeof(value_type));
+    if (used < committed) {
+      char *tail = reinterpret_cast<char *>(data_) + used;
+      madvise(tail, committed - used, MADV_DONTNEED);
+      mprotect(tail, committed - used, PROT_NONE);
+      capacity_ = used / sizeof(value_type);
+    }
+#endif
+  }
+
+  // Modifiers
+
+  // Удаляет все элементы, страницы остаются подключенными
+  void clear() noexcept {
+    while (size_ > 0) data_[--size_].~value_type();
+  }
+
+  // Добавляет элемент в конец
+  void push_back(const_reference value) { emplace_back(value); }
+  void push_back(value_type &&value) { emplace_back(std::move(value)); }
+
+  // Создает элемент в конце прямо на его постоянном месте
+  template <typename... Args>
+  reference emplace_back(Args &&...args) {
+    if (size_ == capacity_) {
+      if (size_ == max_size_) {
+        throw std::length_error("pinned_vector reserved range is full");
+      }
+      commit(size_ + 1);
+    }
+    T *slot = new (data_ + size_) value_type(std::forward<Args>(args)...);
+    ++size_;
+    return *slot;
+  }
+
+  // Удаляет последний элемент
+  void pop_back() {
+    if (empty()) throw std::logic_error("Vector is empty!");
+    data_[--size_].~value_type();
+  }
+
+  // Меняет содержимое местами, элементы не перемещаются
+  void swap(pinned_vector &other) noexcept {
+    std::swap(data_, other.data_);
+    std::swap(size_, other.size_);
+    std::swap(capacity_, other.capacity_);
+    std::swap(max_size_, other.max_size_);
+  }
+
+ private:
+  static constexpr size_type kDefaultReserveBytes =
+      size_type(1) << (sizeof(void *) >= 8 ? 34 : 28);
+  // Страницы подключаются порциями не меньше этой
+  static constexpr size_type kMinCommitBytes = size_type(64) << 10;
+
+  T *data_;
+  size_type size_;
+  size_type capacity_;
+  size_type max_size_;
+
+#if S21_PINNED_MMAP
+  static size_type page_size() noexcept {
+    static const size_type size = size_type(sysconf(_SC_PAGESIZE));
+    return size;
+  }
+
+  static size_type round_to_page(size_type bytes) noexcept {
+    size_type page = page_size();
+    return (bytes + page - 1) / page * page;
+  }
+
+  size_type reserved_bytes() const noexcept {
+    return round_to_page(max_size_ * sizeof(value_type));
+  }
+
+  // Резервирует адреса без доступа к ним и без учета памяти
+  void reserve_range() {
+    if (max_size_ > size_type(-1) / sizeof(value_type)) {
+      throw std::bad_alloc();
+    }
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#ifdef MAP_NORESERVE
+    flags |= MAP_NORESERVE;
+#endif
+    void *range = mmap(nullptr, reserved_bytes(), PROT_NONE, flags, -1, 0);
+    if (range == MAP_FAILED) throw std::bad_alloc();
+    data_ = static_cast<T *>(range);
+  }
+
+  // Открывает доступ к страницам под size элементов. Подключенная часть
+  // растет хотя бы вдвое, чтобы число системных вызовов было логарифмическим
+  void commit(size_type size) {
+    if (data_ == nullptr) reserve_range();
+    size_type committed = round_to_page(capacity_ * sizeof(value_type));
+    size_type wanted = size * sizeof(value_type);
+    if (wanted < committed * 2) wanted = committed * 2;
+    if (wanted < kMinCommitBytes) wanted = kMinCommitBytes;
+    wanted = round_to_page(wanted);
+    if (wanted > reserved_bytes()) wanted = reserved_bytes();
+    char *start = reinterpret_cast<char *>(data_) + committed;
+    if (mprotect(start, wanted - committed, PROT_READ | PROT_WRITE) != 0)
+      throw std::bad_alloc();
+    capacity_ = wanted / sizeof(value_type);
+    if (capacity_ > max_size_) capacity_ = max_size_;
+  }
+
+  void release() noexcept {
+    if (data_ == nullptr) return;
+    clear();
+    munmap(data_, reserved_bytes());
+    data_ = nullptr;
+    capacity_ = 0;
+  }
+#else
+  // Без mmap буфер растет вдвое, и элементы переезжают в новый
+  void commit(size_type size) {
+    static_assert(std::is_move_constructible_v<value_type>,
+                  "without mmap pinned_vector relocates its elements");
+    size_type wanted = capacity_ * 2;
+    if (wanted < kMinCommitBytes / sizeof(value_type)) {
+      wanted = kMinCommitBytes / sizeof(value_type);
+    }
+    if (wanted < size) wanted = size;
+    if (wanted > max_size_) wanted = max_size_;
+    if (wanted > size_type(-1) / sizeof(value_type)) throw std::bad_alloc();
+    T *fresh = static_cast<T *>(::operator new(wanted * sizeof(value_type)));
+    size_type moved = 0;
+    try {
+      for (; moved < size_; ++moved) {
+        new (fresh + moved) value_type(std::move_if_noexcept(data_[moved]));
+      }
+    } catch (...) {
+      while (moved > 0) fresh[--moved].~value_type();
+      ::operator delete(fresh);
+      throw;
+    }
+    size_type count = size_;
+    release();
+    data_ = fresh;
+    size_ = count;
+    capacity_ = wanted;
+  }
+
+  void release() noexcept {
+    if (data_ == nullptr) return;
+    clear();
+    ::operator delete(data_);
+    data_ = nullptr;
+    capacity_ = 0;
+  }
+#endif
+};
+}  // namespace s21
+
+#endif
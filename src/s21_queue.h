@@ -3,6 +3,10 @@
 #include "s21_list.h"
 
 namespace s21 {
+// Доступ сериализации к внутреннему списку (s21_serialize.h)
+template <typename Container>
+struct serialize_access;
+
 template <typename T>
 class queue {
  public:
@@ -12,7 +16,7 @@ class queue {
   using size_type = std::size_t;
 
   // Конструктор по умолчанию
-  queue() : list() {}
+  queue() noexcept : list() {}
 
   // Конструктор списка инициализации, создает список, инициализированный с
   // помощью std::initializer_list
@@ -22,7 +26,7 @@ class queue {
   queue(const queue &q) : list(q.list) {}
 
   // Конструктор перемещения
-  queue(queue &&q) : list(std::move(q.list)) {}
+  queue(queue &&q) noexcept : list(std::move(q.list)) {}
 
   // Деструктор
   ~queue() = default;
@@ -33,6 +37,12 @@ class queue {
     return *this;
   }
 
+  queue &operator=(queue &&q) noexcept {
+    list = std::move(q.list);
+
+    return *this;
+  }
+
   // Element access
 
   // Доступ к первому константному элементу
@@ -58,7 +68,7 @@ class queue {
   void pop() { list.pop_front(); }
 
   // Меняет содержимое местами
-  void swap(queue &other) { list.swap(other.list); }
+  void swap(queue &other) noexcept { list.swap(other.list); }
 
   // Добавляет новые элементы в конец контейнера
   template <typename... Args>
@@ -67,6 +77,8 @@ class queue {
   }
 
  private:
+  friend struct serialize_access<queue>;
+
   s21::list<T> list;
 };
 }  // namespace s21
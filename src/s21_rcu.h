@@ -0,0 +1,283 @@
+#ifndef S21_RCU_H_
+#define S21_RCU_H_
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#if defined(__linux__)
+#include <linux/membarrier.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "s21_map.h"
+#include "s21_reclaim.h"
+
+/*
+    Реализация словаря для чтения по схеме RCU (read-copy-update)
+    rcu_map хранит неизменяемую версию словаря за атомарным указателем.
+   Читатель входит в секцию чтения, читает указатель и работает с версией
+   без блокировок и без атомарных операций чтения-изменения-записи: вход и
+   выход - это запись в счетчик своего потока, который не делит кеш-линию
+   с другими, поэтому чтение масштабируется по ядрам. Писатель копирует
+   текущую версию, меняет копию, публикует ее и ждет окончания льготного
+   периода: пока каждый читатель, начавший до публикации, не выйдет из
+   секции. После этого старая версия удаляется. Запись дорогая, поэтому
+   схема подходит для таблиц, которые читают миллионы раз в секунду, а
+   меняют несколько раз в минуту. На Linux барьер памяти на стороне
+   читателя заменяется системным вызовом membarrier у писателя, и в
+   секции чтения не остается даже барьеров.
+*/
+
+namespace s21 {
+namespace detail {
+
+// Общий домен RCU: счетчики читателей и ожидание льготного периода
+class rcu_domain {
+  struct record;
+
+ public:
+  static rcu_domain &global() {
+    static rcu_domain domain;
+    return domain;
+  }
+
+  rcu_domain(const rcu_domain &) = delete;
+  rcu_domain &operator=(const rcu_domain &) = delete;
+
+  // Секция чтения на время жизни. Вложенные секции разрешены
+  class read_guard {
+   public:
+    read_guard() : record_(&global().local()) { global().read_lock(*record_); }
+    read_guard(read_guard &&other) noexcept : record_(other.record_) {
+      other.record_ = nullptr;
+    }
+    read_guard(const read_guard &) = delete;
+    read_guard &operator=(const read_guard &) = delete;
+    read_guard &operator=(read_guard &&) = delete;
+    ~read_guard() {
+      if (record_ != nullptr) global().read_unlock(*record_);
+    }
+
+   private:
+    record *record_;
+  };
+
+  // true, если вызывающий поток сейчас в секции чтения
+  bool reading() { return local().nesting != 0; }
+
+  // Ждет, пока завершатся все секции чтения, начатые до вызова. Внутри
+  // секции чтения бросает std::logic_error: поток ждал бы сам себя
+  void synchronize() {
+    if (reading()) {
+      throw std::logic_error("rcu_domain::synchronize inside read section");
+    }
+    std::lock_guard<std::mutex> lock(synchronize_mutex_);
+    heavy_barrier();
+    std::uint64_t target = period_.load(std::memory_order_relaxed) + 1;
+    period_.store(target, std::memory_order_seq_cst);
+    heavy_barrier();
+    registry_.for_each([target](const record &reader) {
+      while (true) {
+        std::uint64_t seen = reader.period.load(std::memory_order_acquire);
+        if (seen == 0 || seen >= target) break;
+        std::this_thread::yield();
+      }
+    });
+    heavy_barrier();
+  }
+
+ private:
+  // Счетчик потока на своей кеш-линии
+  struct alignas(64) record {
+    // Льготный период на входе в секцию, 0 - поток вне секции
+    std::atomic<std::uint64_t> period{0};
+    std::atomic<bool> in_use{true};
+    unsigned nesting = 0;
+    record *next = nullptr;
+  };
+
+  struct thread_entry {
+    explicit thread_entry(rcu_domain &owner)
+        : domain(owner), rec(owner.registry_.acquire()) {}
+    ~thread_entry() { domain.registry_.release(*rec); }
+    rcu_domain &domain;
+    record *rec;
+  };
+
+  // Номера периодов начинаются с 1, чтобы 0 значил "вне секции"
+  std::atomic<std::uint64_t> period_{1};
+  detail::thread_registry<record> registry_;
+  std::mutex synchronize_mutex_;
+  bool membarrier_ = false;
+
+  rcu_domain() {
+#if defined(__linux__) && defined(__NR_membarrier)
+    long commands = ::syscall(__NR_membarrier, MEMBARRIER_CMD_QUERY, 0);
+    if (commands > 0 &&
+        (commands & MEMBARRIER_CMD_PRIVATE_EXPEDITED) != 0 &&
+        ::syscall(__NR_membarrier,
+                  MEMBARRIER_CMD_REGISTER_PRIVATE_EXPEDITED, 0) == 0) {
+      membarrier_ = true;
+    }
+#endif
+  }
+
+  record &local() {
+    thread_local thread_entry entry(*this);
+    return *entry.rec;
+  }
+
+  void read_lock(record &owner) noexcept {
+    if (owner.nesting++ != 0) return;
+    owner.period.store(period_.load(std::memory_order_relaxed),
+                       std::memory_order_relaxed);
+    light_barrier();
+  }
+
+  void read_unlock(record &owner) noexcept {
+    if (--owner.nesting != 0) return;
+    light_barrier();
+    owner.period.store(0, std::memory_order_release);
+  }
+
+  // Барьер читателя. С membarrier достаточно запретить перестановки
+  // компилятору: порядок на процессоре обеспечивает писатель
+  void light_barrier() const noexcept {
+    if (membarrier_) {
+      std::atomic_signal_fence(std::memory_order_seq_cst);
+    } else {
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+  }
+
+  // Барьер писателя: полный барьер на всех ядрах, где работают потоки
+  // процесса
+  void heavy_barrier() const noexcept {
+#if defined(__linux__) && defined(__NR_membarrier)
+    if (membarrier_) {
+      ::syscall(__NR_membarrier, MEMBARRIER_CMD_PRIVATE_EXPEDITED, 0);
+      return;
+    }
+#endif
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+  }
+};
+
+}  // namespace detail
+
+// Map - s21::map или любой словарь с contains и at, например frozen_map.
+// Изменения через update копируют Map, поэтому он должен копироваться
+template <typename Key, typename T, typename Map = s21::map<Key, T>>
+class rcu_map {
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using map_type = Map;
+  using size_type = std::size_t;
+
+  // Версия словаря, которая не удаляется, пока жив reader. Reader нельзя
+  // передавать в другой поток, а пока он жив, поток не может писать в
+  // этот и любой другой rcu_map: запись ждала бы его окончания
+  class reader {
+   public:
+    const Map &operator*() const noexcept { return *map_; }
+    const Map *operator->() const noexcept { return map_; }
+
+   private:
+    friend class rcu_map;
+    explicit reader(const std::atomic<const Map *> &current)
+        : guard_(), map_(current.load(std::memory_order_acquire)) {}
+
+    detail::rcu_domain::read_guard guard_;
+    const Map *map_;
+  };
+
+  rcu_map() : current_(new Map()) {}
+  explicit rcu_map(Map initial) : current_(new Map(std::move(initial))) {}
+
+  rcu_map(const rcu_map &) = delete;
+  rcu_map &operator=(const rcu_map &) = delete;
+
+  // Разрушать можно, когда читателей и писателей уже нет
+  ~rcu_map() { delete current_.load(std::memory_order_relaxed); }
+
+  // Readers
+
+  // Текущая версия для серии обращений
+  reader read() const { return reader(current_); }
+
+  // Копия значения ключа или пустой optional
+  std::optional<T> find(const Key &key) const {
+    reader version = read();
+    if (!version->contains(key)) return std::nullopt;
+    return version->at(key);
+  }
+
+  bool contains(const Key &key) const { return read()->contains(key); }
+  size_type size() const { return read()->size(); }
+  bool empty() const { return size() == 0; }
+
+  // Writers
+
+  // Копирует текущую версию, вызывает fn(Map &) для копии и публикует
+  // ее. Писатели выполняются по одному, каждый ждет льготный период.
+  // Если у потока есть живой reader, бросает std::logic_error и ничего
+  // не меняет
+  template <typename Function>
+  void update(Function fn) {
+    check_writer();
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    Map *next = new Map(*current_.load(std::memory_order_relaxed));
+    try {
+      fn(*next);
+    } catch (...) {
+      delete next;
+      throw;
+    }
+    retire(current_.exchange(next, std::memory_order_acq_rel));
+  }
+
+  // Публикует заранее построенную версию
+  void assign(Map next) {
+    check_writer();
+    Map *fresh = new Map(std::move(next));
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    retire(current_.exchange(fresh, std::memory_order_acq_rel));
+  }
+
+  void insert_or_assign(const Key &key, const T &obj) {
+    update([&](Map &map) { map.insert_or_assign(key, obj); });
+  }
+
+  size_type erase(const Key &key) {
+    size_type erased = 0;
+    update([&](Map &map) { erased = map.extract(key) ? 1 : 0; });
+    return erased;
+  }
+
+ private:
+  std::atomic<const Map *> current_;
+  std::mutex write_mutex_;
+
+  static void check_writer() {
+    if (detail::rcu_domain::global().reading()) {
+      throw std::logic_error("rcu_map: write while holding a reader");
+    }
+  }
+
+  // Удаляет старую версию после льготного периода
+  static void retire(const Map *old) {
+    detail::rcu_domain::global().synchronize();
+    delete old;
+  }
+};
+
+}  // namespace s21
+
+#endif
@@ -0,0 +1,475 @@
+#ifndef S21_RECLAIM_H_
+#define S21_RECLAIM_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+/*
+    Отложенное освобождение памяти для конкурентных контейнеров
+    Узел, вырезанный из структуры без блокировок, может еще читаться
+   потоками, которые добрались до него раньше. s21::reclaim дает два
+   способа узнать, когда его можно удалить. epoch_domain - освобождение по
+   эпохам: поток объявляет эпоху на время операции (guard), а удаленные
+   объекты копятся пачками и освобождаются, когда все активные потоки
+   ушли на две эпохи вперед. Это почти бесплатно для читателя, но один
+   застрявший поток задерживает освобождение всего мусора. hazard_domain -
+   указатели опасности: поток публикует адрес каждого узла, который
+   читает, а удаляются только объекты, которых нет ни в одном слоте.
+   Каждый доступ стоит барьера, зато неосвобожденных объектов не больше,
+   чем порог сканирования плюс число слотов. Потоки регистрируются сами
+   при первом обращении и отдают запись и свой мусор домену при
+   завершении. register_thread и unregister_thread делают это явно, а
+   collect освобождает все, что уже безопасно.
+*/
+
+namespace s21 {
+namespace detail {
+
+// Реестр записей потоков. Записи живут до разрушения реестра, а после
+// завершения потока достаются новым потокам. Record должна содержать
+// std::atomic<bool> in_use{true} и Record *next
+template <typename Record>
+class thread_registry {
+ public:
+  thread_registry() = default;
+  thread_registry(const thread_registry &) = delete;
+  thread_registry &operator=(const thread_registry &) = delete;
+
+  ~thread_registry() {
+    Record *current = head_.load(std::memory_order_acquire);
+    while (current != nullptr) {
+      Record *next = current->next;
+      delete current;
+      current = next;
+    }
+  }
+
+  Record *acquire() {
+    Record *current = head_.load(std::memory_order_acquire);
+    for (; current != nullptr; current = current->next) {
+      bool free = false;
+      if (!current->in_use.load(std::memory_order_relaxed) &&
+          current->in_use.compare_exchange_strong(free, true)) {
+        return current;
+      }
+    }
+    Record *fresh = new Record;
+    fresh->next = head_.load(std::memory_order_relaxed);
+    while (!head_.compare_exchange_weak(fresh->next, fresh)) {
+    }
+    count_.fetch_add(1, std::memory_order_relaxed);
+    return fresh;
+  }
+
+  static void release(Record &record) noexcept {
+    record.in_use.store(false, std::memory_order_release);
+  }
+
+  // Обходит все записи, включая свободные
+  template <typename Function>
+  void for_each(Function fn) const {
+    Record *current = head_.load(std::memory_order_acquire);
+    for (; current != nullptr; current = current->next) fn(*current);
+  }
+
+  std::size_t size() const noexcept {
+    return count_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  std::atomic<Record *> head_{nullptr};
+  std::atomic<std::size_t> count_{0};
+};
+
+// Объект, ожидающий освобождения
+struct retired {
+  void *object;
+  void (*deleter)(void *);
+  std::uint64_t epoch;
+};
+
+template <typename T>
+void delete_object(void *object) {
+  delete static_cast<T *>(object);
+}
+
+// Отложенные объекты завершившихся потоков
+class orphan_list {
+ public:
+  ~orphan_list() {
+    for (const retired &item : items_) item.deleter(item.object);
+  }
+
+  void adopt(std::vector<retired> &items) {
+    if (items.empty()) return;
+    std::lock_guard<std::mutex> lock(mutex_);
+    items_.insert(items_.end(), items.begin(), items.end());
+    items.clear();
+  }
+
+  // Освобождает подходящие объекты, если список никто не держит
+  template <typename Expired>
+  std::size_t try_free(Expired expired) {
+    std::unique_lock<std::mutex> lock(mutex_, std::try_to_lock);
+    if (!lock.owns_lock()) return 0;
+    return free_if(items_, expired);
+  }
+
+  // Удаляет объекты, для которых expired(item) истинно
+  template <typename Expired>
+  static std::size_t free_if(std::vector<retired> &items, Expired expired) {
+    std::size_t kept = 0;
+    std::size_t freed = 0;
+    for (const retired &item : items) {
+      if (expired(item)) {
+        item.deleter(item.object);
+        ++freed;
+      } else {
+        items[kept++] = item;
+      }
+    }
+    items.resize(kept);
+    return freed;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::vector<retired> items_;
+};
+
+}  // namespace detail
+
+namespace reclaim {
+
+// Освобождение по эпохам, общий домен процесса
+class epoch_domain {
+  struct record;
+
+ public:
+  static epoch_domain &global() {
+    static epoch_domain domain;
+    return domain;
+  }
+
+  epoch_domain(const epoch_domain &) = delete;
+  epoch_domain &operator=(const epoch_domain &) = delete;
+
+  ~epoch_domain() {
+    registry_.for_each([](record &owner) {
+      for (const detail::retired &item : owner.garbage) {
+        item.deleter(item.object);
+      }
+      owner.garbage.clear();
+    });
+  }
+
+  // Объявляет эпоху потока на время своей жизни. Вложенные guard
+  // разрешены, guard нельзя передавать в другой поток
+  class guard {
+   public:
+    guard() : record_(&global().local()) { global().enter(*record_); }
+    // Пустой guard эпоху не объявляет
+    explicit guard(std::nullptr_t) noexcept : record_(nullptr) {}
+    guard(const guard &other) : record_(other.record_) {
+      if (record_ != nullptr) global().enter(*record_);
+    }
+    guard &operator=(const guard &other) {
+      guard copy(other);
+      std::swap(record_, copy.record_);
+      return *this;
+    }
+    ~guard() { reset(); }
+
+    void reset() noexcept {
+      if (record_ != nullptr) global().leave(*record_);
+      record_ = nullptr;
+    }
+
+   private:
+    record *record_;
+  };
+
+  // Берет запись потока заранее, а не при первом guard
+  void register_thread() { local(); }
+
+  // Отдает запись потока и его мусор домену. Вызывать вне guard
+  void unregister_thread() { detach(local_entry()); }
+
+  // Откладывает освобождение объекта, уже недостижимого для новых
+  // читателей. Раз в пачку пытается освободить накопленное
+  void retire(void *object, void (*deleter)(void *)) {
+    record &owner = local();
+    owner.garbage.push_back(
+        {object, deleter, epoch_.load(std::memory_order_seq_cst)});
+    if (owner.garbage.size() >= kBatch) collect(owner);
+  }
+
+  template <typename T>
+  void retire(T *object) {
+    retire(object, &detail::delete_object<T>);
+  }
+
+  // Продвигает эпоху, если все активные потоки ее видели, и освобождает
+  // объекты, удаленные хотя бы две эпохи назад. Возвращает их число
+  std::size_t collect() { return collect(local()); }
+
+  // Объектов этого потока, ожидающих освобождения
+  std::size_t pending() { return local().garbage.size(); }
+
+ private:
+  // Запись потока на своей кеш-линии
+  struct alignas(64) record {
+    // (эпоха << 1) | 1, пока поток внутри guard, иначе 0
+    std::atomic<std::uint64_t> state{0};
+    std::atomic<bool> in_use{true};
+    std::size_t nesting = 0;
+    std::vector<detail::retired> garbage;
+    record *next = nullptr;
+  };
+
+  struct thread_entry {
+    explicit thread_entry(epoch_domain &owner) : domain(owner), rec(nullptr) {}
+    ~thread_entry() { domain.detach(*this); }
+    epoch_domain &domain;
+    record *rec;
+  };
+
+  // Столько отложенных объектов копится до попытки освобождения
+  static constexpr std::size_t kBatch = 64;
+
+  std::atomic<std::uint64_t> epoch_{0};
+  detail::thread_registry<record> registry_;
+  detail::orphan_list orphans_;
+
+  epoch_domain() = default;
+
+  thread_entry &local_entry() {
+    thread_local thread_entry entry(*this);
+    return entry;
+  }
+
+  record &local() {
+    thread_entry &entry = local_entry();
+    if (entry.rec == nullptr) entry.rec = registry_.acquire();
+    return *entry.rec;
+  }
+
+  void detach(thread_entry &entry) {
+    if (entry.rec == nullptr) return;
+    orphans_.adopt(entry.rec->garbage);
+    registry_.release(*entry.rec);
+    entry.rec = nullptr;
+  }
+
+  void enter(record &owner) {
+    if (owner.nesting++ != 0) return;
+    std::uint64_t epoch = epoch_.load(std::memory_order_seq_cst);
+    owner.state.store((epoch << 1) | 1, std::memory_order_relaxed);
+    // запись эпохи видна сканеру раньше любых чтений структуры
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+  }
+
+  void leave(record &owner) noexcept {
+    if (--owner.nesting == 0) {
+      owner.state.store(0, std::memory_order_release);
+    }
+  }
+
+  void try_advance() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    std::uint64_t epoch = epoch_.load(std::memory_order_seq_cst);
+    bool behind = false;
+    registry_.for_each([&](const record &owner) {
+      std::uint64_t state = owner.state.load(std::memory_order_seq_cst);
+      if ((state & 1) != 0 && (state >> 1) != epoch) behind = true;
+    });
+    if (!behind) epoch_.compare_exchange_strong(epoch, epoch + 1);
+  }
+
+  std::size_t collect(record &owner) {
+    try_advance();
+    std::uint64_t epoch = epoch_.load(std::memory_order_seq_cst);
+    auto expired = [epoch](const detail::retired &item) {
+      return item.epoch + 2 <= epoch;
+    };
+    std::size_t freed = detail::orphan_list::free_if(owner.garbage, expired);
+    return freed + orphans_.try_free(expired);
+  }
+};
+
+// Указатели опасности, общий домен процесса
+class hazard_domain {
+  struct record;
+
+ public:
+  // Слотов на поток: столько узлов поток может защищать одновременно
+  static constexpr std::size_t kSlots = 4;
+
+  static hazard_domain &global() {
+    static hazard_domain domain;
+    return domain;
+  }
+
+  hazard_domain(const hazard_domain &) = delete;
+  hazard_domain &operator=(const hazard_domain &) = delete;
+
+  ~hazard_domain() {
+    registry_.for_each([](record &owner) {
+      for (const detail::retired &item : owner.garbage) {
+        item.deleter(item.object);
+      }
+      owner.garbage.clear();
+    });
+  }
+
+  // Слот потока для одного защищаемого указателя. Больше kSlots
+  // одновременно - std::length_error
+  class hazard_pointer {
+   public:
+    hazard_pointer() : record_(&global().local()), slot_(take_slot()) {}
+    hazard_pointer(const hazard_pointer &) = delete;
+    hazard_pointer &operator=(const hazard_pointer &) = delete;
+    ~hazard_pointer() {
+      reset();
+      record_->taken[slot_] = false;
+    }
+
+    // Читает указатель из source и публикует его. После возврата объект
+    // не освободится, пока указатель защищен
+    template <typename T>
+    T *protect(const std::atomic<T *> &source) noexcept {
+      T *pointer = source.load(std::memory_order_relaxed);
+      while (true) {
+        set(pointer);
+        T *again = source.load(std::memory_order_seq_cst);
+        if (again == pointer) return pointer;
+        pointer = again;
+      }
+    }
+
+    // Публикует указатель, который вызывающий проверит сам
+    void set(const void *pointer) noexcept {
+      record_->slots[slot_].store(pointer, std::memory_order_seq_cst);
+    }
+
+    void reset() noexcept {
+      record_->slots[slot_].store(nullptr, std::memory_order_release);
+    }
+
+   private:
+    record *record_;
+    std::size_t slot_;
+
+    std::size_t take_slot() {
+      for (std::size_t i = 0; i < kSlots; ++i) {
+        if (!record_->taken[i]) {
+          record_->taken[i] = true;
+          return i;
+        }
+      }
+      throw std::length_error("hazard_pointer: no free slots");
+    }
+  };
+
+  void register_thread() { local(); }
+
+  // Отдает запись потока и его мусор домену. Вызывать, когда у потока
+  // нет живых hazard_pointer
+  void unregister_thread() { detach(local_entry()); }
+
+  // Откладывает освобождение объекта, уже недостижимого из структуры.
+  // Сканирует слоты, когда отложенных объектов вдвое больше, чем слотов
+  void retire(void *object, void (*deleter)(void *)) {
+    record &owner = local();
+    owner.garbage.push_back({object, deleter, 0});
+    if (owner.garbage.size() >= threshold()) collect(owner);
+  }
+
+  template <typename T>
+  void retire(T *object) {
+    retire(object, &detail::delete_object<T>);
+  }
+
+  // Освобождает объекты, не защищенные ни одним слотом. Возвращает их
+  // число
+  std::size_t collect() { return collect(local()); }
+
+  std::size_t pending() { return local().garbage.size(); }
+
+  // Больше стольких объектов поток не держит неосвобожденными
+  std::size_t threshold() const noexcept {
+    return std::max<std::size_t>(kMinBatch, 2 * kSlots * registry_.size());
+  }
+
+ private:
+  struct alignas(64) record {
+    std::atomic<const void *> slots[kSlots] = {};
+    // Какие слоты заняты hazard_pointer, меняется только владельцем
+    bool taken[kSlots] = {};
+    std::atomic<bool> in_use{true};
+    std::vector<detail::retired> garbage;
+    record *next = nullptr;
+  };
+
+  struct thread_entry {
+    explicit thread_entry(hazard_domain &owner)
+        : domain(owner), rec(nullptr) {}
+    ~thread_entry() { domain.detach(*this); }
+    hazard_domain &domain;
+    record *rec;
+  };
+
+  static constexpr std::size_t kMinBatch = 16;
+
+  detail::thread_registry<record> registry_;
+  detail::orphan_list orphans_;
+
+  hazard_domain() = default;
+
+  thread_entry &local_entry() {
+    thread_local thread_entry entry(*this);
+    return entry;
+  }
+
+  record &local() {
+    thread_entry &entry = local_entry();
+    if (entry.rec == nullptr) entry.rec = registry_.acquire();
+    return *entry.rec;
+  }
+
+  void detach(thread_entry &entry) {
+    if (entry.rec == nullptr) return;
+    orphans_.adopt(entry.rec->garbage);
+    registry_.release(*entry.rec);
+    entry.rec = nullptr;
+  }
+
+  std::size_t collect(record &owner) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    std::vector<const void *> hazards;
+    registry_.for_each([&hazards](const record &other) {
+      for (const auto &slot : other.slots) {
+        const void *pointer = slot.load(std::memory_order_seq_cst);
+        if (pointer != nullptr) hazards.push_back(pointer);
+      }
+    });
+    std::sort(hazards.begin(), hazards.end());
+    auto expired = [&hazards](const detail::retired &item) {
+      return !std::binary_search(hazards.begin(), hazards.end(),
+                                 static_cast<const void *>(item.object));
+    };
+    std::size_t freed = detail::orphan_list::free_if(owner.garbage, expired);
+    return freed + orphans_.try_free(expired);
+  }
+};
+
+}  // namespace reclaim
+}  // namespace s21
+
+#endif
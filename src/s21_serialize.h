@@ -0,0 +1,654 @@
+#ifndef S21_SERIALIZE_H_
+#define S21_SERIALIZE_H_
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define S21_SERIALIZE_FD 1
+#include <unistd.h>
+#else
+#define S21_SERIALIZE_FD 0
+#endif
+
+#include "s21_array.h"
+#include "s21_list.h"
+#include "s21_map.h"
+#include "s21_multiset.h"
+#include "s21_queue.h"
+#include "s21_set.h"
+#include "s21_stack.h"
+#include "s21_vector.h"
+
+/*
+    Двоичная сериализация контейнеров
+    save пишет контейнер в поток, load читает его обратно. Каждый контейнер
+   начинается с заголовка: сигнатура, версия формата, вид контейнера, порядок
+   байт, размер элемента и число элементов, за ним идут элементы. Тривиально
+   копируемые элементы vector и array пишутся одним блоком, строки - длиной и
+   байтами, пары и вложенные контейнеры - поэлементно. Деревья хранятся в
+   порядке обхода и при чтении строятся за O(n) через assign_sorted, без
+   поиска места для каждого ключа. Поток - любой объект с методом
+   write(const void*, size_t) или read(void*, size_t); готовые есть для
+   std::FILE*, файлового дескриптора и буфера в памяти. Испорченный или
+   обрезанный поток приводит к std::runtime_error, содержимое контейнера при
+   этом не меняется.
+*/
+
+namespace s21 {
+
+// Streams
+
+// Пишет в std::FILE*, буферизацией занимается stdio
+class file_writer {
+ public:
+  explicit file_writer(std::FILE *file) noexcept : file_(file) {}
+
+  void write(const void *data, std::size_t size) {
+    if (size != 0 && std::fwrite(data, 1, size, file_) != size) {
+      throw std::system_error(errno, std::generic_category(),
+                              "file_writer: fwrite failed");
+    }
+  }
+
+ private:
+  std::FILE *file_;
+};
+
+// Читает из std::FILE*
+class file_reader {
+ public:
+  explicit file_reader(std::FILE *file) noexcept : file_(file) {}
+
+  void read(void *data, std::size_t size) {
+    if (size != 0 && std::fread(data, 1, size, file_) != size) {
+      if (std::ferror(file_)) {
+        throw std::system_error(errno, std::generic_category(),
+                                "file_reader: fread failed");
+      }
+      throw std::runtime_error("serialize: unexpected end of stream");
+    }
+  }
+
+ private:
+  std::FILE *file_;
+};
+
+// Дописывает в буфер в памяти
+class buffer_writer {
+ public:
+  explicit buffer_writer(std::vector<unsigned char> &buffer) noexcept
+      : buffer_(buffer) {}
+
+  void write(const void *data, std::size_t size) {
+    const unsigned char *bytes = static_cast<const unsigned char *>(data);
+    buffer_.insert(buffer_.end(), bytes, bytes + size);
+  }
+
+ private:
+  std::vector<unsigned char> &buffer_;
+};
+
+// Читает из буфера в памяти, буфер должен жить дольше читателя
+class buffer_reader {
+ public:
+  buffer_reader(const void *data, std::size_t size) noexcept
+      : data_(static_cast<const unsigned char *>(data)), size_(size), pos_(0) {}
+
+  explicit buffer_reader(const std::vector<unsigned char> &buffer) noexcept
+      : buffer_reader(buffer.data(), buffer.size()) {}
+  explicit buffer_reader(std::vector<unsigned char> &&) = delete;
+
+  void read(void *data, std::size_t size) {
+    if (size > size_ - pos_) {
+      throw std::runtime_error("serialize: unexpected end of stream");
+    }
+    if (size != 0) std::memcpy(data, data_ + pos_, size);
+    pos_ += size;
+  }
+
+  // Сколько байт еще не прочитано
+  std::size_t remaining() const noexcept { return size_ - pos_; }
+
+ private:
+  const unsigned char *data_;
+  std::size_t size_;
+  std::size_t pos_;
+};
+
+#if S21_SERIALIZE_FD
+// Пишет в файловый дескриптор через буфер, чтобы мелкие элементы не
+// превращались в отдельные системные вызовы. Остаток буфера уходит в flush
+// или в деструкторе, дескриптор не закрывается
+class fd_writer {
+ public:
+  explicit fd_writer(int fd)
+      : fd_(fd), buffer_(new char[kBufferBytes]), used_(0) {}
+
+  fd_writer(const fd_writer &) = delete;
+  fd_writer &operator=(const fd_writer &) = delete;
+
+  ~fd_writer() {
+    try {
+      flush();
+    } catch (...) {
+    }
+  }
+
+  void write(const void *data, std::size_t size) {
+    const char *bytes = static_cast<const char *>(data);
+    if (used_ + size > kBufferBytes) {
+      flush();
+      if (size >= kBufferBytes) {
+        write_all(bytes, size);
+        return;
+      }
+    }
+    std::memcpy(buffer_.get() + used_, bytes, size);
+    used_ += size;
+  }
+
+  // Отдает накопленные байты системе
+  void flush() {
+    std::size_t used = used_;
+    used_ = 0;
+    write_all(buffer_.get(), used);
+  }
+
+ private:
+  static constexpr std::size_t kBufferBytes = std::size_t(64) << 10;
+
+  int fd_;
+  std::unique_ptr<char[]> buffer_;
+  std::size_t used_;
+
+  void write_all(const char *data, std::size_t size) {
+    while (size > 0) {
+      ssize_t done = ::write(fd_, data, size);
+      if (done < 0) {
+        if (errno == EINTR) continue;
+        throw std::system_error(errno, std::generic_category(),
+                                "fd_writer: write failed");
+      }
+      data += done;
+      size -= std::size_t(done);
+    }
+  }
+};
+
+// Читает из файлового дескриптора через буфер
+class fd_reader {
+ public:
+  explicit fd_reader(int fd)
+      : fd_(fd), buffer_(new char[kBufferBytes]), pos_(0), end_(0) {}
+
+  fd_reader(const fd_reader &) = delete;
+  fd_reader &operator=(const fd_reader &) = delete;
+
+  void read(void *data, std::size_t size) {
+    char *bytes = static_cast<char *>(data);
+    while (size > 0) {
+      if (pos_ == end_ && !fill()) {
+        throw std::runtime_error("serialize: unexpected end of stream");
+      }
+      std::size_t part = end_ - pos_ < size ? end_ - pos_ : size;
+      std::memcpy(bytes, buffer_.get() + pos_, part);
+      pos_ += part;
+      bytes += part;
+      size -= part;
+    }
+  }
+
+ private:
+  static constexpr std::size_t kBufferBytes = std::size_t(64) << 10;
+
+  int fd_;
+  std::unique_ptr<char[]> buffer_;
+  std::size_t pos_;
+  std::size_t end_;
+
+  bool fill() {
+    ssize_t done;
+    do {
+      done = ::read(fd_, buffer_.get(), kBufferBytes);
+    } while (done < 0 && errno == EINTR);
+    if (done < 0) {
+      throw std::system_error(errno, std::generic_category(),
+                              "fd_reader: read failed");
+    }
+    pos_ = 0;
+    end_ = std::size_t(done);
+    return done > 0;
+  }
+};
+#endif
+
+// Format
+
+namespace detail {
+
+// Вид контейнера в заголовке, 0 - не контейнер s21
+template <typename C>
+struct container_kind : std::integral_constant<std::uint8_t, 0> {};
+template <typename T>
+struct container_kind<vector<T>> : std::integral_constant<std::uint8_t, 1> {};
+template <typename T, std::size_t N>
+struct container_kind<array<T, N>>
+    : std::integral_constant<std::uint8_t, 2> {};
+template <typename T>
+struct container_kind<list<T>> : std::integral_constant<std::uint8_t, 3> {};
+template <typename K>
+struct container_kind<set<K>> : std::integral_constant<std::uint8_t, 4> {};
+template <typename K>
+struct container_kind<multiset<K>>
+    : std::integral_constant<std::uint8_t, 5> {};
+template <typename K, typename V>
+struct container_kind<map<K, V>> : std::integral_constant<std::uint8_t, 6> {};
+template <typename T>
+struct container_kind<stack<T>> : std::integral_constant<std::uint8_t, 7> {};
+template <typename T>
+struct container_kind<queue<T>> : std::integral_constant<std::uint8_t, 8> {};
+
+template <typename C>
+constexpr std::uint8_t kind_v = container_kind<C>::value;
+
+template <typename T>
+struct is_pair : std::false_type {};
+template <typename A, typename B>
+struct is_pair<std::pair<A, B>> : std::true_type {};
+
+// Элементы, которые пишутся как есть. Пары идут по полям, чтобы в поток не
+// попадали байты выравнивания
+template <typename T>
+constexpr bool is_raw_v = std::is_trivially_copyable_v<T> && !is_pair<T>::value;
+
+constexpr char kMagic[4] = {'S', '2', '1', 'B'};
+constexpr std::uint8_t kVersion = 1;
+// Первый байт единицы в памяти: 1 на little-endian, 0 на big-endian
+constexpr std::uint16_t kByteOrderProbe = 1;
+
+inline std::uint8_t byte_order() noexcept {
+  std::uint8_t first;
+  std::memcpy(&first, &kByteOrderProbe, 1);
+  return first;
+}
+
+// Размер элемента в заголовке: для сырых элементов sizeof, иначе 0
+template <typename T>
+constexpr std::uint32_t element_size() noexcept {
+  return is_raw_v<T> ? std::uint32_t(sizeof(T)) : 0;
+}
+
+template <typename Writer, typename T>
+void write_header(Writer &out, std::uint8_t kind, std::uint64_t count) {
+  unsigned char head[8] = {};
+  std::memcpy(head, kMagic, sizeof(kMagic));
+  head[4] = kVersion;
+  head[5] = kind;
+  head[6] = byte_order();
+  std::uint32_t size = element_size<T>();
+  out.write(head, sizeof(head));
+  out.write(&size, sizeof(size));
+  out.write(&count, sizeof(count));
+}
+
+// Проверяет заголовок и возвращает число элементов
+template <typename Reader, typename T>
+std::uint64_t read_header(Reader &in, std::uint8_t kind) {
+  unsigned char head[8];
+  std::uint32_t size;
+  std::uint64_t count;
+  in.read(head, sizeof(head));
+  in.read(&size, sizeof(size));
+  in.read(&count, sizeof(count));
+  if (std::memcmp(head, kMagic, sizeof(kMagic)) != 0) {
+    throw std::runtime_error("serialize: bad signature");
+  }
+  if (head[4] != kVersion) {
+    throw std::runtime_error("serialize: unsupported format version");
+  }
+  if (head[5] != kind) {
+    throw std::runtime_error("serialize: container kind mismatch");
+  }
+  if (head[6] != byte_order()) {
+    throw std::runtime_error("serialize: byte order mismatch");
+  }
+  if (size != element_size<T>()) {
+    throw std::runtime_error("serialize: element size mismatch");
+  }
+  return count;
+}
+
+}  // namespace detail
+
+namespace detail {
+template <typename Writer, typename C>
+void save_nested(Writer &out, const C &value);
+template <typename Reader, typename C>
+void load_nested(Reader &in, C &value);
+}  // namespace detail
+
+// Запись и чтение одного элемента. Специализации можно добавить для своих
+// типов: save(out, value) и T load(in)
+template <typename T, typename Enable = void>
+struct serializer;
+
+template <typename T>
+struct serializer<T, std::enable_if_t<detail::is_raw_v<T>>> {
+  template <typename Writer>
+  static void save(Writer &out, const T &value) {
+    out.write(&value, sizeof(T));
+  }
+
+  template <typename Reader>
+  static T load(Reader &in) {
+    T value;
+    in.read(&value, sizeof(T));
+    return value;
+  }
+};
+
+template <>
+struct serializer<std::string> {
+  template <typename Writer>
+  static void save(Writer &out, const std::string &value) {
+    std::uint64_t size = value.size();
+    out.write(&size, sizeof(size));
+    out.write(value.data(), value.size());
+  }
+
+  template <typename Reader>
+  static std::string load(Reader &in) {
+    std::uint64_t size;
+    in.read(&size, sizeof(size));
+    std::string value;
+    // строка растет порциями, чтобы испорченная длина не требовала сразу
+    // гигантского блока памяти
+    while (size > 0) {
+      char part[4096];
+      std::size_t step = size < sizeof(part) ? std::size_t(size) : sizeof(part);
+      in.read(part, step);
+      value.append(part, step);
+      size -= step;
+    }
+    return value;
+  }
+};
+
+// Пара читается с неконстантным first, из нее строится узел map
+template <typename A, typename B>
+struct serializer<std::pair<A, B>> {
+  using first_type = std::remove_const_t<A>;
+
+  template <typename Writer>
+  static void save(Writer &out, const std::pair<A, B> &value) {
+    serializer<first_type>::save(out, value.first);
+    serializer<B>::save(out, value.second);
+  }
+
+  template <typename Reader>
+  static std::pair<first_type, B> load(Reader &in) {
+    first_type first = serializer<first_type>::load(in);
+    return {std::move(first), serializer<B>::load(in)};
+  }
+};
+
+// Вложенные контейнеры пишутся со своим заголовком
+template <typename C>
+struct serializer<C, std::enable_if_t<detail::container_kind<C>::value != 0>> {
+  template <typename Writer>
+  static void save(Writer &out, const C &value) {
+    detail::save_nested(out, value);
+  }
+
+  template <typename Reader>
+  static C load(Reader &in) {
+    C value;
+    detail::load_nested(in, value);
+    return value;
+  }
+};
+
+// Доступ к спискам внутри адаптеров
+template <typename T>
+struct serialize_access<stack<T>> {
+  static const list<T> &items(const stack<T> &s) noexcept { return s.list_; }
+  static list<T> &items(stack<T> &s) noexcept { return s.list_; }
+};
+
+template <typename T>
+struct serialize_access<queue<T>> {
+  static const list<T> &items(const queue<T> &q) noexcept { return q.list; }
+  static list<T> &items(queue<T> &q) noexcept { return q.list; }
+};
+
+namespace detail {
+
+// Больше заранее не резервируется, чтобы испорченный счетчик не требовал
+// сразу гигантского блока
+constexpr std::uint64_t kLoadReserveLimit = std::uint64_t(1) << 16;
+
+// Тип элемента по итератору: у деревьев value_type закрыт
+template <typename C>
+using element_t = std::decay_t<decltype(*std::declval<const C &>().begin())>;
+
+template <typename Writer, typename C>
+void save_range(Writer &out, std::uint8_t kind, const C &items) {
+  using value_type = element_t<C>;
+  write_header<Writer, value_type>(out, kind, items.size());
+  for (const auto &item : items) serializer<value_type>::save(out, item);
+}
+
+template <typename Reader, typename = void>
+struct has_remaining : std::false_type {};
+template <typename Reader>
+struct has_remaining<
+    Reader, std::void_t<decltype(std::declval<const Reader &>().remaining())>>
+    : std::true_type {};
+
+// Читает count сырых элементов. Счетчик из потока проверяется на
+// переполнение и, если читатель знает остаток, на длину потока, после чего
+// вектор выделяется один раз. Иначе вектор растет вдвое по мере прихода
+// данных, начиная с kLoadReserveLimit элементов, и испорченный счетчик
+// упирается в конец потока раньше, чем в память
+template <typename Reader, typename T>
+void load_raw(Reader &in, std::uint64_t count, vector<T> &loaded) {
+  if (count > std::uint64_t(std::size_t(-1) / sizeof(T))) {
+    throw std::runtime_error("serialize: element count is too large");
+  }
+  if constexpr (has_remaining<Reader>::value) {
+    if (count > in.remaining() / sizeof(T)) {
+      throw std::runtime_error("serialize: unexpected end of stream");
+    }
+    vector<T> exact(static_cast<std::size_t>(count));
+    in.read(exact.data(), exact.size() * sizeof(T));
+    loaded.swap(exact);
+    return;
+  }
+  std::size_t done = 0;
+  while (done < count) {
+    std::size_t target = done * 2 > kLoadReserveLimit
+                             ? done * 2
+                             : std::size_t(kLoadReserveLimit);
+    if (target > count) target = std::size_t(count);
+    vector<T> grown(target);
+    if (done != 0) std::memcpy(grown.data(), loaded.data(), done * sizeof(T));
+    in.read(grown.data() + done, (target - done) * sizeof(T));
+    loaded.swap(grown);
+    done = target;
+  }
+}
+
+template <typename Reader, typename T>
+void load_list(Reader &in, std::uint8_t kind, list<T> &items) {
+  std::uint64_t count = read_header<Reader, T>(in, kind);
+  list<T> loaded;
+  for (std::uint64_t i = 0; i < count; ++i) {
+    loaded.push_back(serializer<T>::load(in));
+  }
+  items.swap(loaded);
+}
+
+template <typename Reader, typename Tree>
+void load_tree(Reader &in, Tree &tree) {
+  using value_type = element_t<Tree>;
+  std::uint64_t count =
+      read_header<Reader, value_type>(in, kind_v<Tree>);
+  Tree loaded;
+  try {
+    loaded.assign_sorted(count,
+                         [&in] { return serializer<value_type>::load(in); });
+  } catch (const std::invalid_argument &) {
+    throw std::runtime_error("serialize: tree elements are out of order");
+  }
+  tree.swap(loaded);
+}
+
+}  // namespace detail
+
+// Save
+
+template <typename Writer, typename T>
+void save(Writer &out, const vector<T> &items) {
+  if constexpr (detail::is_raw_v<T>) {
+    detail::write_header<Writer, T>(out, detail::kind_v<vector<T>>,
+                                    items.size());
+    out.write(items.data(), items.size() * sizeof(T));
+  } else {
+    detail::save_range(out, detail::kind_v<vector<T>>, items);
+  }
+}
+
+template <typename Writer, typename T, std::size_t N>
+void save(Writer &out, const array<T, N> &items) {
+  if constexpr (detail::is_raw_v<T>) {
+    detail::write_header<Writer, T>(out, detail::kind_v<array<T, N>>, N);
+    out.write(items.data(), N * sizeof(T));
+  } else {
+    detail::save_range(out, detail::kind_v<array<T, N>>, items);
+  }
+}
+
+template <typename Writer, typename T>
+void save(Writer &out, const list<T> &items) {
+  detail::save_range(out, detail::kind_v<list<T>>, items);
+}
+
+template <typename Writer, typename K>
+void save(Writer &out, const set<K> &items) {
+  detail::save_range(out, detail::kind_v<set<K>>, items);
+}
+
+template <typename Writer, typename K>
+void save(Writer &out, const multiset<K> &items) {
+  detail::save_range(out, detail::kind_v<multiset<K>>, items);
+}
+
+template <typename Writer, typename K, typename V>
+void save(Writer &out, const map<K, V> &items) {
+  detail::save_range(out, detail::kind_v<map<K, V>>, items);
+}
+
+// Адаптеры пишутся от дна к вершине, от головы к хвосту
+template <typename Writer, typename T>
+void save(Writer &out, const stack<T> &items) {
+  detail::save_range(out, detail::kind_v<stack<T>>,
+                     serialize_access<stack<T>>::items(items));
+}
+
+template <typename Writer, typename T>
+void save(Writer &out, const queue<T> &items) {
+  detail::save_range(out, detail::kind_v<queue<T>>,
+                     serialize_access<queue<T>>::items(items));
+}
+
+// Load
+
+template <typename Reader, typename T>
+void load(Reader &in, vector<T> &items) {
+  std::uint64_t count =
+      detail::read_header<Reader, T>(in, detail::kind_v<vector<T>>);
+  vector<T> loaded;
+  if constexpr (detail::is_raw_v<T>) {
+    detail::load_raw(in, count, loaded);
+  } else {
+    loaded.reserve(count < detail::kLoadReserveLimit ? count
+                                                 : detail::kLoadReserveLimit);
+    for (std::uint64_t i = 0; i < count; ++i) {
+      loaded.push_back(serializer<T>::load(in));
+    }
+  }
+  items.swap(loaded);
+}
+
+template <typename Reader, typename T, std::size_t N>
+void load(Reader &in, array<T, N> &items) {
+  if (detail::read_header<Reader, T>(in, detail::kind_v<array<T, N>>) != N) {
+    throw std::runtime_error("serialize: array size mismatch");
+  }
+  array<T, N> loaded;
+  if constexpr (detail::is_raw_v<T>) {
+    in.read(loaded.data(), N * sizeof(T));
+  } else {
+    for (std::size_t i = 0; i < N; ++i) loaded[i] = serializer<T>::load(in);
+  }
+  items.swap(loaded);
+}
+
+template <typename Reader, typename T>
+void load(Reader &in, list<T> &items) {
+  detail::load_list(in, detail::kind_v<list<T>>, items);
+}
+
+template <typename Reader, typename K>
+void load(Reader &in, set<K> &items) {
+  detail::load_tree(in, items);
+}
+
+template <typename Reader, typename K>
+void load(Reader &in, multiset<K> &items) {
+  detail::load_tree(in, items);
+}
+
+template <typename Reader, typename K, typename V>
+void load(Reader &in, map<K, V> &items) {
+  detail::load_tree(in, items);
+}
+
+template <typename Reader, typename T>
+void load(Reader &in, stack<T> &items) {
+  detail::load_list(in, detail::kind_v<stack<T>>,
+                    serialize_access<stack<T>>::items(items));
+}
+
+template <typename Reader, typename T>
+void load(Reader &in, queue<T> &items) {
+  detail::load_list(in, detail::kind_v<queue<T>>,
+                    serialize_access<queue<T>>::items(items));
+}
+
+namespace detail {
+template <typename Writer, typename C>
+void save_nested(Writer &out, const C &value) {
+  save(out, value);
+}
+
+template <typename Reader, typename C>
+void load_nested(Reader &in, C &value) {
+  load(in, value);
+}
+}  // namespace detail
+
+}  // namespace s21
+
+#endif
@@ -16,6 +16,13 @@
 */
 
 namespace s21 {
+template <typename Key>
+class set;
+
+// Удаляет из множества все элементы, удовлетворяющие предикату
+template <typename Key, typename Pred>
+std::size_t erase_if(set<Key>& container, Pred pred);
+
 template <typename Key>
 class set {
   using key_type = Key;
@@ -28,9 +35,11 @@ class set {
  public:
   using iterator = typename tree::iterator;
   using const_iterator = typename tree::const_iterator;
+  using node_type = typename tree::node_type;
+  using insert_return_type = typename tree::insert_return_type;
 
   // Конструктор по умолчанию, создает пустое множество
-  set() : tree_() {};
+  set() noexcept : tree_() {};
 
   // Конструктор списка инициализации, создает множество, инициализированное с
   // помощью std::initializer_list
@@ -44,7 +53,7 @@ class set {
   set(const set& s) : tree_(s.tree_) {};
 
   // Конструктор перемещения
-  set(set&& s) : tree_(std::move(s.tree_)) {};
+  set(set&& s) noexcept : tree_(std::move(s.tree_)) {};
 
   // Деструктор
   ~set() = default;
@@ -56,7 +65,7 @@ class set {
   };
 
   // Перегрузка оператора присваивания для перемещения объекта
-  set& operator=(set&& other) {
+  set& operator=(set&& other) noexcept {
     tree_ = std::move(other.tree_);
     return *this;
   }
@@ -67,9 +76,40 @@ class set {
     return tree_.insert(key);
   };
 
+  // Создает элемент из аргументов прямо в узле дерева и вставляет его,
+  // если такого элемента еще нет
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) {
+    return tree_.emplace(std::forward<Args>(args)...);
+  };
+
+  // То же, что emplace, но вставка начинается с позиции перед hint
+  template <typename... Args>
+  iterator emplace_hint(const_iterator hint, Args&&... args) {
+    return tree_.emplace_hint(hint, std::forward<Args>(args)...);
+  };
+
+  // Вставляет извлеченный узел без выделения памяти и копирования
+  insert_return_type insert(node_type&& nh) {
+    return tree_.insert(std::move(nh));
+  };
+
   // Удаляет элемент в позиции pos
   void erase(iterator pos) { tree_.erase(pos); };
 
+  // Удаляет элементы в диапазоне [first, last)
+  iterator erase(const_iterator first, const_iterator last) {
+    return tree_.erase(first, last);
+  };
+
+  // Извлекает узел в позиции pos, не освобождая его
+  node_type extract(const_iterator pos) noexcept { return tree_.extract(pos); };
+
+  // Извлекает узел с ключом, если он есть
+  node_type extract(const key_type& key) noexcept {
+    return tree_.extract_key(key);
+  };
+
   // Проверяет, пуст ли контейнер
   bool empty() const noexcept { return tree_.empty(); };
 
@@ -83,7 +123,7 @@ class set {
   void clear() { tree_.clear(); };
 
   // Меняет содержимое местами
-  void swap(set& other) { tree_.swap(other.tree_); };
+  void swap(set& other) noexcept { tree_.swap(other.tree_); };
 
   // Присоединяет узлы из другого контейнера
   void merge(set& other) noexcept { tree_.merge(other.tree_); };
@@ -109,6 +149,19 @@ class set {
   // Возвращает итератор в конец для константного множества
   const_iterator end() const noexcept { return tree_.end(); };
 
+  // Заменяет содержимое count элементами от next() в строго возрастающем
+  // порядке и строит дерево за O(n). Нарушение порядка - std::invalid_argument
+  template <typename Next>
+  void assign_sorted(size_type count, Next next) {
+    tree_.assign_sorted(count, next, true);
+  };
+
+  // Делит контейнер на примерно равные диапазоны по поддеревьям,
+  // возвращает их границы от begin() до end()
+  std::vector<const_iterator> split(size_type parts) const {
+    return tree_.split(parts);
+  };
+
   // Вставляет новые элементы в контейнер
   template <typename... Args>
   std::vector<std::pair<iterator, bool>> insert_many(Args&&... args) {
@@ -116,9 +169,17 @@ class set {
   };
 
  private:
+  template <typename K, typename Pred>
+  friend std::size_t erase_if(set<K>& container, Pred pred);
+
   // Переменная красно-черного дерева
   tree tree_;
 };
+
+template <typename Key, typename Pred>
+std::size_t erase_if(set<Key>& container, Pred pred) {
+  return container.tree_.erase_if(pred);
+}
 }  // namespace s21
 
 #endif  // SRC_S21_SET_H_
@@ -0,0 +1,1107 @@
+#ifndef S21_SHM_H_
+#define S21_SHM_H_
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#if defined(__linux__) || defined(__FreeBSD__)
+#define S21_SHM_ROBUST 1
+#else
+#define S21_SHM_ROBUST 0
+#endif
+
+/*
+    Контейнеры в разделяемой памяти
+    shm_segment создает или открывает именованный сегмент (shm_open + mmap),
+   который каждый процесс может отобразить по своему адресу. Поэтому внутри
+   сегмента нет обычных указателей: offset_ptr хранит смещение от самого
+   себя и остается верным при любом адресе отображения. shm_list, shm_set и
+   shm_map устроены как list, set и map, но их узлы связаны через offset_ptr
+   и выделяются распределителем сегмента. Контейнеры создаются в сегменте по
+   имени через find_or_construct, и другие процессы находят их по тому же
+   имени. Сегмент - разделяемый мьютекс между процессами: читатели берут
+   std::shared_lock, писатели std::unique_lock, сами контейнеры не
+   блокируются. Элементы должны быть тривиально копируемыми, чтобы не
+   ссылаться на память одного процесса. Мьютекс распределителя на Linux и
+   FreeBSD устойчивый (robust): если процесс упал, держа его, следующий
+   владелец продолжает работу, теряя разве что блок, который выделялся в
+   момент падения. У pthread_rwlock такого режима нет, поэтому процесс,
+   упавший под блокировкой сегмента, оставляет ее занятой навсегда, и
+   сегмент приходится удалить и создать заново. Так же навсегда остается
+   недостроенным объект, создатель которого упал в конструкторе.
+*/
+
+namespace s21 {
+
+// Указатель, хранящий смещение от собственного адреса. Копирование
+// пересчитывает смещение, поэтому offset_ptr можно свободно присваивать
+// внутри сегмента
+template <typename T>
+class offset_ptr {
+ public:
+  using element_type = T;
+
+  offset_ptr() noexcept : offset_(kNull) {}
+  offset_ptr(T *ptr) noexcept { set(ptr); }
+  offset_ptr(const offset_ptr &other) noexcept { set(other.get()); }
+
+  offset_ptr &operator=(const offset_ptr &other) noexcept {
+    set(other.get());
+    return *this;
+  }
+  offset_ptr &operator=(T *ptr) noexcept {
+    set(ptr);
+    return *this;
+  }
+
+  T *get() const noexcept {
+    if (offset_ == kNull) return nullptr;
+    return reinterpret_cast<T *>(
+        reinterpret_cast<std::uintptr_t>(this) + std::uintptr_t(offset_));
+  }
+
+  T &operator*() const noexcept { return *get(); }
+  T *operator->() const noexcept { return get(); }
+  explicit operator bool() const noexcept { return offset_ != kNull; }
+
+  friend bool operator==(const offset_ptr &a, const offset_ptr &b) noexcept {
+    return a.get() == b.get();
+  }
+  friend bool operator!=(const offset_ptr &a, const offset_ptr &b) noexcept {
+    return a.get() != b.get();
+  }
+
+ private:
+  // Смещение 1 невозможно для выровненного объекта и означает nullptr
+  static constexpr std::ptrdiff_t kNull = 1;
+
+  std::ptrdiff_t offset_;
+
+  void set(T *ptr) noexcept {
+    offset_ = ptr == nullptr
+                  ? kNull
+                  : std::ptrdiff_t(reinterpret_cast<std::uintptr_t>(ptr) -
+                                   reinterpret_cast<std::uintptr_t>(this));
+  }
+};
+
+// Режим открытия сегмента
+enum class shm_mode {
+  create,         // создать новый, существующий сегмент - ошибка
+  open,           // открыть существующий
+  open_or_create  // открыть, а если его нет - создать
+};
+
+namespace detail {
+
+// Заголовок сегмента. Смещения считаются от начала сегмента, 0 - пусто
+struct shm_header {
+  static constexpr std::size_t kClasses = 64;
+  static constexpr std::size_t kObjects = 32;
+  static constexpr std::size_t kNameBytes = 48;
+
+  char magic[8];
+  std::uint32_t version;
+  std::atomic<std::uint32_t> ready;
+  std::uint64_t size;
+  pthread_rwlock_t lock;
+  pthread_mutex_t alloc_mutex;
+  // Первый ни разу не выданный байт
+  std::uint64_t bump;
+  std::uint64_t used;
+  // Свободные блоки по классам размера 16, 32, ..., 1024 байт
+  std::uint64_t free_lists[kClasses];
+  // Свободные блоки крупнее, первый подходящий
+  std::uint64_t large_free;
+  struct object {
+    char name[kNameBytes];
+    std::uint64_t offset;
+    // pid процесса, который еще строит объект, 0 - объект готов. Пока
+    // объект строится, find его не видит
+    std::uint64_t constructing;
+  } objects[kObjects];
+};
+
+// Блоку предшествует размер, у свободного блока в начале лежит смещение
+// следующего свободного
+constexpr std::size_t kShmBlockHeader = 16;
+constexpr std::size_t kShmGranule = 16;
+
+inline char *shm_base(shm_header *head) noexcept {
+  return reinterpret_cast<char *>(head);
+}
+
+inline std::uint64_t &shm_block_size(char *payload) noexcept {
+  return *reinterpret_cast<std::uint64_t *>(payload - kShmBlockHeader);
+}
+
+inline std::uint64_t &shm_next_free(char *payload) noexcept {
+  return *reinterpret_cast<std::uint64_t *>(payload);
+}
+
+class shm_alloc_guard {
+ public:
+  explicit shm_alloc_guard(shm_header *head) noexcept : head_(head) {
+    int error = pthread_mutex_lock(&head_->alloc_mutex);
+#if S21_SHM_ROBUST
+    // владелец упал: списки блоков меняются короткими шагами и остаются
+    // связными, теряется не больше одного блока
+    if (error == EOWNERDEAD) pthread_mutex_consistent(&head_->alloc_mutex);
+#else
+    (void)error;
+#endif
+  }
+  ~shm_alloc_guard() { pthread_mutex_unlock(&head_->alloc_mutex); }
+  shm_alloc_guard(const shm_alloc_guard &) = delete;
+  shm_alloc_guard &operator=(const shm_alloc_guard &) = delete;
+
+ private:
+  shm_header *head_;
+};
+
+// Выделяет bytes байт в сегменте, при нехватке места std::bad_alloc.
+// Мелкие блоки берутся из списков своего класса, крупные - первым
+// подходящим из общего списка, иначе отрезаются от свободного хвоста
+inline void *shm_allocate_locked(shm_header *head, std::size_t bytes) {
+  std::uint64_t size =
+      (bytes + kShmGranule - 1) / kShmGranule * kShmGranule;
+  if (size == 0) size = kShmGranule;
+  char *base = shm_base(head);
+  std::size_t cls = size / kShmGranule - 1;
+  if (cls < shm_header::kClasses && head->free_lists[cls] != 0) {
+    char *payload = base + head->free_lists[cls];
+    head->free_lists[cls] = shm_next_free(payload);
+    head->used += size;
+    return payload;
+  }
+  if (cls >= shm_header::kClasses) {
+    std::uint64_t *link = &head->large_free;
+    while (*link != 0) {
+      char *payload = base + *link;
+      if (shm_block_size(payload) >= size) {
+        *link = shm_next_free(payload);
+        head->used += shm_block_size(payload);
+        return payload;
+      }
+      link = &shm_next_free(payload);
+    }
+  }
+  if (head->bump + kShmBlockHeader + size > head->size) throw std::bad_alloc();
+  char *payload = base + head->bump + kShmBlockHeader;
+  head->bump += kShmBlockHeader + size;
+  shm_block_size(payload) = size;
+  head->used += size;
+  return payload;
+}
+
+inline void shm_deallocate_locked(shm_header *head, void *ptr) noexcept {
+  if (ptr == nullptr) return;
+  char *payload = static_cast<char *>(ptr);
+  std::uint64_t size = shm_block_size(payload);
+  std::uint64_t offset = std::uint64_t(payload - shm_base(head));
+  std::size_t cls = size / kShmGranule - 1;
+  std::uint64_t *list = cls < shm_header::kClasses ? &head->free_lists[cls]
+                                                   : &head->large_free;
+  shm_next_free(payload) = *list;
+  *list = offset;
+  head->used -= size;
+}
+
+inline void *shm_allocate(shm_header *head, std::size_t bytes) {
+  shm_alloc_guard guard(head);
+  return shm_allocate_locked(head, bytes);
+}
+
+inline void shm_deallocate(shm_header *head, void *ptr) noexcept {
+  shm_alloc_guard guard(head);
+  shm_deallocate_locked(head, ptr);
+}
+
+// Выделяет узел в сегменте и создает его на месте
+template <typename T, typename... Args>
+T *shm_new_node(shm_header *head, Args &&...args) {
+  void *memory = shm_allocate(head, sizeof(T));
+  return new (memory) T(std::forward<Args>(args)...);
+}
+
+}  // namespace detail
+
+// Именованный сегмент разделяемой памяти. Объект сегмента принадлежит
+// процессу: деструктор снимает отображение, а сам сегмент живет, пока его
+// не удалит remove
+class shm_segment {
+ public:
+  using size_type = std::size_t;
+
+  // Открывает или создает сегмент name размером bytes. Размер важен только
+  // при создании, у открытого сегмента он берется из заголовка
+  shm_segment(const std::string &name, size_type bytes,
+              shm_mode mode = shm_mode::open_or_create)
+      : name_(name), head_(nullptr), bytes_(0) {
+    bool created = false;
+    int fd = -1;
+    if (mode != shm_mode::open) {
+      fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+      if (fd >= 0) created = true;
+      if (fd < 0 && (errno != EEXIST || mode == shm_mode::create)) {
+        throw_errno("shm_segment: cannot create " + name);
+      }
+    }
+    if (fd < 0) {
+      fd = shm_open(name.c_str(), O_RDWR, 0600);
+      if (fd < 0) throw_errno("shm_segment: cannot open " + name);
+    }
+    try {
+      if (created) {
+        if (bytes < kMinBytes) bytes = kMinBytes;
+        if (ftruncate(fd, off_t(bytes)) != 0) {
+          throw_errno("shm_segment: ftruncate failed");
+        }
+      } else {
+        bytes = wait_for_size(fd);
+      }
+      map(fd, bytes);
+      if (created) {
+        initialize();
+      } else {
+        attach();
+      }
+    } catch (...) {
+      ::close(fd);
+      if (head_ != nullptr) munmap(head_, bytes_);
+      if (created) shm_unlink(name.c_str());
+      throw;
+    }
+    ::close(fd);
+  }
+
+  shm_segment(const shm_segment &) = delete;
+  shm_segment &operator=(const shm_segment &) = delete;
+
+  ~shm_segment() {
+    if (head_ != nullptr) munmap(head_, bytes_);
+  }
+
+  // Удаляет имя сегмента, уже отображенные копии продолжают работать
+  static bool remove(const std::string &name) noexcept {
+    return shm_unlink(name.c_str()) == 0;
+  }
+
+  const std::string &name() const noexcept { return name_; }
+  size_type size() const noexcept { return bytes_; }
+
+  // Сколько байт занято блоками и сколько еще ни разу не выдавалось
+  size_type used_bytes() const noexcept {
+    detail::shm_alloc_guard guard(head_);
+    return size_type(head_->used);
+  }
+  size_type free_bytes() const noexcept {
+    detail::shm_alloc_guard guard(head_);
+    return size_type(head_->size - head_->bump);
+  }
+
+  // Находит объект name или создает его конструктором C(segment, args...).
+  // Имя и память занимаются под мьютексом распределителя, а конструктор
+  // работает без него и может сам выделять память в сегменте. Пока объект
+  // строится, другие вызовы с тем же именем ждут. Если строивший процесс
+  // умер, имя занимается заново, а память, которую успел выделить его
+  // конструктор, теряется. Умершим считается процесс, которого уже нет
+  // даже зомби, поэтому родитель должен его дождаться
+  template <typename C, typename... Args>
+  C &find_or_construct(const char *name, Args &&...args) {
+    detail::shm_header::object *slot = nullptr;
+    void *memory = nullptr;
+    while (slot == nullptr) {
+      {
+        detail::shm_alloc_guard guard(head_);
+        detail::shm_header::object *found = find_slot(name);
+        if (found == nullptr) {
+          slot = free_slot(name);
+          memory = detail::shm_allocate_locked(head_, sizeof(C));
+          std::strncpy(slot->name, name, sizeof(slot->name) - 1);
+          slot->offset = std::uint64_t(static_cast<char *>(memory) -
+                                       detail::shm_base(head_));
+          slot->constructing = std::uint64_t(getpid());
+        } else if (found->constructing == 0) {
+          return *reinterpret_cast<C *>(detail::shm_base(head_) +
+                                        found->offset);
+        } else if (kill(pid_t(found->constructing), 0) == -1 &&
+                   errno == ESRCH) {
+          // строивший процесс умер, не закончив
+          char *orphan = detail::shm_base(head_) + found->offset;
+          release_slot(*found);
+          detail::shm_deallocate_locked(head_, orphan);
+          continue;
+        }
+      }
+      if (slot == nullptr) std::this_thread::yield();
+    }
+    C *object;
+    try {
+      object = new (memory) C(*this, std::forward<Args>(args)...);
+    } catch (...) {
+      detail::shm_alloc_guard guard(head_);
+      release_slot(*slot);
+      detail::shm_deallocate_locked(head_, memory);
+      throw;
+    }
+    detail::shm_alloc_guard guard(head_);
+    slot->constructing = 0;
+    return *object;
+  }
+
+  // Находит объект name, nullptr если его нет
+  template <typename C>
+  C *find(const char *name) {
+    detail::shm_alloc_guard guard(head_);
+    return find_locked<C>(name);
+  }
+
+  // Разрушает объект name и освобождает его память
+  template <typename C>
+  bool destroy(const char *name) {
+    C *object = find<C>(name);
+    if (object == nullptr) return false;
+    object->~C();
+    detail::shm_alloc_guard guard(head_);
+    if (detail::shm_header::object *slot = find_slot(name)) {
+      release_slot(*slot);
+    }
+    detail::shm_deallocate_locked(head_, object);
+    return true;
+  }
+
+  // Блокировка чтения и записи между процессами, подходит для
+  // std::unique_lock и std::shared_lock
+  void lock() { pthread_rwlock_wrlock(&head_->lock); }
+  bool try_lock() { return pthread_rwlock_trywrlock(&head_->lock) == 0; }
+  void unlock() { pthread_rwlock_unlock(&head_->lock); }
+  void lock_shared() { pthread_rwlock_rdlock(&head_->lock); }
+  bool try_lock_shared() { return pthread_rwlock_tryrdlock(&head_->lock) == 0; }
+  void unlock_shared() { pthread_rwlock_unlock(&head_->lock); }
+
+  detail::shm_header *header() const noexcept { return head_; }
+
+ private:
+  static constexpr char kMagic[8] = {'S', '2', '1', 'S', 'H', 'M', '\0', '\0'};
+  static constexpr std::uint32_t kVersion = 3;
+  static constexpr size_type kMinBytes = size_type(64) << 10;
+
+  std::string name_;
+  detail::shm_header *head_;
+  size_type bytes_;
+
+  [[noreturn]] static void throw_errno(const std::string &what) {
+    throw std::system_error(errno, std::generic_category(), what);
+  }
+
+  // Создатель мог еще не задать размер сегмента
+  static size_type wait_for_size(int fd) {
+    for (int attempt = 0; attempt < 10000; ++attempt) {
+      struct stat st;
+      if (fstat(fd, &st) != 0) throw_errno("shm_segment: fstat failed");
+      if (size_type(st.st_size) >= sizeof(detail::shm_header)) {
+        return size_type(st.st_size);
+      }
+      std::this_thread::yield();
+    }
+    throw std::runtime_error("shm_segment: segment is not initialized");
+  }
+
+  void map(int fd, size_type bytes) {
+    void *pages =
+        mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (pages == MAP_FAILED) throw_errno("shm_segment: mmap failed");
+    head_ = static_cast<detail::shm_header *>(pages);
+    bytes_ = bytes;
+  }
+
+  void initialize() {
+    // новый сегмент заполнен нулями
+    std::memcpy(head_->magic, kMagic, sizeof(kMagic));
+    head_->version = kVersion;
+    head_->size = bytes_;
+    head_->bump = (sizeof(detail::shm_header) + detail::kShmGranule - 1) /
+                  detail::kShmGranule * detail::kShmGranule;
+    pthread_rwlockattr_t lock_attr;
+    pthread_rwlockattr_init(&lock_attr);
+    pthread_rwlockattr_setpshared(&lock_attr, PTHREAD_PROCESS_SHARED);
+    pthread_rwlock_init(&head_->lock, &lock_attr);
+    pthread_rwlockattr_destroy(&lock_attr);
+    pthread_mutexattr_t mutex_attr;
+    pthread_mutexattr_init(&mutex_attr);
+    pthread_mutexattr_setpshared(&mutex_attr, PTHREAD_PROCESS_SHARED);
+#if S21_SHM_ROBUST
+    pthread_mutexattr_setrobust(&mutex_attr, PTHREAD_MUTEX_ROBUST);
+#endif
+    pthread_mutex_init(&head_->alloc_mutex, &mutex_attr);
+    pthread_mutexattr_destroy(&mutex_attr);
+    head_->ready.store(1, std::memory_order_release);
+  }
+
+  // Ждет, пока создатель закончит инициализацию
+  void attach() {
+    for (int attempt = 0; attempt < 100000; ++attempt) {
+      if (head_->ready.load(std::memory_order_acquire) == 1) {
+        if (std::memcmp(head_->magic, kMagic, sizeof(kMagic)) != 0 ||
+            head_->version != kVersion || head_->size != bytes_) {
+          throw std::runtime_error("shm_segment: not an s21 segment");
+        }
+        return;
+      }
+      std::this_thread::yield();
+    }
+    throw std::runtime_error("shm_segment: segment is not initialized");
+  }
+
+  template <typename C>
+  C *find_locked(const char *name) {
+    detail::shm_header::object *slot = find_slot(name);
+    if (slot == nullptr || slot->constructing != 0) return nullptr;
+    return reinterpret_cast<C *>(detail::shm_base(head_) + slot->offset);
+  }
+
+  detail::shm_header::object *find_slot(const char *name) {
+    for (auto &slot : head_->objects) {
+      if (slot.offset != 0 && std::strcmp(slot.name, name) == 0) return &slot;
+    }
+    return nullptr;
+  }
+
+  static void release_slot(detail::shm_header::object &slot) noexcept {
+    slot.offset = 0;
+    slot.constructing = 0;
+    slot.name[0] = '\0';
+  }
+
+  detail::shm_header::object *free_slot(const char *name) {
+    if (std::strlen(name) >= detail::shm_header::kNameBytes) {
+      throw std::length_error("shm_segment: object name is too long");
+    }
+    for (auto &slot : head_->objects) {
+      if (slot.offset == 0) return &slot;
+    }
+    throw std::length_error("shm_segment: too many named objects");
+  }
+};
+
+// Двусвязный список в сегменте
+template <typename T>
+class shm_list {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "shm containers store only trivially copyable types");
+
+  // Ссылки узла, ограничитель кольца состоит только из них
+  struct link {
+    offset_ptr<link> prev;
+    offset_ptr<link> next;
+  };
+
+  struct node : link {
+    explicit node(const T &item) : value(item) {}
+    T value;
+  };
+
+ public:
+  using value_type = T;
+  using reference = T &;
+  using const_reference = const T &;
+  using size_type = std::size_t;
+
+  template <typename Value>
+  class basic_iterator {
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = Value *;
+    using reference = Value &;
+
+    basic_iterator() noexcept : link_(nullptr) {}
+    explicit basic_iterator(link *current) noexcept : link_(current) {}
+    // неконстантный итератор приводится к константному
+    operator basic_iterator<const T>() const noexcept {
+      return basic_iterator<const T>(link_);
+    }
+
+    reference operator*() const noexcept {
+      return static_cast<node *>(link_)->value;
+    }
+    pointer operator->() const noexcept {
+      return &static_cast<node *>(link_)->value;
+    }
+    basic_iterator &operator++() noexcept {
+      link_ = link_->next.get();
+      return *this;
+    }
+    basic_iterator operator++(int) noexcept {
+      basic_iterator old = *this;
+      ++*this;
+      return old;
+    }
+    basic_iterator &operator--() noexcept {
+      link_ = link_->prev.get();
+      return *this;
+    }
+    basic_iterator operator--(int) noexcept {
+      basic_iterator old = *this;
+      --*this;
+      return old;
+    }
+    bool operator==(const basic_iterator &other) const noexcept {
+      return link_ == other.link_;
+    }
+    bool operator!=(const basic_iterator &other) const noexcept {
+      return link_ != other.link_;
+    }
+
+   private:
+    friend class shm_list;
+    link *link_;
+  };
+
+  using iterator = basic_iterator<T>;
+  using const_iterator = basic_iterator<const T>;
+
+  // Пустой список, узлы которого выделяются в segment
+  explicit shm_list(shm_segment &segment) noexcept
+      : head_(segment.header()), size_(0) {
+    sentinel_.prev = &sentinel_;
+    sentinel_.next = &sentinel_;
+  }
+
+  shm_list(const shm_list &) = delete;
+  shm_list &operator=(const shm_list &) = delete;
+
+  ~shm_list() { clear(); }
+
+  reference front() { return checked_node(sentinel_.next.get())->value; }
+  const_reference front() const {
+    return checked_node(sentinel_.next.get())->value;
+  }
+  reference back() { return checked_node(sentinel_.prev.get())->value; }
+  const_reference back() const {
+    return checked_node(sentinel_.prev.get())->value;
+  }
+
+  iterator begin() noexcept { return iterator(sentinel_.next.get()); }
+  iterator end() noexcept { return iterator(&sentinel_); }
+  const_iterator begin() const noexcept {
+    return const_iterator(sentinel_.next.get());
+  }
+  const_iterator end() const noexcept { return const_iterator(sentinel()); }
+
+  bool empty() const noexcept { return size_ == 0; }
+  size_type size() const noexcept { return size_; }
+
+  // Вставляет value перед pos
+  iterator insert(const_iterator pos, const_reference value) {
+    link *next = pos.link_;
+    node *created = detail::shm_new_node<node>(head_.get(), value);
+    created->next = next;
+    created->prev = next->prev;
+    next->prev->next = created;
+    next->prev = created;
+    ++size_;
+    return iterator(created);
+  }
+
+  // Удаляет элемент pos и возвращает итератор на следующий
+  iterator erase(const_iterator pos) {
+    link *current = pos.link_;
+    if (current == sentinel()) {
+      throw std::out_of_range("The end() cannot be erased");
+    }
+    link *next = current->next.get();
+    current->prev->next = next;
+    next->prev = current->prev;
+    detail::shm_deallocate(head_.get(), static_cast<node *>(current));
+    --size_;
+    return iterator(next);
+  }
+
+  void push_back(const_reference value) { insert(end(), value); }
+  void push_front(const_reference value) { insert(begin(), value); }
+  void pop_back() { erase(const_iterator(checked_node(sentinel_.prev.get()))); }
+  void pop_front() {
+    erase(const_iterator(checked_node(sentinel_.next.get())));
+  }
+
+  void clear() noexcept {
+    link *current = sentinel_.next.get();
+    while (current != &sentinel_) {
+      link *next = current->next.get();
+      detail::shm_deallocate(head_.get(), static_cast<node *>(current));
+      current = next;
+    }
+    sentinel_.prev = &sentinel_;
+    sentinel_.next = &sentinel_;
+    size_ = 0;
+  }
+
+ private:
+  offset_ptr<detail::shm_header> head_;
+  link sentinel_;
+  size_type size_;
+
+  link *sentinel() const noexcept { return const_cast<link *>(&sentinel_); }
+
+  node *checked_node(link *current) const {
+    if (current == sentinel()) throw std::out_of_range("The list is empty");
+    return static_cast<node *>(current);
+  }
+};
+
+namespace detail {
+
+template <typename Key>
+struct shm_set_traits {
+  using value_type = Key;
+  static const Key &key(const value_type &value) noexcept { return value; }
+};
+
+template <typename Key, typename T>
+struct shm_map_traits {
+  using value_type = std::pair<const Key, T>;
+  static const Key &key(const value_type &value) noexcept {
+    return value.first;
+  }
+};
+
+// Левостороннее красно-черное дерево в сегменте. Кроме детей узлы хранят
+// соседей по порядку ключей: повороты их не меняют, поэтому список
+// правится только при вставке и удалении, а переход к следующему элементу
+// занимает O(1). RBTree здесь не подходит: его узлы живут в куче процесса и
+// связаны обычными указателями
+template <typename Key, typename Traits>
+class shm_tree {
+ public:
+  using value_type = typename Traits::value_type;
+  using size_type = std::size_t;
+
+  struct node {
+    explicit node(const value_type &item) : red(true), value(item) {}
+    offset_ptr<node> left;
+    offset_ptr<node> right;
+    offset_ptr<node> prev;
+    offset_ptr<node> next;
+    bool red;
+    value_type value;
+  };
+
+  explicit shm_tree(shm_segment &segment) noexcept
+      : head_(segment.header()), size_(0) {}
+
+  shm_tree(const shm_tree &) = delete;
+  shm_tree &operator=(const shm_tree &) = delete;
+
+  ~shm_tree() { clear(); }
+
+  size_type size() const noexcept { return size_; }
+
+  node *find(const Key &key) const noexcept {
+    node *current = root_.get();
+    while (current != nullptr) {
+      const Key &here = Traits::key(current->value);
+      if (key < here) {
+        current = current->left.get();
+      } else if (here < key) {
+        current = current->right.get();
+      } else {
+        return current;
+      }
+    }
+    return nullptr;
+  }
+
+  // Первый узел с ключом не меньше key (или больше key при strict)
+  node *lower_bound(const Key &key, bool strict = false) const noexcept {
+    node *current = root_.get();
+    node *found = nullptr;
+    while (current != nullptr) {
+      const Key &here = Traits::key(current->value);
+      if (strict ? key < here : !(here < key)) {
+        found = current;
+        current = current->left.get();
+      } else {
+        current = current->right.get();
+      }
+    }
+    return found;
+  }
+
+  node *first() const noexcept {
+    node *current = root_.get();
+    if (current == nullptr) return nullptr;
+    while (current->left) current = current->left.get();
+    return current;
+  }
+
+  node *next(const node *current) const noexcept {
+    return current->next.get();
+  }
+
+  // Вставляет value, если ключа еще нет. Возвращает узел с этим ключом и
+  // признак вставки
+  std::pair<node *, bool> insert(const value_type &value) {
+    // спуск находит и соседей нового узла по порядку
+    const Key &key = Traits::key(value);
+    node *before = nullptr;
+    node *after = nullptr;
+    node *current = root_.get();
+    while (current != nullptr) {
+      const Key &here = Traits::key(current->value);
+      if (key < here) {
+        after = current;
+        current = current->left.get();
+      } else if (here < key) {
+        before = current;
+        current = current->right.get();
+      } else {
+        return {current, false};
+      }
+    }
+    node *created = shm_new_node<node>(head_.get(), value);
+    created->prev = before;
+    created->next = after;
+    if (before != nullptr) before->next = created;
+    if (after != nullptr) after->prev = created;
+    root_ = insert(root_.get(), created);
+    root_->red = false;
+    ++size_;
+    return {created, true};
+  }
+
+  size_type erase(const Key &key) {
+    node *victim = find(key);
+    if (victim == nullptr) return 0;
+    if (victim->prev) victim->prev->next = victim->next;
+    if (victim->next) victim->next->prev = victim->prev;
+    node *root = root_.get();
+    if (!is_red(root->left.get()) && !is_red(root->right.get())) {
+      root->red = true;
+    }
+    root_ = erase(root, key);
+    if (root_) root_->red = false;
+    --size_;
+    return 1;
+  }
+
+  void clear() noexcept {
+    destroy(root_.get());
+    root_ = nullptr;
+    size_ = 0;
+  }
+
+ private:
+  offset_ptr<shm_header> head_;
+  offset_ptr<node> root_;
+  size_type size_;
+
+  static bool is_red(const node *current) noexcept {
+    return current != nullptr && current->red;
+  }
+
+  static node *rotate_left(node *h) noexcept {
+    node *x = h->right.get();
+    h->right = x->left;
+    x->left = h;
+    x->red = h->red;
+    h->red = true;
+    return x;
+  }
+
+  static node *rotate_right(node *h) noexcept {
+    node *x = h->left.get();
+    h->left = x->right;
+    x->right = h;
+    x->red = h->red;
+    h->red = true;
+    return x;
+  }
+
+  static void flip_colors(node *h) noexcept {
+    h->red = !h->red;
+    h->left->red = !h->left->red;
+    h->right->red = !h->right->red;
+  }
+
+  // Восстанавливает левосторонность после вставки или удаления
+  static node *balance(node *h) noexcept {
+    if (is_red(h->right.get()) && !is_red(h->left.get())) h = rotate_left(h);
+    if (is_red(h->left.get()) && is_red(h->left->left.get())) {
+      h = rotate_right(h);
+    }
+    if (is_red(h->left.get()) && is_red(h->right.get())) flip_colors(h);
+    return h;
+  }
+
+  static node *move_red_left(node *h) noexcept {
+    flip_colors(h);
+    if (is_red(h->right->left.get())) {
+      h->right = rotate_right(h->right.get());
+      h = rotate_left(h);
+      flip_colors(h);
+    }
+    return h;
+  }
+
+  static node *move_red_right(node *h) noexcept {
+    flip_colors(h);
+    if (is_red(h->left->left.get())) {
+      h = rotate_right(h);
+      flip_colors(h);
+    }
+    return h;
+  }
+
+  static node *insert(node *h, node *created) noexcept {
+    if (h == nullptr) return created;
+    if (Traits::key(created->value) < Traits::key(h->value)) {
+      h->left = insert(h->left.get(), created);
+    } else {
+      h->right = insert(h->right.get(), created);
+    }
+    return balance(h);
+  }
+
+  // Отцепляет наименьший узел поддерева и возвращает его в removed
+  static node *detach_min(node *h, node *&removed) noexcept {
+    if (!h->left) {
+      removed = h;
+      return nullptr;
+    }
+    if (!is_red(h->left.get()) && !is_red(h->left->left.get())) {
+      h = move_red_left(h);
+    }
+    h->left = detach_min(h->left.get(), removed);
+    return balance(h);
+  }
+
+  // Удаляет узел с ключом key, который точно есть в поддереве. Удаленный
+  // внутренний узел заменяется своим преемником перестановкой ссылок, без
+  // копирования значений
+  node *erase(node *h, const Key &key) noexcept {
+    if (key < Traits::key(h->value)) {
+      if (!is_red(h->left.get()) && !is_red(h->left->left.get())) {
+        h = move_red_left(h);
+      }
+      h->left = erase(h->left.get(), key);
+    } else {
+      if (is_red(h->left.get())) h = rotate_right(h);
+      if (!(Traits::key(h->value) < key) && !h->right) {
+        shm_deallocate(head_.get(), h);
+        return nullptr;
+      }
+      if (!is_red(h->right.get()) && !is_red(h->right->left.get())) {
+        h = move_red_right(h);
+      }
+      if (!(Traits::key(h->value) < key)) {
+        node *successor = nullptr;
+        node *right = detach_min(h->right.get(), successor);
+        successor->left = h->left;
+        successor->right = right;
+        successor->red = h->red;
+        shm_deallocate(head_.get(), h);
+        h = successor;
+      } else {
+        h->right = erase(h->right.get(), key);
+      }
+    }
+    return balance(h);
+  }
+
+  void destroy(node *current) noexcept {
+    while (current != nullptr) {
+      destroy(current->left.get());
+      node *right = current->right.get();
+      shm_deallocate(head_.get(), current);
+      current = right;
+    }
+  }
+};
+
+// Прямой итератор по дереву в сегменте
+template <typename Tree, typename Value>
+class shm_tree_iterator {
+ public:
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = std::remove_const_t<Value>;
+  using difference_type = std::ptrdiff_t;
+  using pointer = Value *;
+  using reference = Value &;
+
+  shm_tree_iterator() noexcept : tree_(nullptr), node_(nullptr) {}
+  shm_tree_iterator(const Tree *tree, typename Tree::node *current) noexcept
+      : tree_(tree), node_(current) {}
+
+  reference operator*() const noexcept { return node_->value; }
+  pointer operator->() const noexcept { return &node_->value; }
+  shm_tree_iterator &operator++() noexcept {
+    node_ = tree_->next(node_);
+    return *this;
+  }
+  shm_tree_iterator operator++(int) noexcept {
+    shm_tree_iterator old = *this;
+    ++*this;
+    return old;
+  }
+  bool operator==(const shm_tree_iterator &other) const noexcept {
+    return node_ == other.node_;
+  }
+  bool operator!=(const shm_tree_iterator &other) const noexcept {
+    return node_ != other.node_;
+  }
+
+ private:
+  const Tree *tree_;
+  typename Tree::node *node_;
+};
+
+}  // namespace detail
+
+// Множество в сегменте
+template <typename Key>
+class shm_set {
+  static_assert(std::is_trivially_copyable_v<Key>,
+                "shm containers store only trivially copyable types");
+  using tree = detail::shm_tree<Key, detail::shm_set_traits<Key>>;
+
+ public:
+  using key_type = Key;
+  using value_type = Key;
+  using size_type = std::size_t;
+  using const_iterator = detail::shm_tree_iterator<tree, const Key>;
+  using iterator = const_iterator;
+
+  explicit shm_set(shm_segment &segment) noexcept : tree_(segment) {}
+
+  const_iterator begin() const noexcept {
+    return const_iterator(&tree_, tree_.first());
+  }
+  const_iterator end() const noexcept {
+    return const_iterator(&tree_, nullptr);
+  }
+
+  bool empty() const noexcept { return tree_.size() == 0; }
+  size_type size() const noexcept { return tree_.size(); }
+
+  std::pair<iterator, bool> insert(const Key &key) {
+    auto result = tree_.insert(key);
+    return {iterator(&tree_, result.first), result.second};
+  }
+  size_type erase(const Key &key) { return tree_.erase(key); }
+  void clear() noexcept { tree_.clear(); }
+
+  const_iterator find(const Key &key) const noexcept {
+    return const_iterator(&tree_, tree_.find(key));
+  }
+  const_iterator lower_bound(const Key &key) const noexcept {
+    return const_iterator(&tree_, tree_.lower_bound(key));
+  }
+  bool contains(const Key &key) const noexcept {
+    return tree_.find(key) != nullptr;
+  }
+
+ private:
+  tree tree_;
+};
+
+// Словарь в сегменте
+template <typename Key, typename T>
+class shm_map {
+  static_assert(std::is_trivially_copyable_v<Key> &&
+                    std::is_trivially_copyable_v<T>,
+                "shm containers store only trivially copyable types");
+  using tree = detail::shm_tree<Key, detail::shm_map_traits<Key, T>>;
+
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const Key, T>;
+  using size_type = std::size_t;
+  using iterator = detail::shm_tree_iterator<tree, value_type>;
+  using const_iterator = detail::shm_tree_iterator<tree, const value_type>;
+
+  explicit shm_map(shm_segment &segment) noexcept : tree_(segment) {}
+
+  iterator begin() noexcept { return iterator(&tree_, tree_.first()); }
+  iterator end() noexcept { return iterator(&tree_, nullptr); }
+  const_iterator begin() const noexcept {
+    return const_iterator(&tree_, tree_.first());
+  }
+  const_iterator end() const noexcept {
+    return const_iterator(&tree_, nullptr);
+  }
+
+  bool empty() const noexcept { return tree_.size() == 0; }
+  size_type size() const noexcept { return tree_.size(); }
+
+  // Доступ к значению по ключу, отсутствующий ключ - std::out_of_range
+  T &at(const Key &key) {
+    auto *found = tree_.find(key);
+    if (found == nullptr) throw std::out_of_range("Key is not found");
+    return found->value.second;
+  }
+  const T &at(const Key &key) const {
+    auto *found = tree_.find(key);
+    if (found == nullptr) throw std::out_of_range("Key is not found");
+    return found->value.second;
+  }
+
+  std::pair<iterator, bool> insert(const Key &key, const T &obj) {
+    auto result = tree_.insert(value_type(key, obj));
+    return {iterator(&tree_, result.first), result.second};
+  }
+
+  std::pair<iterator, bool> insert_or_assign(const Key &key, const T &obj) {
+    auto result = tree_.insert(value_type(key, obj));
+    if (!result.second) result.first->value.second = obj;
+    return {iterator(&tree_, result.first), result.second};
+  }
+
+  size_type erase(const Key &key) { return tree_.erase(key); }
+  void clear() noexcept { tree_.clear(); }
+
+  iterator find(const Key &key) noexcept {
+    return iterator(&tree_, tree_.find(key));
+  }
+  const_iterator find(const Key &key) const noexcept {
+    return const_iterator(&tree_, tree_.find(key));
+  }
+  const_iterator lower_bound(const Key &key) const noexcept {
+    return const_iterator(&tree_, tree_.lower_bound(key));
+  }
+  bool contains(const Key &key) const noexcept {
+    return tree_.find(key) != nullptr;
+  }
+
+ private:
+  tree tree_;
+};
+
+}  // namespace s21
+
+#endif  // defined(__unix__) || defined(__APPLE__)
+
+#endif
@@ -0,0 +1,484 @@
+#ifndef S21_SORT_H_
+#define S21_SORT_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#include "s21_vector.h"
+
+/*
+    Сортировки для итераторов произвольного доступа (s21::vector, s21::array)
+    Целые числа и числа с плавающей точкой при сравнении по возрастанию
+   сортируются поразрядной сортировкой LSD: ключ переводится в беззнаковое
+   число с тем же порядком и раскладывается по байтам, байты, одинаковые у
+   всех элементов, пропускаются. Остальные типы и компараторы сортируются
+   pattern-defeating quicksort: быстрая сортировка с медианой из трех (девяти
+   для больших диапазонов), которая распознает уже упорядоченные участки,
+   перемешивает элементы после неудачного разбиения и переходит на
+   пирамидальную сортировку, если неудачных разбиений слишком много.
+*/
+
+namespace s21 {
+namespace detail {
+
+// Короче этого диапазоны сортируются вставками
+constexpr std::ptrdiff_t kInsertionSortThreshold = 24;
+// Длиннее этого опорный элемент выбирается медианой из девяти
+constexpr std::ptrdiff_t kNintherThreshold = 128;
+// Сколько перемещений допускает попытка досортировать вставками
+constexpr std::ptrdiff_t kPartialInsertionSortLimit = 8;
+// Короче этого поразрядная сортировка уступает сортировке вставками
+constexpr std::ptrdiff_t kRadixThreshold = 64;
+
+template <typename It>
+using iter_value_t = typename std::iterator_traits<It>::value_type;
+
+inline int floor_log2(std::size_t n) noexcept {
+  int log = 0;
+  while (n >>= 1) ++log;
+  return log;
+}
+
+// -------- Поразрядная сортировка --------
+
+// Типы ключей, которые умеет поразрядная сортировка
+template <typename K>
+constexpr bool is_radix_key_v =
+    (std::is_integral_v<K> && !std::is_same_v<K, bool>) ||
+    std::is_same_v<K, float> || std::is_same_v<K, double>;
+
+template <typename K, typename = void>
+struct radix_key;
+
+// Целые: у знаковых инвертируется старший бит
+template <typename K>
+struct radix_key<K, std::enable_if_t<std::is_integral_v<K>>> {
+  using type = std::make_unsigned_t<K>;
+
+  static type encode(K key) noexcept {
+    type bits = static_cast<type>(key);
+    if constexpr (std::is_signed_v<K>)
+      bits ^= type(1) << (std::numeric_limits<type>::digits - 1);
+    return bits;
+  }
+};
+
+// Числа с плавающей точкой: у отрицательных инвертируются все биты, у
+// положительных - знаковый. -0.0 приводится к 0.0, чтобы они остались
+// равными, как при сравнении через <
+template <typename K>
+struct radix_key<K, std::enable_if_t<std::is_floating_point_v<K>>> {
+  using type =
+      std::conditional_t<sizeof(K) == 4, std::uint32_t, std::uint64_t>;
+
+  static type encode(K key) noexcept {
+    if (key == K(0)) key = K(0);
+    type bits;
+    std::memcpy(&bits, &key, sizeof(bits));
+    const type sign = type(1) << (std::numeric_limits<type>::digits - 1);
+    return bits & sign ? ~bits : bits | sign;
+  }
+};
+
+template <typename Comp, typename T>
+constexpr bool is_ascending_v = std::is_same_v<Comp, std::less<T>> ||
+                                std::is_same_v<Comp, std::less<>>;
+
+// Переносит элементы из src в dst по байту pass ключа, offsets - начала
+// групп в dst
+template <typename Src, typename Dst, typename Key>
+void radix_scatter(Src src, Dst dst, std::size_t n, Key key, int pass,
+                   std::size_t *offsets) {
+  for (std::size_t i = 0; i < n; ++i) {
+    std::size_t digit = (key(src[i]) >> (8 * pass)) & 0xff;
+    dst[offsets[digit]++] = std::move(src[i]);
+  }
+}
+
+template <typename It, typename KeyFn, typename T>
+void radix_sort(It first, It last, KeyFn key_of, s21::vector<T> &buffer) {
+  using key_type = std::decay_t<decltype(key_of(*first))>;
+  using encoder = radix_key<key_type>;
+  using bits_type = typename encoder::type;
+  constexpr int passes = sizeof(bits_type);
+  static_assert(is_radix_key_v<key_type>,
+                "radix_sort needs an integral or floating point key");
+
+  auto key = [&](const T &value) { return encoder::encode(key_of(value)); };
+  std::size_t n = last - first;
+  if (std::ptrdiff_t(n) < kRadixThreshold) {
+    // вставки не переставляют равные элементы, как и поразрядная сортировка
+    for (std::size_t i = 1; i < n; ++i) {
+      T value = std::move(first[i]);
+      bits_type bits = key(value);
+      std::size_t j = i;
+      for (; j > 0 && bits < key(first[j - 1]); --j)
+        first[j] = std::move(first[j - 1]);
+      first[j] = std::move(value);
+    }
+    return;
+  }
+  if (buffer.size() < n) buffer = s21::vector<T>(n);
+
+  // гистограммы всех байтов за один проход
+  std::size_t counts[passes][256] = {};
+  for (std::size_t i = 0; i < n; ++i) {
+    bits_type bits = key(first[i]);
+    for (int pass = 0; pass < passes; ++pass)
+      ++counts[pass][(bits >> (8 * pass)) & 0xff];
+  }
+
+  bits_type sample = key(first[0]);
+  bool in_buffer = false;
+  for (int pass = 0; pass < passes; ++pass) {
+    // байт одинаков у всех элементов, проход ничего не изменит
+    if (counts[pass][(sample >> (8 * pass)) & 0xff] == n) continue;
+    std::size_t offsets[256];
+    std::size_t sum = 0;
+    for (int digit = 0; digit < 256; ++digit) {
+      offsets[digit] = sum;
+      sum += counts[pass][digit];
+    }
+    if (in_buffer)
+      radix_scatter(buffer.data(), first, n, key, pass, offsets);
+    else
+      radix_scatter(first, buffer.data(), n, key, pass, offsets);
+    in_buffer = !in_buffer;
+  }
+  if (in_buffer) std::move(buffer.data(), buffer.data() + n, first);
+}
+
+// -------- Pattern-defeating quicksort --------
+
+template <typename It, typename Comp>
+void insertion_sort(It begin, It end, Comp comp) {
+  if (begin == end) return;
+  for (It cur = begin + 1; cur != end; ++cur) {
+    It sift = cur;
+    It sift_1 = cur - 1;
+    if (comp(*sift, *sift_1)) {
+      iter_value_t<It> tmp = std::move(*sift);
+      do {
+        *sift-- = std::move(*sift_1);
+      } while (sift != begin && comp(tmp, *--sift_1));
+      *sift = std::move(tmp);
+    }
+  }
+}
+
+// То же без проверки левой границы: слева от begin лежит элемент, не
+// больший любого в диапазоне
+template <typename It, typename Comp>
+void unguarded_insertion_sort(It begin, It end, Comp comp) {
+  if (begin == end) return;
+  for (It cur = begin + 1; cur != end; ++cur) {
+    It sift = cur;
+    It sift_1 = cur - 1;
+    if (comp(*sift, *sift_1)) {
+      iter_value_t<It> tmp = std::move(*sift);
+      do {
+        *sift-- = std::move(*sift_1);
+      } while (comp(tmp, *--sift_1));
+      *sift = std::move(tmp);
+    }
+  }
+}
+
+// Сортирует вставками, пока перемещений не больше предела. Возвращает
+// false, если диапазон оказался далек от упорядоченного
+template <typename It, typename Comp>
+bool partial_insertion_sort(It begin, It end, Comp comp) {
+  if (begin == end) return true;
+  std::ptrdiff_t moves = 0;
+  for (It cur = begin + 1; cur != end; ++cur) {
+    It sift = cur;
+    It sift_1 = cur - 1;
+    if (comp(*sift, *sift_1)) {
+      iter_value_t<It> tmp = std::move(*sift);
+      do {
+        *sift-- = std::move(*sift_1);
+      } while (sift != begin && comp(tmp, *--sift_1));
+      *sift = std::move(tmp);
+      moves += cur - sift;
+    }
+    if (moves > kPartialInsertionSortLimit) return false;
+  }
+  return true;
+}
+
+template <typename It, typename Comp>
+void sort2(It a, It b, Comp comp) {
+  if (comp(*b, *a)) std::iter_swap(a, b);
+}
+
+template <typename It, typename Comp>
+void sort3(It a, It b, It c, Comp comp) {
+  sort2(a, b, comp);
+  sort2(b, c, comp);
+  sort2(a, b, comp);
+}
+
+// Ставит в begin медиану из трех или из девяти элементов. Последний
+// элемент после этого не меньше опорного, что ограничивает поиск в
+// partition_right
+template <typename It, typename Comp>
+void choose_pivot(It begin, It end, Comp comp) {
+  std::ptrdiff_t size = end - begin;
+  std::ptrdiff_t half = size / 2;
+  if (size > kNintherThreshold) {
+    sort3(begin, begin + half, end - 1, comp);
+    sort3(begin + 1, begin + (half - 1), end - 2, comp);
+    sort3(begin + 2, begin + (half + 1), end - 3, comp);
+    sort3(begin + (half - 1), begin + half, begin + (half + 1), comp);
+    std::iter_swap(begin, begin + half);
+  } else {
+    sort3(begin + half, begin, end - 1, comp);
+  }
+}
+
+// Разбивает диапазон опорным элементом *begin: меньшие слева, остальные
+// справа. Возвращает позицию опорного и признак того, что диапазон уже был
+// разбит и перестановок не понадобилось
+template <typename It, typename Comp>
+std::pair<It, bool> partition_right(It begin, It end, Comp comp) {
+  iter_value_t<It> pivot(std::move(*begin));
+  It first = begin;
+  It last = end;
+  while (comp(*++first, pivot)) {
+  }
+  if (first - 1 == begin) {
+    while (first < last && !comp(*--last, pivot)) {
+    }
+  } else {
+    while (!comp(*--last, pivot)) {
+    }
+  }
+  bool already_partitioned = first >= last;
+  while (first < last) {
+    std::iter_swap(first, last);
+    while (comp(*++first, pivot)) {
+    }
+    while (!comp(*--last, pivot)) {
+    }
+  }
+  It pivot_pos = first - 1;
+  *begin = std::move(*pivot_pos);
+  *pivot_pos = std::move(pivot);
+  return {pivot_pos, already_partitioned};
+}
+
+// Разбиение для случая, когда опорный равен элементу слева от диапазона:
+// равные опорному уходят влево и больше не сортируются
+template <typename It, typename Comp>
+It partition_left(It begin, It end, Comp comp) {
+  iter_value_t<It> pivot(std::move(*begin));
+  It first = begin;
+  It last = end;
+  while (comp(pivot, *--last)) {
+  }
+  if (last + 1 == end) {
+    while (first < last && !comp(pivot, *++first)) {
+    }
+  } else {
+    while (!comp(pivot, *++first)) {
+    }
+  }
+  while (first < last) {
+    std::iter_swap(first, last);
+    while (comp(pivot, *--last)) {
+    }
+    while (!comp(pivot, *++first)) {
+    }
+  }
+  *begin = std::move(*last);
+  *last = std::move(pivot);
+  return last;
+}
+
+// Перемешивает края частей после сильно неравного разбиения, чтобы
+// следующий выбор опорного не повторил неудачу
+template <typename It>
+void break_patterns(It begin, It pivot_pos, It end) {
+  std::ptrdiff_t l_size = pivot_pos - begin;
+  std::ptrdiff_t r_size = end - (pivot_pos + 1);
+  if (l_size >= kInsertionSortThreshold) {
+    std::iter_swap(begin, begin + l_size / 4);
+    std::iter_swap(pivot_pos - 1, pivot_pos - l_size / 4);
+    if (l_size > kNintherThreshold) {
+      std::iter_swap(begin + 1, begin + (l_size / 4 + 1));
+      std::iter_swap(begin + 2, begin + (l_size / 4 + 2));
+      std::iter_swap(pivot_pos - 2, pivot_pos - (l_size / 4 + 1));
+      std::iter_swap(pivot_pos - 3, pivot_pos - (l_size / 4 + 2));
+    }
+  }
+  if (r_size >= kInsertionSortThreshold) {
+    std::iter_swap(pivot_pos + 1, pivot_pos + (1 + r_size / 4));
+    std::iter_swap(end - 1, end - r_size / 4);
+    if (r_size > kNintherThreshold) {
+      std::iter_swap(pivot_pos + 2, pivot_pos + (2 + r_size / 4));
+      std::iter_swap(pivot_pos + 3, pivot_pos + (3 + r_size / 4));
+      std::iter_swap(end - 2, end - (1 + r_size / 4));
+      std::iter_swap(end - 3, end - (2 + r_size / 4));
+    }
+  }
+}
+
+template <typename It, typename Comp>
+void heap_sort(It begin, It end, Comp comp) {
+  std::make_heap(begin, end, comp);
+  std::sort_heap(begin, end, comp);
+}
+
+// bad_allowed - сколько еще неудачных разбиений допустимо до перехода на
+// пирамидальную сортировку, leftmost - нет ли элемента слева от диапазона
+template <typename It, typename Comp>
+void pdqsort(It begin, It end, Comp comp, int bad_allowed,
+             bool leftmost = true) {
+  while (true) {
+    std::ptrdiff_t size = end - begin;
+    if (size < kInsertionSortThreshold) {
+      if (leftmost)
+        insertion_sort(begin, end, comp);
+      else
+        unguarded_insertion_sort(begin, end, comp);
+      return;
+    }
+    choose_pivot(begin, end, comp);
+    // много равных элементов: опорный равен элементу слева
+    if (!leftmost && !comp(*(begin - 1), *begin)) {
+      begin = partition_left(begin, end, comp) + 1;
+      continue;
+    }
+    std::pair<It, bool> part = partition_right(begin, end, comp);
+    It pivot_pos = part.first;
+    std::ptrdiff_t l_size = pivot_pos - begin;
+    std::ptrdiff_t r_size = end - (pivot_pos + 1);
+    if (l_size < size / 8 || r_size < size / 8) {
+      if (--bad_allowed == 0) {
+        heap_sort(begin, end, comp);
+        return;
+      }
+      break_patterns(begin, pivot_pos, end);
+    } else if (part.second && partial_insertion_sort(begin, pivot_pos, comp) &&
+               partial_insertion_sort(pivot_pos + 1, end, comp)) {
+      return;
+    }
+    pdqsort(begin, pivot_pos, comp, bad_allowed, leftmost);
+    begin = pivot_pos + 1;
+    leftmost = false;
+  }
+}
+
+}  // namespace detail
+
+// Сортирует элементы по ключу key(x) поразрядной сортировкой, порядок
+// равных ключей сохраняется. Ключ - целое число или число с плавающей
+// точкой. buffer переиспользуется между вызовами и растет до размера
+// диапазона, его содержимое после сортировки не определено
+template <typename It, typename KeyFn, typename T>
+void radix_sort(It first, It last, KeyFn key, s21::vector<T> &buffer) {
+  detail::radix_sort(first, last, key, buffer);
+}
+
+template <typename It, typename KeyFn>
+void radix_sort(It first, It last, KeyFn key) {
+  s21::vector<detail::iter_value_t<It>> buffer;
+  detail::radix_sort(first, last, key, buffer);
+}
+
+// Сортирует диапазон по компаратору
+template <typename It, typename Compare>
+void sort(It first, It last, Compare comp) {
+  using value_type = detail::iter_value_t<It>;
+  if constexpr (detail::is_radix_key_v<value_type> &&
+                detail::is_ascending_v<Compare, value_type>) {
+    if (last - first >= detail::kRadixThreshold) {
+      s21::radix_sort(first, last, [](value_type x) { return x; });
+      return;
+    }
+  }
+  if (last - first > 1)
+    detail::pdqsort(first, last, comp, detail::floor_log2(last - first));
+}
+
+template <typename It>
+void sort(It first, It last) {
+  s21::sort(first, last, std::less<>());
+}
+
+// Сортирует диапазон, сохраняя порядок равных элементов
+template <typename It, typename Compare>
+void stable_sort(It first, It last, Compare comp) {
+  using value_type = detail::iter_value_t<It>;
+  if constexpr (detail::is_radix_key_v<value_type> &&
+                detail::is_ascending_v<Compare, value_type>) {
+    s21::radix_sort(first, last, [](value_type x) { return x; });
+  } else {
+    std::stable_sort(first, last, comp);
+  }
+}
+
+template <typename It>
+void stable_sort(It first, It last) {
+  s21::stable_sort(first, last, std::less<>());
+}
+
+// Переставляет элементы так, что на месте nth стоит элемент, который был
+// бы там после сортировки, слева - не большие, справа - не меньшие.
+// Разбиение то же, что в pdqsort, но продолжается только в части с nth
+template <typename It, typename Compare>
+void nth_element(It first, It nth, It last, Compare comp) {
+  if (first == last || nth == last) return;
+  int bad_allowed = detail::floor_log2(last - first);
+  while (last - first > detail::kInsertionSortThreshold) {
+    detail::choose_pivot(first, last, comp);
+    std::ptrdiff_t size = last - first;
+    It pivot_pos = detail::partition_right(first, last, comp).first;
+    if (pivot_pos == nth) return;
+    std::ptrdiff_t l_size = pivot_pos - first;
+    std::ptrdiff_t r_size = last - (pivot_pos + 1);
+    if (l_size < size / 8 || r_size < size / 8) {
+      // много равных элементов или неудачные данные: O(n log n) сортировка
+      if (--bad_allowed == 0) {
+        detail::pdqsort(first, last, comp, detail::floor_log2(size));
+        return;
+      }
+      detail::break_patterns(first, pivot_pos, last);
+    }
+    if (nth < pivot_pos)
+      last = pivot_pos;
+    else
+      first = pivot_pos + 1;
+  }
+  detail::insertion_sort(first, last, comp);
+}
+
+template <typename It>
+void nth_element(It first, It nth, It last) {
+  s21::nth_element(first, nth, last, std::less<>());
+}
+
+// Сортирует наименьшие middle - first элементов в начало диапазона:
+// отбор через nth_element, затем сортировка только отобранных
+template <typename It, typename Compare>
+void partial_sort(It first, It middle, It last, Compare comp) {
+  if (middle == first) return;
+  if (middle != last) s21::nth_element(first, middle - 1, last, comp);
+  s21::sort(first, middle, comp);
+}
+
+template <typename It>
+void partial_sort(It first, It middle, It last) {
+  s21::partial_sort(first, middle, last, std::less<>());
+}
+
+}  // namespace s21
+
+#endif
@@ -0,0 +1,323 @@
+#ifndef S21_SPILLING_QUEUE_H_
+#define S21_SPILLING_QUEUE_H_
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "s21_external_sort.h"
+#include "s21_vector.h"
+
+/*
+    Реализация очереди с вытеснением на диск
+    spilling_queue хранит элементы блоками по segment_bytes в s21::vector, а
+   не узлами списка, поэтому в памяти нет накладных расходов на элемент.
+   Пока очередь укладывается в memory_bytes, все блоки остаются в памяти.
+   Сверх бюджета заполненные блоки дописываются сегментами во временные
+   файлы, а потребитель читает их обратно по порядку одним pread на сегмент
+   и заранее просит систему подгрузить следующий. Порядок FIFO сохраняется:
+   голова в памяти, затем блоки в памяти, затем сегменты на диске, затем
+   заполняемый хвост. Прочитанные файлы переиспользуются для новых
+   сегментов. Элементы пишутся побайтно, поэтому тип должен быть тривиально
+   копируемым.
+*/
+
+namespace s21 {
+
+// Настройки очереди с вытеснением
+struct spilling_queue_options {
+  // Сколько байт элементов держать в памяти до вытеснения на диск
+  std::size_t memory_bytes = std::size_t(64) << 20;
+  // Размер блока в памяти и сегмента на диске
+  std::size_t segment_bytes = std::size_t(4) << 20;
+  // Сегментов в одном файле
+  std::size_t file_segments = 64;
+  // Каталог файлов, пустой - TMPDIR или /tmp
+  std::string dir;
+};
+
+template <typename T>
+class spilling_queue {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "spilling_queue stores only trivially copyable types");
+
+ public:
+  using value_type = T;
+  using reference = T &;
+  using const_reference = const T &;
+  using size_type = std::size_t;
+
+  explicit spilling_queue(const spilling_queue_options &options = {})
+      : options_(options), pos_(0), size_(0), in_memory_(0) {
+    if (options_.dir.empty()) {
+      const char *dir = std::getenv("TMPDIR");
+      options_.dir = dir != nullptr && *dir != '\0' ? dir : "/tmp";
+    }
+    block_size_ = options_.segment_bytes / sizeof(T);
+    if (block_size_ == 0) block_size_ = 1;
+    if (options_.file_segments == 0) options_.file_segments = 1;
+  }
+
+  spilling_queue(const spilling_queue &) = delete;
+  spilling_queue &operator=(const spilling_queue &) = delete;
+
+  // Исходная очередь остается пустой и пригодной для работы с теми же
+  // настройками
+  spilling_queue(spilling_queue &&other)
+      : options_(other.options_),
+        block_size_(other.block_size_),
+        front_(std::move(other.front_)),
+        pos_(other.pos_),
+        blocks_(std::move(other.blocks_)),
+        segments_(std::move(other.segments_)),
+        back_(std::move(other.back_)),
+        writing_(std::move(other.writing_)),
+        recycled_(std::move(other.recycled_)),
+        size_(other.size_),
+        in_memory_(other.in_memory_) {
+    other.reset_counters();
+  }
+
+  spilling_queue &operator=(spilling_queue &&other) {
+    if (this != &other) {
+      spilling_queue moved(std::move(other));
+      swap(moved);
+    }
+    return *this;
+  }
+
+  // Element access
+
+  // Доступ к первому элементу
+  const_reference front() const {
+    if (empty()) throw std::logic_error("The queue is empty");
+    return front_[pos_];
+  }
+
+  // Capacity
+
+  bool empty() const noexcept { return size_ == 0; }
+  size_type size() const noexcept { return size_; }
+
+  // Сколько сегментов сейчас лежит на диске
+  size_type spilled_segments() const noexcept { return segments_.size(); }
+
+  // Modifiers
+
+  // Добавляет элемент в конец очереди. Заполненный хвост уходит в память
+  // или, сверх бюджета, на диск. Если хвост убрать не удалось, например
+  // диск заполнен, элемент не добавляется
+  void push(const_reference value) {
+    back_.push_back(value);
+    ++size_;
+    ++in_memory_;
+    if (back_.size() == block_size_) {
+      try {
+        retire_back();
+      } catch (...) {
+        back_.pop_back();
+        --size_;
+        --in_memory_;
+        throw;
+      }
+    }
+    normalize();
+  }
+
+  // Удаляет первый элемент. Если следующий сегмент не прочитался, очередь
+  // не меняется
+  void pop() {
+    if (empty()) throw std::logic_error("The queue is empty");
+    ++pos_;
+    --size_;
+    --in_memory_;
+    try {
+      normalize();
+    } catch (...) {
+      --pos_;
+      ++size_;
+      ++in_memory_;
+      throw;
+    }
+  }
+
+  void swap(spilling_queue &other) noexcept {
+    std::swap(options_, other.options_);
+    std::swap(block_size_, other.block_size_);
+    front_.swap(other.front_);
+    std::swap(pos_, other.pos_);
+    blocks_.swap(other.blocks_);
+    segments_.swap(other.segments_);
+    back_.swap(other.back_);
+    writing_.swap(other.writing_);
+    recycled_.swap(other.recycled_);
+    std::swap(size_, other.size_);
+    std::swap(in_memory_, other.in_memory_);
+  }
+
+ private:
+  // Файл с сегментами: пишется подряд, переиспользуется после прочтения
+  struct spill_file {
+    explicit spill_file(const std::string &dir)
+        : file(dir, false), written(0), consumed(0) {}
+    detail::run_file file;
+    size_type written;
+    size_type consumed;
+  };
+
+  struct segment {
+    std::shared_ptr<spill_file> file;
+    size_type index;
+    size_type count;
+  };
+
+  // Столько прочитанных файлов держится для новых сегментов
+  static constexpr size_type kRecycledFiles = 2;
+
+  spilling_queue_options options_;
+  size_type block_size_;
+  // Голова, которую сейчас читает потребитель, и позиция в ней
+  vector<T> front_;
+  size_type pos_;
+  // Заполненные блоки в памяти, идут раньше сегментов на диске
+  std::deque<vector<T>> blocks_;
+  std::deque<segment> segments_;
+  // Заполняемый хвост
+  vector<T> back_;
+  std::shared_ptr<spill_file> writing_;
+  std::vector<std::shared_ptr<spill_file>> recycled_;
+  size_type size_;
+  // Элементов в памяти: голова, блоки и хвост
+  size_type in_memory_;
+
+  void reset_counters() noexcept {
+    pos_ = 0;
+    size_ = 0;
+    in_memory_ = 0;
+  }
+
+  // Убирает заполненный хвост: в память, пока есть бюджет и на диске
+  // ничего нет, иначе в новый сегмент. При исключении хвост не меняется
+  void retire_back() {
+    bool fits = in_memory_ * sizeof(T) <= options_.memory_bytes;
+    if (segments_.empty() && fits) {
+      vector<T> fresh;
+      fresh.reserve(block_size_);
+      blocks_.push_back(std::move(back_));
+      back_.swap(fresh);
+    } else {
+      // буфер хвоста уже записан и переиспользуется
+      spill(back_);
+      in_memory_ -= back_.size();
+      back_.clear();
+    }
+  }
+
+  // Дописывает блок сегментом в текущий файл
+  void spill(const vector<T> &block) {
+    if (!writing_ || writing_->written == options_.file_segments) {
+      writing_ = take_file();
+    }
+    size_type bytes = block.size() * sizeof(T);
+    off_t offset = off_t(writing_->written * block_size_ * sizeof(T));
+    const char *data = reinterpret_cast<const char *>(block.data());
+    while (bytes > 0) {
+      ssize_t done = ::pwrite(writing_->file.fd(), data, bytes, offset);
+      if (done < 0 && errno == EINTR) continue;
+      if (done < 0) detail::throw_sort_errno("spilling_queue: write failed");
+      data += done;
+      bytes -= size_type(done);
+      offset += done;
+    }
+    segments_.push_back({writing_, writing_->written, block.size()});
+    ++writing_->written;
+  }
+
+  std::shared_ptr<spill_file> take_file() {
+    if (!recycled_.empty()) {
+      std::shared_ptr<spill_file> file = std::move(recycled_.back());
+      recycled_.pop_back();
+      return file;
+    }
+    return std::make_shared<spill_file>(options_.dir);
+  }
+
+  // Читает первый сегмент в голову и просит подгрузить следующий. Сегмент
+  // снимается с очереди только после успешного чтения
+  void load_segment() {
+    vector<T> block(segments_.front().count);
+    {
+      const segment &next = segments_.front();
+      size_type bytes = next.count * sizeof(T);
+      off_t offset = off_t(next.index * block_size_ * sizeof(T));
+      char *data = reinterpret_cast<char *>(block.data());
+      while (bytes > 0) {
+        ssize_t done = ::pread(next.file->file.fd(), data, bytes, offset);
+        if (done < 0 && errno == EINTR) continue;
+        if (done < 0) detail::throw_sort_errno("spilling_queue: read failed");
+        if (done == 0) {
+          throw std::runtime_error("spilling_queue: lost segment");
+        }
+        data += done;
+        bytes -= size_type(done);
+        offset += done;
+      }
+    }
+    segment next = std::move(segments_.front());
+    segments_.pop_front();
+#ifdef POSIX_FADV_WILLNEED
+    if (!segments_.empty()) {
+      const segment &ahead = segments_.front();
+      posix_fadvise(ahead.file->file.fd(),
+                    off_t(ahead.index * block_size_ * sizeof(T)),
+                    off_t(ahead.count * sizeof(T)), POSIX_FADV_WILLNEED);
+    }
+#endif
+    front_ = std::move(block);
+    in_memory_ += next.count;
+    // файл прочитан целиком и больше не пишется: он идет на новые сегменты
+    spill_file &file = *next.file;
+    if (++file.consumed == options_.file_segments &&
+        recycled_.size() < kRecycledFiles) {
+      if (writing_ == next.file) writing_.reset();
+      file.written = file.consumed = 0;
+      recycled_.push_back(std::move(next.file));
+    }
+  }
+
+  // Если голова прочитана, подставляет следующую часть очереди
+  void normalize() {
+    if (pos_ < front_.size()) return;
+    if (!blocks_.empty()) {
+      front_ = std::move(blocks_.front());
+      blocks_.pop_front();
+    } else if (!segments_.empty()) {
+      load_segment();
+    } else {
+      // потребитель догнал хвост: буферы меняются местами, чтобы не
+      // выделять память заново
+      front_.clear();
+      front_.swap(back_);
+    }
+    pos_ = 0;
+  }
+};
+
+}  // namespace s21
+
+#endif  // defined(__unix__) || defined(__APPLE__)
+
+#endif
@@ -4,6 +4,10 @@
 #include "s21_list.h"
 
 namespace s21 {
+// Доступ сериализации к внутреннему списку (s21_serialize.h)
+template <typename Container>
+struct serialize_access;
+
 template <typename T>
 class stack {
   // -------- Stack Member type ----------
@@ -14,10 +18,10 @@ class stack {
 
  public:
   // -------- Stack Member functions ----------
-  stack() : list_() {}
+  stack() noexcept : list_() {}
   stack(std::initializer_list<value_type> const& items) : list_(items) {}
   stack(const stack& s) : list_(s.list_) {}
-  stack(stack&& s) : list_(std::move(s.list_)) {}
+  stack(stack&& s) noexcept : list_(std::move(s.list_)) {}
   ~stack() = default;
 
   stack& operator=(const stack& s) {
@@ -25,7 +29,7 @@ class stack {
     return *this;
   }
 
-  stack& operator=(stack&& s) {
+  stack& operator=(stack&& s) noexcept {
     list_ = std::move(s.list_);
     return *this;
   }
@@ -41,7 +45,7 @@ class stack {
   // -------- Stack Modifiers -----------
   void push(const_reference value) { list_.push_back(value); }
   void pop() { list_.pop_back(); }
-  void swap(stack& other) { list_.swap(other.list_); }
+  void swap(stack& other) noexcept { list_.swap(other.list_); }
 
   template <typename... Args>
   void insert_many_front(Args&&... args) {
@@ -49,6 +53,8 @@ class stack {
   }
 
  private:
+  friend struct serialize_access<stack>;
+
   s21::list<value_type> list_;
 };
 }  // namespace s21
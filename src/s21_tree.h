@@ -4,6 +4,7 @@
 #include <initializer_list>
 #include <iostream>
 #include <limits>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -23,16 +24,19 @@
 */
 
 namespace s21 {
-template <typename Key>
+template <typename Key, typename Compare = std::less<Key>>
 class RBTree {
   class RBNode;
   class RBIterator;
   class RBConstIterator;
+  class RBNodeHandle;
+  struct RBInsertReturn;
   using reference = Key&;
   using const_reference = const Key&;
   using size_type = std::size_t;
-  using comparator = std::less<Key>;
-  using NodePtr = RBNode*;
+  using comparator = Compare;
+  class RBNodeBase;
+  using NodePtr = RBNodeBase*;
 
   enum NodeColor { BLACK, RED };
 
@@ -41,34 +45,31 @@ class RBTree {
   using iterator = RBIterator;
   using const_iterator = RBConstIterator;
   using value_type = Key;
+  using node_type = RBNodeHandle;
+  using insert_return_type = RBInsertReturn;
 
-  // конструктор по умолчанию. создает корневой узел
-  RBTree() : root_(new RBNode), size_(0) {};
+  // конструктор по умолчанию. конечный узел хранится внутри дерева,
+  // поэтому пустое дерево не выделяет память
+  RBTree() noexcept : header_(), size_(0) {};
 
   // конструктор копирования
   RBTree(const RBTree& other) : RBTree() { *this = other; };
 
-  // конструктор перемещения
-  RBTree(RBTree&& other) : RBTree() { *this = std::move(other); };
+  // конструктор перемещения. забирает узлы без выделения памяти
+  RBTree(RBTree&& other) noexcept : RBTree() { take_nodes(other); };
 
   // деструктор
-  ~RBTree() {
-    clear();
-    delete_node(root_);
-  };
+  ~RBTree() { clear(); };
 
   // перегрузка оператора присваивания копирования
   RBTree& operator=(const RBTree& other) {
     if (this != &other) {
-      if (other.size_ == 0) {
-        clear();
-      } else {
-        if (root_->parent_) clear();
-        NodePtr root = copy(other.root_->parent_, nullptr);
-        root_->parent_ = root;
-        root_->parent_->parent_ = root;
-        root_->left_ = other.root_->left_;
-        root_->right_ = other.root_->right_;
+      clear();
+      if (other.size_ != 0) {
+        NodePtr root = copy(other.header_.parent_, end_node());
+        header_.parent_ = root;
+        header_.left_ = search_left(root);
+        header_.right_ = search_right(root);
         size_ = other.size_;
       }
     }
@@ -76,31 +77,29 @@ class RBTree {
   };
 
   // перегрузка оператора перемещения
-  RBTree& operator=(RBTree&& other) {
+  RBTree& operator=(RBTree&& other) noexcept {
     if (this != &other) {
       clear();
-      std::swap(this->root_, other.root_);
-      std::swap(this->size_, other.size_);
-    } else {
-      other.clear();
-      delete_node(other.root_);
+      take_nodes(other);
     }
     return *this;
   };
 
   // возвращает итератор минимального элемента
-  iterator begin() noexcept { return iterator(root_->left_); };
+  iterator begin() noexcept {
+    return iterator(header_.left_ ? header_.left_ : end_node());
+  };
 
   // то же для константного объекта
   const_iterator begin() const noexcept {
-    return const_iterator(root_->left_);
+    return const_iterator(header_.left_ ? header_.left_ : end_node());
   };
 
   // возвращает итератор на корень (конечный элемент)
-  iterator end() noexcept { return iterator(root_); };
+  iterator end() noexcept { return iterator(end_node()); };
 
   // то же для константного объекта
-  const_iterator end() const noexcept { return const_iterator(root_); };
+  const_iterator end() const noexcept { return const_iterator(end_node()); };
 
   // проверяет, пуст ли объект
   bool empty() const noexcept { return size_ ? 0 : 1; };
@@ -116,66 +115,187 @@ class RBTree {
   };
 
   // очищает содержимое объекта
-  void clear() {
-    delete_all(root_->parent_);
-    root_->parent_ = nullptr;
-    root_->left_ = nullptr;
-    root_->right_ = nullptr;
+  void clear() noexcept {
+    delete_all(header_.parent_);
+    header_.parent_ = nullptr;
+    header_.left_ = nullptr;
+    header_.right_ = nullptr;
     size_ = 0;
   };
 
   // вставляет новый элемент в объект
   // вставляются только уникальные элементы
   std::pair<iterator, bool> insert(const value_type& value) {
-    NodePtr new_node = new RBNode(value);
+    return emplace(value);
+  };
+
+  // вставляет новый элемент в объект
+  // допускается вставка дубликатов
+  iterator insert_duplicate(const value_type& value) {
+    return emplace_duplicate(value);
+  };
+
+  // создает элемент из аргументов прямо в узле и вставляет его
+  // вставляются только уникальные элементы
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) {
+    NodePtr new_node = new RBNode(std::forward<Args>(args)...);
     std::pair<iterator, bool> res = insert_node(new_node, true);
     if (!res.second) delete_node(new_node);
     return res;
   };
 
-  // вставляет новый элемент в объект
+  // создает элемент из аргументов прямо в узле и вставляет его
   // допускается вставка дубликатов
-  iterator insert_duplicate(const value_type& value) {
-    NodePtr new_node = new RBNode(value);
+  template <typename... Args>
+  iterator emplace_duplicate(Args&&... args) {
+    NodePtr new_node = new RBNode(std::forward<Args>(args)...);
     return insert_node(new_node, false).first;
   };
 
+  // то же, что emplace, но поиск места начинается с подсказки:
+  // если элемент должен стоять прямо перед hint, вставка без спуска по дереву
+  template <typename... Args>
+  iterator emplace_hint(const_iterator hint, Args&&... args) {
+    NodePtr new_node = new RBNode(std::forward<Args>(args)...);
+    std::pair<iterator, bool> res =
+        insert_node_hint(hint.node_, new_node, true);
+    if (!res.second) delete_node(new_node);
+    return res.first;
+  };
+
+  // то же для дерева с дубликатами
+  template <typename... Args>
+  iterator emplace_hint_duplicate(const_iterator hint, Args&&... args) {
+    NodePtr new_node = new RBNode(std::forward<Args>(args)...);
+    return insert_node_hint(hint.node_, new_node, false).first;
+  };
+
+  // ищет элемент по ключу и, только если его нет, создает узел из аргументов
+  // ключ сравнивается с элементами тем же компаратором, что и элементы
+  template <typename K, typename... Args>
+  std::pair<iterator, bool> try_emplace(const K& key, Args&&... args) {
+    NodePtr node = header_.parent_;
+    NodePtr parent = nullptr;
+    bool left = false;
+    while (node != nullptr) {
+      parent = node;
+      if (comparator{}(key, node_value(node))) {
+        node = node->left_;
+        left = true;
+      } else if (comparator{}(node_value(node), key)) {
+        node = node->right_;
+        left = false;
+      } else {
+        return {iterator(node), false};
+      }
+    }
+    NodePtr new_node = new RBNode(std::forward<Args>(args)...);
+    attach_node(new_node, parent, left);
+    return {iterator(new_node), true};
+  };
+
   // удаляет элемент на позиции
   void erase(iterator pos) { delete_node(pos); };
 
+  // удаляет элементы в диапазоне [first, last)
+  // если удаляется заметная часть дерева, оставшиеся узлы перестраиваются
+  // в сбалансированное дерево за O(n) вместо k отдельных балансировок
+  iterator erase(const_iterator first, const_iterator last) {
+    if (first.node_ == begin().node_ && last.node_ == end_node()) {
+      clear();
+      return end();
+    }
+    size_type count = 0;
+    for (const_iterator it = first; it != last; ++it) count++;
+    if (count * floor_log2(size_) > size_) {
+      std::vector<NodePtr> nodes = collect_nodes();
+      std::vector<NodePtr> keep;
+      keep.reserve(size_ - count);
+      bool in_range = false;
+      for (NodePtr node : nodes) {
+        if (node == first.node_) in_range = true;
+        if (node == last.node_) in_range = false;
+        if (in_range)
+          delete_node(node);
+        else
+          keep.push_back(node);
+      }
+      build_from_sorted(keep);
+    } else {
+      for (const_iterator it = first; it != last;) {
+        NodePtr node = it.node_;
+        ++it;
+        delete_node(iterator(node));
+      }
+    }
+    return iterator(last.node_);
+  };
+
+  // удаляет все элементы, для которых pred возвращает true
+  // один проход по дереву и одна перестройка, возвращает число удаленных
+  template <typename Pred>
+  size_type erase_if(Pred pred) {
+    std::vector<NodePtr> nodes = collect_nodes();
+    std::vector<NodePtr> keep;
+    std::vector<NodePtr> removed;
+    keep.reserve(nodes.size());
+    for (NodePtr node : nodes) {
+      if (pred(node_value(node)))
+        removed.push_back(node);
+      else
+        keep.push_back(node);
+    }
+    // дерево меняется только после всех вызовов pred
+    if (!removed.empty()) {
+      for (NodePtr node : removed) delete_node(node);
+      build_from_sorted(keep);
+    }
+    return removed.size();
+  };
+
   // обменивает содержимое
-  void swap(RBTree& other) {
-    using std::swap;
-    swap(root_, other.root_);
-    swap(size_, other.size_);
+  void swap(RBTree& other) noexcept {
+    if (this != &other) {
+      RBTree temp(std::move(other));
+      other.take_nodes(*this);
+      take_nodes(temp);
+    }
   };
 
   // возвращает итератор к элементу с ключом
-  iterator find(const_reference key) noexcept {
-    iterator res = iterator(find_node(key));
-    if (res == end() || comparator{}(*res, key)) return end();
-    return res;
-  };
+  iterator find(const_reference key) noexcept { return find_key(key); };
 
   // то же для константного объекта
   const_iterator find(const_reference key) const noexcept {
-    const_iterator res = lower_bound(key);
-    if (res == end() || comparator{}(*res, key)) return end();
-    return res;
+    return find_key(key);
+  };
+
+  // возвращает итератор к элементу, эквивалентному ключу любого типа,
+  // который умеет сравнивать компаратор
+  template <typename K>
+  iterator find_key(const K& key) noexcept {
+    return iterator(find_node(key));
+  };
+
+  // то же для константного объекта
+  template <typename K>
+  const_iterator find_key(const K& key) const noexcept {
+    return const_iterator(iterator(find_node(key)));
   };
 
   // проверяет, содержит ли объект такой элемент
   bool contains(const_reference key) const noexcept {
     NodePtr node = find_node(key);
-    return (node != root_);
+    return (node != end_node());
   };
 
   // возвращает итератор к большему элементу
   iterator upper_bound(const_reference value) noexcept {
     iterator result = end();
-    NodePtr begin = root_->parent_;
+    NodePtr begin = header_.parent_;
     while (begin != nullptr) {
-      if (comparator{}(value, begin->data_)) {
+      if (comparator{}(value, node_value(begin))) {
         result = iterator(begin);
         begin = begin->left_;
       } else
@@ -187,9 +307,9 @@ class RBTree {
   // то же для константного объекта
   const_iterator upper_bound(const_reference value) const noexcept {
     const_iterator result = end();
-    NodePtr begin = root_->parent_;
+    NodePtr begin = header_.parent_;
     while (begin != nullptr) {
-      if (comparator{}(value, begin->data_)) {
+      if (comparator{}(value, node_value(begin))) {
         result = const_iterator(begin);
         begin = begin->left_;
       } else
@@ -202,9 +322,9 @@ class RBTree {
   // [first,last), который не сравнивается меньше, чем ключ
   iterator lower_bound(const_reference value) noexcept {
     iterator result = end();
-    NodePtr begin = root_->parent_;
+    NodePtr begin = header_.parent_;
     while (begin != nullptr) {
-      if (comparator{}(begin->data_, value)) {
+      if (comparator{}(node_value(begin), value)) {
         begin = begin->right_;
       } else {
         result = iterator(begin);
@@ -217,9 +337,9 @@ class RBTree {
   // то же для константного объекта
   const_iterator lower_bound(const_reference value) const noexcept {
     const_iterator result = end();
-    NodePtr begin = root_->parent_;
+    NodePtr begin = header_.parent_;
     while (begin != nullptr) {
-      if (comparator{}(begin->data_, value)) {
+      if (comparator{}(node_value(begin), value)) {
         begin = begin->right_;
       } else {
         result = const_iterator(begin);
@@ -273,7 +393,9 @@ class RBTree {
         other.size_--;
       }
     }
-    other.root_->parent_ = nullptr;
+    other.header_.parent_ = nullptr;
+    other.header_.left_ = nullptr;
+    other.header_.right_ = nullptr;
     other.size_ = 0;
   };
 
@@ -284,7 +406,7 @@ class RBTree {
     if (this != &other) {
       iterator it = other.begin();
       while (it != other.end()) {
-        if (find(it.node_->data_) == end()) {
+        if (find(node_value(it.node_)) == end()) {
           NodePtr node = it.node_;
           it++;
           node = other.merge_node(node);
@@ -296,18 +418,12 @@ class RBTree {
   };
 
   // вставляет новые элементы в контейнер
+  // каждый аргумент передается прямо в конструктор своего узла
   template <typename... Args>
   std::vector<std::pair<iterator, bool>> insert_many(Args&&... args) {
     std::vector<std::pair<iterator, bool>> vect;
     vect.reserve(sizeof...(args));
-    for (auto element : {std::forward<Args>(args)...}) {
-      NodePtr new_node = new RBNode(std::move(element));
-      std::pair<iterator, bool> result = insert_node(new_node, true);
-      if (result.second == false) {
-        delete new_node;
-      }
-      vect.push_back(result);
-    }
+    (vect.push_back(emplace(std::forward<Args>(args))), ...);
     return vect;
   }
 
@@ -316,19 +432,91 @@ class RBTree {
   std::vector<std::pair<iterator, bool>> insert_many_duplicate(Args&&... args) {
     std::vector<std::pair<iterator, bool>> vect;
     vect.reserve(sizeof...(args));
-    for (auto element : {std::forward<Args>(args)...}) {
-      NodePtr new_node = new RBNode(std::move(element));
-      vect.push_back(insert_node(new_node, false));
-    }
+    (vect.emplace_back(emplace_duplicate(std::forward<Args>(args)), true), ...);
     return vect;
   }
 
+  // извлекает узел на позиции из дерева без освобождения памяти
+  // узел можно вставить в другое дерево того же типа без копирования
+  node_type extract(const_iterator pos) noexcept {
+    if (pos.node_ == end_node()) return node_type();
+    return node_type(merge_node(pos.node_));
+  };
+
+  // извлекает узел с ключом, если он есть
+  template <typename K>
+  node_type extract_key(const K& key) noexcept {
+    return extract(find_key(key));
+  };
+
+  // вставляет извлеченный узел, если такого элемента еще нет
+  // при неудаче узел возвращается обратно в поле node
+  insert_return_type insert(node_type&& nh) {
+    if (nh.empty()) return {end(), false, node_type()};
+    std::pair<iterator, bool> res = insert_node(nh.node_, true);
+    if (res.second) nh.node_ = nullptr;
+    return {res.first, res.second, std::move(nh)};
+  };
+
+  // вставляет извлеченный узел, допускаются дубликаты
+  iterator insert_duplicate(node_type&& nh) {
+    if (nh.empty()) return end();
+    NodePtr node = nh.node_;
+    nh.node_ = nullptr;
+    return insert_node(node, false).first;
+  };
+
+  // заменяет содержимое count элементами, которые по очереди возвращает
+  // next() в порядке возрастания. дерево строится за O(n) сразу
+  // сбалансированным, без поиска места и поворотов. если порядок нарушен
+  // (или ключ повторился при unique), бросает std::invalid_argument и
+  // оставляет дерево пустым
+  template <typename Next>
+  void assign_sorted(size_type count, Next next, bool unique) {
+    clear();
+    std::vector<NodePtr> nodes;
+    nodes.reserve(count);
+    try {
+      for (size_type i = 0; i < count; ++i) {
+        nodes.push_back(new RBNode(next()));
+        if (i > 0) {
+          const Key& prev = node_value(nodes[i - 1]);
+          const Key& cur = node_value(nodes[i]);
+          if (comparator{}(cur, prev) ||
+              (unique && !comparator{}(prev, cur)))
+            throw std::invalid_argument("assign_sorted: elements not sorted");
+        }
+      }
+    } catch (...) {
+      for (NodePtr node : nodes) delete_node(node);
+      throw;
+    }
+    build_from_sorted(nodes);
+  };
+
+  // делит дерево на диапазоны по поддеревьям для параллельного обхода
+  // границами служат узлы верхних уровней в порядке обхода, поэтому
+  // диапазонов не меньше parts и они примерно равны. возвращает границы
+  // от begin() до end(), соседние границы задают диапазон [bounds[i],
+  // bounds[i + 1])
+  std::vector<const_iterator> split(size_type parts) const {
+    size_type depth = 0;
+    while (depth + 1 < std::numeric_limits<size_type>::digits &&
+           (size_type(1) << depth) < parts)
+      ++depth;
+    std::vector<const_iterator> bounds;
+    bounds.push_back(begin());
+    collect_bounds(header_.parent_, depth, bounds);
+    bounds.push_back(end());
+    return bounds;
+  };
+
   //      =============== ВЫВОД ФУНКЦИЙ ===============
 
   // выводит дерево
   void print() noexcept {
-    if (root_->parent_ != nullptr) {
-      print(root_->parent_, "", true);
+    if (header_.parent_ != nullptr) {
+      print(header_.parent_, "", true);
     }
   };
 
@@ -348,7 +536,7 @@ class RBTree {
         indent += "|    ";
       }
       std::string color = (node->color_ == RED) ? "RED" : "BLACK";
-      std::cout << node->data_ << "(" << color << ")" << std::endl;
+      std::cout << node_value(node) << "(" << color << ")" << std::endl;
       print(node->left_, indent, false);
       print(node->right_, indent, true);
     }
@@ -356,18 +544,40 @@ class RBTree {
 
   //      =============== МЕТОДЫ ДЕРЕВА ===============
 
+  // возвращает указатель на конечный узел, встроенный в дерево
+  NodePtr end_node() const noexcept { return const_cast<NodePtr>(&header_); };
+
+  // возвращает данные узла с ключом
+  static reference node_value(NodePtr node) noexcept {
+    return static_cast<RBNode*>(node)->data_;
+  };
+
+  // забирает все узлы другого дерева, другое дерево остается пустым
+  // корень переподвешивается к собственному конечному узлу
+  void take_nodes(RBTree& other) noexcept {
+    header_.parent_ = other.header_.parent_;
+    header_.left_ = other.header_.left_;
+    header_.right_ = other.header_.right_;
+    size_ = other.size_;
+    if (header_.parent_) header_.parent_->parent_ = end_node();
+    other.header_.parent_ = nullptr;
+    other.header_.left_ = nullptr;
+    other.header_.right_ = nullptr;
+    other.size_ = 0;
+  };
+
   // вставляет узел в красно-черное дерево
   // если unique равно true, вставляются только элементы без дубликатов
   // в противном случае: также могут быть вставлены дубликаты
   std::pair<iterator, bool> insert_node(NodePtr new_node, bool unique) {
     // поиск места для вставки узла
-    NodePtr node = root_->parent_;
+    NodePtr node = header_.parent_;
     NodePtr parent = nullptr;
     while (node != nullptr) {
       parent = node;
-      if (comparator{}(new_node->data_, node->data_))
+      if (comparator{}(node_value(new_node), node_value(node)))
         node = node->left_;
-      else if (comparator{}(node->data_, new_node->data_))
+      else if (comparator{}(node_value(node), node_value(new_node)))
         node = node->right_;
       else if (unique == false)
         node =
@@ -376,27 +586,63 @@ class RBTree {
         return {iterator(node), false};  // возвращаем элемент, если наше дерево
                                          // не содержит дубликатов
     }
+    attach_node(new_node, parent,
+                parent != nullptr &&
+                    comparator{}(node_value(new_node), node_value(parent)));
+    return {iterator(new_node), true};
+  };
+
+  // вставляет узел непосредственно перед подсказкой, если это не нарушает
+  // порядок, иначе выполняет обычную вставку
+  std::pair<iterator, bool> insert_node_hint(NodePtr hint, NodePtr new_node,
+                                             bool unique) {
+    const_reference value = node_value(new_node);
+    // значение не больше подсказки (для уникальных - строго меньше)
+    bool before_hint = hint == end_node() ||
+                       comparator{}(value, node_value(hint)) ||
+                       (!unique && !comparator{}(node_value(hint), value));
+    if (size_ > 0 && before_hint) {
+      NodePtr prev = nullptr;
+      if (hint == end_node())
+        prev = header_.right_;
+      else if (hint != header_.left_)
+        prev = hint->predecessor();
+      // значение не меньше предыдущего (для уникальных - строго больше)
+      if (prev == nullptr || comparator{}(node_value(prev), value) ||
+          (!unique && !comparator{}(value, node_value(prev)))) {
+        // у подсказки нет левого ребенка, либо у предыдущего - правого
+        if (hint != end_node() && hint->left_ == nullptr)
+          attach_node(new_node, hint, true);
+        else
+          attach_node(new_node, prev, false);
+        return {iterator(new_node), true};
+      }
+    }
+    return insert_node(new_node, unique);
+  };
+
+  // подвешивает новый узел к родителю и балансирует дерево
+  // если parent равен nullptr, узел становится корнем
+  void attach_node(NodePtr new_node, NodePtr parent, bool left) noexcept {
     // так как вставка происходит, размер увеличивается
     size_++;
     // вставка
     if (parent == nullptr) {  // случай, когда вставляется 1-й элемент (корень)
-      new_node->parent_ = root_;
-      root_->parent_ = new_node;
+      new_node->parent_ = end_node();
+      header_.parent_ = new_node;
       new_node->color_ = BLACK;
     } else {
       new_node->parent_ = parent;
-      comparator{}(new_node->data_, parent->data_) ? parent->left_ = new_node
-                                                   : parent->right_ = new_node;
+      left ? parent->left_ = new_node : parent->right_ = new_node;
     }
     // устанавливаем указатель на максимальный элемент в корневой узел
-    if (!root_->right_ || root_->right_->right_) {
-      root_->right_ = new_node;
+    if (!header_.right_ || header_.right_->right_) {
+      header_.right_ = new_node;
     }
     // устанавливаем указатель на минимальный элемент в корневой узел
-    if (!root_->left_ || root_->left_->left_) root_->left_ = new_node;
+    if (!header_.left_ || header_.left_->left_) header_.left_ = new_node;
     // балансировка после вставки
     balance_insert(new_node);
-    return {iterator(new_node), true};
   };
 
   // освобождает узел и обнуляет все указатели
@@ -405,8 +651,7 @@ class RBTree {
       node->left_ = nullptr;
       node->right_ = nullptr;
       node->parent_ = nullptr;
-      delete node;
-      node = nullptr;
+      delete static_cast<RBNode*>(node);
     }
   };
 
@@ -423,8 +668,8 @@ class RBTree {
     help_node->parent_ = node->parent_;
     // меняем ребенка родителя узла
     // случай, когда узел является 1-м элементом
-    if (node->parent_ == root_) {
-      root_->parent_ = help_node;
+    if (node->parent_ == end_node()) {
+      header_.parent_ = help_node;
     } else if (node == node->parent_->left_) {
       node->parent_->left_ = help_node;
     } else {
@@ -443,8 +688,8 @@ class RBTree {
       help_node->right_->parent_ = node;
     }
     help_node->parent_ = node->parent_;
-    if (root_->parent_ == node) {
-      root_->parent_ = help_node;
+    if (header_.parent_ == node) {
+      header_.parent_ = help_node;
     } else if (node == node->parent_->right_) {
       node->parent_->right_ = help_node;
     } else if (node == node->parent_->left_) {
@@ -478,7 +723,7 @@ class RBTree {
   */
   void balance_insert(NodePtr node) noexcept {
     NodePtr u;
-    while (node->parent_->color_ == RED && node != root_->parent_) {
+    while (node->parent_->color_ == RED && node != header_.parent_) {
       if (node->parent_ == node->parent_->parent_->right_) {
         u = node->parent_->parent_->left_;
         // если цвет дяди тоже красный, то меняем цвета
@@ -517,7 +762,7 @@ class RBTree {
         }
       }
     }
-    root_->parent_->color_ =
+    header_.parent_->color_ =
         BLACK;  // убеждаемся, что корневой узел остается черным
   };
 
@@ -541,8 +786,8 @@ class RBTree {
   void swap_nodes(NodePtr one, NodePtr two) noexcept {
     two == two->parent_->left_ ? two->parent_->left_ = one
                                : two->parent_->right_ = one;
-    if (one == root_->parent_)
-      root_->parent_ = two;
+    if (one == header_.parent_)
+      header_.parent_ = two;
     else
       one == one->parent_->left_ ? one->parent_->left_ = two
                                  : one->parent_->right_ = two;
@@ -559,21 +804,18 @@ class RBTree {
   };
 
   // находит узел с ключом
-  NodePtr find_node(const_reference key) const noexcept {
-    NodePtr ptr = root_->parent_;
+  template <typename K>
+  NodePtr find_node(const K& key) const noexcept {
+    NodePtr ptr = header_.parent_;
     while (ptr) {
-      if (ptr->data_ == key) return ptr;
-      if (comparator{}(ptr->data_, key))
+      if (comparator{}(node_value(ptr), key))
         ptr = ptr->right_;
-      else
+      else if (comparator{}(key, node_value(ptr)))
         ptr = ptr->left_;
+      else
+        return ptr;
     }
-    return root_;
-  };
-
-  NodePtr find_node(iterator pos) const noexcept {
-    NodePtr res = find_node(*pos);
-    return res;
+    return end_node();
   };
 
   // удаление узла
@@ -606,19 +848,20 @@ class RBTree {
       balance_delete(node);
     }
     // если узел - первый элемент
-    if (root_->parent_ == node) {
-      root_->parent_ = nullptr;
-      root_->right_ = nullptr;
-      root_->left_ = nullptr;
+    if (header_.parent_ == node) {
+      header_.parent_ = nullptr;
+      header_.right_ = nullptr;
+      header_.left_ = nullptr;
     } else {
       // иначе удаляем указатель на узел у его родителя
       node->parent_->left_ == node ? node->parent_->left_ = nullptr
                                    : node->parent_->right_ = nullptr;
       // если узел - минимальный элемент в дереве, мы изменяем его на другой
       // элемент
-      if (root_->left_ == node) root_->left_ = search_left(root_->parent_);
+      if (header_.left_ == node) header_.left_ = search_left(header_.parent_);
       // то же самое для случая, когда это максимальный элемент
-      if (root_->right_ == node) root_->right_ = search_right(root_->parent_);
+      if (header_.right_ == node)
+        header_.right_ = search_right(header_.parent_);
     }
     // удаление
     delete_node(node);
@@ -629,7 +872,7 @@ class RBTree {
   // Извлекает узел из дерева, чтобы переместить его в другое место
   // Процесс аналогичен удалению, но узел не удаляется
   NodePtr merge_node(NodePtr node) {
-    if (node != root_) {  // нельзя извлечь корень
+    if (node != end_node()) {  // нельзя извлечь корень
       if (node->right_ && node->left_) {
         NodePtr swap = search_right(node->left_);
         swap_nodes(node, swap);
@@ -638,14 +881,19 @@ class RBTree {
       if (node->left_ && !node->right_) swap_nodes(node, node->left_);
       if (node->color_ == BLACK && (!node->right_ && !node->left_))
         balance_delete(node);
-      if (root_->left_ == node) root_->left_ = node->successor();
-      if (root_->right_ == node) root_->right_ = node->predecessor();
-      if (root_->parent_ == node)
-        root_->parent_ = nullptr;
+      if (header_.left_ == node) header_.left_ = node->successor();
+      if (header_.right_ == node) header_.right_ = node->predecessor();
+      if (header_.parent_ == node)
+        header_.parent_ = nullptr;
       else
         node->parent_->left_ == node ? node->parent_->left_ = nullptr
                                      : node->parent_->right_ = nullptr;
       size_--;
+      // последний узел извлечен, дерево снова пустое
+      if (size_ == 0) {
+        header_.left_ = nullptr;
+        header_.right_ = nullptr;
+      }
       node->left_ = nullptr;
       node->right_ = nullptr;
       node->parent_ = nullptr;
@@ -669,7 +917,7 @@ class RBTree {
   */
   void balance_delete(NodePtr node) {
     NodePtr s = nullptr;  // сиблинг
-    while (node != root_->parent_ && node->color_ == BLACK) {
+    while (node != header_.parent_ && node->color_ == BLACK) {
       if (node == node->parent_->left_) {
         s = node->parent_->right_;
         if (s->color_ == RED) {  // случай 1
@@ -730,7 +978,7 @@ class RBTree {
         }
       }
     }
-    root_->parent_->color_ = BLACK;
+    header_.parent_->color_ = BLACK;
   };
 
   // рекурсивное удаление содержимого дерева
@@ -741,9 +989,76 @@ class RBTree {
     delete_node(node);
   };
 
+  // возвращает узлы дерева в порядке возрастания
+  std::vector<NodePtr> collect_nodes() const {
+    std::vector<NodePtr> nodes;
+    nodes.reserve(size_);
+    for (NodePtr node = begin().node_; node != end_node();
+         node = node->successor())
+      nodes.push_back(node);
+    return nodes;
+  };
+
+  // добавляет в bounds узлы на глубине меньше depth в порядке обхода
+  void collect_bounds(NodePtr node, size_type depth,
+                      std::vector<const_iterator>& bounds) const {
+    if (node == nullptr || depth == 0) return;
+    collect_bounds(node->left_, depth - 1, bounds);
+    bounds.push_back(const_iterator(iterator(node)));
+    collect_bounds(node->right_, depth - 1, bounds);
+  };
+
+  // строит сбалансированное дерево из отсортированных узлов за O(n)
+  // узлы не копируются, поэтому итераторы на них остаются действительными
+  void build_from_sorted(const std::vector<NodePtr>& nodes) noexcept {
+    size_ = nodes.size();
+    if (size_ == 0) {
+      header_.parent_ = nullptr;
+      header_.left_ = nullptr;
+      header_.right_ = nullptr;
+      return;
+    }
+    NodePtr root = build_subtree(nodes, 0, size_, 0, floor_log2(size_));
+    root->parent_ = end_node();
+    root->color_ = BLACK;
+    header_.parent_ = root;
+    header_.left_ = nodes.front();
+    header_.right_ = nodes.back();
+  };
+
+  /*
+      Строит поддерево из узлов [begin, end) делением пополам.
+      Все пустые потомки при таком делении находятся на глубине D или D + 1,
+      где D - глубина самого нижнего уровня. Если окрасить уровень D в красный,
+      а остальные в черный, на каждом пути будет D черных узлов
+  */
+  NodePtr build_subtree(const std::vector<NodePtr>& nodes, size_type begin,
+                        size_type end, size_type depth,
+                        size_type red_depth) noexcept {
+    if (begin >= end) return nullptr;
+    size_type mid = begin + (end - begin) / 2;
+    NodePtr node = nodes[mid];
+    node->color_ = depth == red_depth ? RED : BLACK;
+    node->left_ = build_subtree(nodes, begin, mid, depth + 1, red_depth);
+    node->right_ = build_subtree(nodes, mid + 1, end, depth + 1, red_depth);
+    if (node->left_) node->left_->parent_ = node;
+    if (node->right_) node->right_->parent_ = node;
+    return node;
+  };
+
+  // округленный вниз двоичный логарифм
+  static size_type floor_log2(size_type n) noexcept {
+    size_type res = 0;
+    while (n > 1) {
+      n >>= 1;
+      res++;
+    }
+    return res;
+  };
+
   // рекурсивное копирование содержимого дерева
   NodePtr copy(NodePtr copy_node, NodePtr parent) {
-    NodePtr new_node = new RBNode(copy_node);
+    NodePtr new_node = new RBNode(static_cast<RBNode*>(copy_node));
     if (copy_node->left_) new_node->left_ = copy(copy_node->left_, new_node);
     if (copy_node->right_) new_node->right_ = copy(copy_node->right_, new_node);
     new_node->parent_ = parent;
@@ -752,42 +1067,15 @@ class RBTree {
 
   //      =============== КЛАСС УЗЛА ===============
 
-  // Класс узла
-  class RBNode {
+  // Базовый класс узла: только цвет и связи, без данных
+  // из него состоит конечный узел, поэтому тип Key не обязан иметь
+  // конструктор по умолчанию
+  class RBNodeBase {
    public:
     // конструктор по умолчанию
-    RBNode()
-        : data_(Key{}),
-          color_(RED),
-          parent_(nullptr),
-          left_(nullptr),
-          right_(nullptr) {};
-
-    // конструктор с значением
-    RBNode(const Key& value)
-        : data_(value),
-          color_(RED),
-          parent_(nullptr),
-          left_(nullptr),
-          right_(nullptr) {};
-
-    // конструктор перемещения
-    RBNode(const Key&& value)
-        : data_(std::move(value)),
-          color_(RED),
-          parent_(nullptr),
-          left_(nullptr),
-          right_(nullptr) {};
+    RBNodeBase()
+        : color_(RED), parent_(nullptr), left_(nullptr), right_(nullptr) {};
 
-    // копирует узел
-    RBNode(RBNode* node)
-        : data_(node->data_),
-          color_(node->color_),
-          parent_(nullptr),
-          left_(nullptr),
-          right_(nullptr) {};
-
-    Key data_;
     NodeColor color_;
     NodePtr parent_;
     NodePtr left_;
@@ -843,6 +1131,22 @@ class RBTree {
     };
   };
 
+  // Класс узла с данными
+  class RBNode : public RBNodeBase {
+   public:
+    // создает данные прямо в узле из переданных аргументов
+    template <typename... Args>
+    explicit RBNode(Args&&... args)
+        : RBNodeBase(), data_(std::forward<Args>(args)...) {};
+
+    // копирует узел
+    RBNode(RBNode* node) : RBNodeBase(), data_(node->data_) {
+      this->color_ = node->color_;
+    };
+
+    Key data_;
+  };
+
   //      =============== КЛАСС ИТЕРАТОРА ===============
 
   class RBIterator {
@@ -856,7 +1160,7 @@ class RBTree {
     RBIterator(NodePtr node) : node_(node) {};
 
     // перегрузка * возвращает данные
-    reference operator*() noexcept { return node_->data_; };
+    reference operator*() noexcept { return node_value(node_); };
 
     // перегрузка; проверяет, одинаковы ли узлы
     bool operator==(const iterator& other) noexcept {
@@ -909,7 +1213,7 @@ class RBTree {
 
     RBConstIterator(const iterator& other) { node_ = other.node_; };
 
-    const_reference operator*() const noexcept { return node_->data_; };
+    const_reference operator*() const noexcept { return node_value(node_); };
 
     const_iterator operator++() noexcept {
       node_ = node_->successor();
@@ -946,9 +1250,68 @@ class RBTree {
     };
   };
 
+  //      =============== КЛАСС ИЗВЛЕЧЕННОГО УЗЛА ===============
+
+  // Владеет узлом, извлеченным из дерева. Только перемещается,
+  // при уничтожении освобождает узел, если тот не был вставлен обратно
+  class RBNodeHandle {
+    friend RBTree;
+
+   public:
+    // конструктор по умолчанию, создает пустой объект
+    RBNodeHandle() noexcept : node_(nullptr) {};
+
+    // конструктор перемещения
+    RBNodeHandle(RBNodeHandle&& other) noexcept : node_(other.node_) {
+      other.node_ = nullptr;
+    };
+
+    // перегрузка оператора перемещения
+    RBNodeHandle& operator=(RBNodeHandle&& other) noexcept {
+      if (this != &other) {
+        reset();
+        std::swap(node_, other.node_);
+      }
+      return *this;
+    };
+
+    RBNodeHandle(const RBNodeHandle&) = delete;
+    RBNodeHandle& operator=(const RBNodeHandle&) = delete;
+
+    // деструктор
+    ~RBNodeHandle() { reset(); };
+
+    // проверяет, пуст ли объект
+    bool empty() const noexcept { return node_ == nullptr; };
+
+    explicit operator bool() const noexcept { return node_ != nullptr; };
+
+    // возвращает данные узла
+    reference value() const noexcept { return node_value(node_); };
+
+   private:
+    // конструктор с параметром узла
+    explicit RBNodeHandle(NodePtr node) noexcept : node_(node) {};
+
+    // освобождает узел
+    void reset() noexcept {
+      delete static_cast<RBNode*>(node_);
+      node_ = nullptr;
+    };
+
+    NodePtr node_;
+  };
+
+  // Результат вставки извлеченного узла
+  struct RBInsertReturn {
+    iterator position;
+    bool inserted;
+    node_type node;
+  };
+
   //      =============== ПЕРЕМЕННЫЕ ДЕРЕВА ===============
-  NodePtr root_;    // конечный элемент
-  size_type size_;  // количество элементов
+  RBNodeBase header_;  // конечный элемент
+  size_type size_;     // количество элементов
 };
 }  // namespace s21
 
@@ -1,8 +1,21 @@
 #ifndef S21_VECTOR_H_
 #define S21_VECTOR_H_
+#include <cstring>
 #include <initializer_list>
 #include <iostream>
 #include <limits>
+#include <new>
+#include <type_traits>
+
+// На Linux вектор может хранить элементы в анонимном отображении памяти и
+// расти через mremap без копирования
+#if defined(__linux__)
+#define S21_VECTOR_MMAP 1
+#include <sys/mman.h>
+#include <unistd.h>
+#else
+#define S21_VECTOR_MMAP 0
+#endif
 
 namespace s21 {
 template <typename T>
@@ -22,7 +35,7 @@ class vector {
   using size_type = std::size_t;  // size_t определяет тип размера контейнера
 
   // Констуруктор по умолчанию
-  vector() : m_size(0), m_capacity(0), arr(nullptr) {}
+  vector() : m_size(0), m_capacity(0), arr(nullptr), m_mapped(false) {}
   // Конструктор с параметрами
   explicit vector(size_type n) : vector() {
     m_size = m_capacity = n;
@@ -41,28 +54,36 @@ class vector {
     }
   }
   // Конструктор копирования
+  // Копия хранится в памяти того же вида, что и оригинал
   vector(const vector &v)
       : m_size(v.m_size),
         m_capacity(v.m_capacity),
-        arr(new value_type[m_capacity]) {
+        arr(nullptr),
+        m_mapped(v.m_mapped) {
+    arr = allocate(m_capacity);
     for (size_type i = 0; i < m_size; i++) {
       arr[i] = v.arr[i];
     }
   }
   // Конструктор перемещения
-  vector(vector &&v) : vector() { operator=(std::move(v)); }
+  vector(vector &&v) noexcept : vector() { operator=(std::move(v)); }
   // Деструктор
-  ~vector() { delete[] arr; }
+  ~vector() { deallocate(); }
 
   // Перегрузка оператора присваивания
   vector &operator=(vector &&v) noexcept {
     if (this != &v) {
-      delete[] arr;
+      deallocate();
       m_size = v.m_size;
       m_capacity = v.m_capacity;
       arr = v.arr;
+      m_mapped = v.m_mapped;
 
-      v = vector();
+      // обнуляем поля напрямую: присваивание v = vector() вызывало бы этот же
+      // оператор бесконечно
+      v.m_size = 0;
+      v.m_capacity = 0;
+      v.arr = nullptr;
     }
     return *this;
   }
@@ -146,6 +167,64 @@ class vector {
 
     return begin() + index;  // Возвращаем итератор на вставленный элемент
   }
+  // Вставка нескольких элементов перед pos и возвращение итератора на первый
+  // из них. Память резервируется один раз, хвост сдвигается один раз сразу на
+  // количество аргументов. Аргументы могут ссылаться на элементы самого
+  // вектора: при расширении они записываются в новый массив до того, как
+  // старый освобождается, а без расширения сначала копируются во временные
+  // объекты, потому что сдвиг хвоста их перезаписывает
+  template <typename... Args>
+  iterator insert_many(const_iterator pos, Args &&...args) {
+    if (pos < begin() || pos > end()) {
+      throw std::out_of_range("Iterator out of range");
+    }
+    size_type index = pos - begin();
+    if constexpr (sizeof...(args) > 0) {
+      constexpr size_type count = sizeof...(args);
+      if (m_size + count > m_capacity && !m_mapped) {
+        size_type size = m_capacity * 2 > m_size + count ? m_capacity * 2
+                                                         : m_size + count;
+        if (size > max_size()) {
+          throw std::length_error("Overflow! Enter a smaller size!");
+        }
+        iterator temp = new value_type[size];
+        try {
+          size_type i = index;
+          ((temp[i++] = std::forward<Args>(args)), ...);
+        } catch (...) {
+          delete[] temp;
+          throw;
+        }
+        for (size_type i = 0; i < index; ++i) temp[i] = std::move(arr[i]);
+        for (size_type i = index; i < m_size; ++i) {
+          temp[i + count] = std::move(arr[i]);
+        }
+        delete[] arr;
+        arr = temp;
+        m_capacity = size;
+      } else {
+        value_type staged[] = {value_type(std::forward<Args>(args))...};
+        if (m_size + count > m_capacity) {
+          reserve(m_capacity * 2 > m_size + count ? m_capacity * 2
+                                                  : m_size + count);
+        }
+        // Перемещаем элементы вправо сразу на count позиций
+        for (size_type i = m_size; i > index; --i) {
+          arr[i - 1 + count] = std::move(arr[i - 1]);
+        }
+        for (size_type i = 0; i < count; ++i) {
+          arr[index + i] = std::move(staged[i]);
+        }
+      }
+      m_size += count;
+    }
+    return begin() + index;
+  }
+  // Добавление нескольких элементов в конец вектора
+  template <typename... Args>
+  void insert_many_back(Args &&...args) {
+    insert_many(end(), std::forward<Args>(args)...);
+  }
   // Удаление элемента по позиции
   void erase(iterator pos) {
     if (pos < begin() || pos > end()) {
@@ -160,6 +239,22 @@ class vector {
     }
     --m_size;
   }
+  // Удаление элементов в диапазоне [first, last) одним сдвигом хвоста
+  iterator erase(const_iterator first, const_iterator last) {
+    if (first < begin() || last > end() || first > last) {
+      throw std::out_of_range("Iterator out of range");
+    }
+    size_type index = first - begin();
+    size_type count = last - first;
+    if (count > 0) {
+      // Перемещаем элементы влево сразу на count позиций
+      for (size_type i = index; i + count < m_size; ++i) {
+        arr[i] = std::move(arr[i + count]);
+      }
+      m_size -= count;
+    }
+    return begin() + index;
+  }
   // Добавление элемента в конец вектора
   void push_back(const_reference value) { insert(end(), value); }
   // Удаление последнего элемента
@@ -174,6 +269,7 @@ class vector {
     std::swap(m_size, other.m_size);
     std::swap(m_capacity, other.m_capacity);
     std::swap(arr, other.arr);
+    std::swap(m_mapped, other.m_mapped);
   }
 
   // Vector Capacity
@@ -202,22 +298,63 @@ class vector {
   // Возвращает текущую емкость вектора
   size_type capacity() const noexcept { return m_capacity; }
 
-  // Сокращает емкость вектора до его размера
+  // Сокращает емкость вектора до его размера. В отображенной памяти
+  // страницы за последним элементом возвращаются системе через madvise, а
+  // емкость и адреса элементов не меняются
   void shrink_to_fit() {
     if (m_capacity > m_size) {
-      memory_allocation(m_size);
+      if (m_mapped) {
+        release_unused_pages();
+      } else {
+        memory_allocation(m_size);
+      }
+    }
+  }
+
+  // Переводит хранение элементов в анонимное отображение памяти (mmap) или
+  // обратно в кучу. В отображении вектор растет через mremap: страницы
+  // переносятся без копирования элементов и без удвоения пиковой памяти,
+  // для больших буферов включаются прозрачные огромные страницы. Доступно
+  // только на Linux и только для тривиально копируемых T, иначе ничего не
+  // меняет. Возвращает, хранится ли вектор в отображении
+  bool use_mapped_storage(bool enable = true) {
+    if constexpr (kMappable) {
+      if (enable != m_mapped) {
+        T *temp = m_capacity ? allocate_as(m_capacity, enable) : nullptr;
+        if (m_size > 0) std::memcpy(temp, arr, m_size * sizeof(T));
+        deallocate();
+        arr = temp;
+        m_mapped = enable;
+        if (m_mapped) m_capacity = mapped_capacity(m_capacity);
+      }
     }
+    return m_mapped;
   }
 
+  // Проверяет, хранится ли вектор в отображении памяти
+  bool uses_mapped_storage() const noexcept { return m_mapped; }
+
  private:
   size_type m_size;  // переменная для хранения текущего количества элементов
                      // в векторе
   size_type m_capacity;  // переменная, которая хранит текущую емкость вектора
   T *arr;  // указатель на массив, который хранит элементы вектора
+  bool m_mapped;  // элементы лежат в отображении mmap, а не в куче
+
+  // Отображение допустимо, если элементы можно переносить побайтно
+  static constexpr bool kMappable = S21_VECTOR_MMAP &&
+                                    std::is_trivially_copyable_v<T> &&
+                                    std::is_trivially_destructible_v<T>;
+  // Начиная с этого размера отображению советуются огромные страницы
+  static constexpr size_type kHugePageBytes = size_type(2) << 20;
 
   // Перераспределяет память для увеличения ёмкости вектора, перемещая
-  // существующие элементы в новый массив
+  // существующие элементы в новый массив. Отображение расширяется на месте
   void memory_allocation(size_type size) {
+    if (m_mapped) {
+      grow_mapping(size);
+      return;
+    }
     iterator temp = new value_type[size];
     for (size_type i = 0; i < m_size; ++i) {
       temp[i] = std::move(arr[i]);
@@ -226,8 +363,109 @@ class vector {
     arr = temp;
     m_capacity = size;
   }
+
+  // Выделяет память под count элементов в текущем режиме хранения
+  T *allocate(size_type count) { return allocate_as(count, m_mapped); }
+
+  T *allocate_as(size_type count, bool mapped) {
+    if (!mapped) return new value_type[count];
+    if (count == 0) return nullptr;
+#if S21_VECTOR_MMAP
+    size_type bytes = mapped_bytes(count);
+    void *pages = mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (pages == MAP_FAILED) throw std::bad_alloc();
+    advise_huge_pages(pages, bytes);
+    return static_cast<T *>(pages);
+#else
+    throw std::bad_alloc();
+#endif
+  }
+
+  // Освобождает текущий массив
+  void deallocate() noexcept {
+    if (!m_mapped) {
+      delete[] arr;
+#if S21_VECTOR_MMAP
+    } else if (arr != nullptr) {
+      munmap(arr, mapped_bytes(m_capacity));
+#endif
+    }
+  }
+
+#if S21_VECTOR_MMAP
+  static size_type page_size() noexcept {
+    static const size_type size = size_type(sysconf(_SC_PAGESIZE));
+    return size;
+  }
+
+  // Размер отображения для count элементов, кратный странице
+  static size_type mapped_bytes(size_type count) noexcept {
+    size_type page = page_size();
+    return (count * sizeof(T) + page - 1) / page * page;
+  }
+
+  // Емкость отображения: сколько элементов помещается в его страницы
+  static size_type mapped_capacity(size_type count) noexcept {
+    return mapped_bytes(count) / sizeof(T);
+  }
+
+  static void advise_huge_pages(void *pages, size_type bytes) noexcept {
+#ifdef MADV_HUGEPAGE
+    if (bytes >= kHugePageBytes) madvise(pages, bytes, MADV_HUGEPAGE);
+#else
+    (void)pages;
+    (void)bytes;
+#endif
+  }
+
+  // Расширяет отображение до size элементов. mremap переносит страницы
+  // целиком, поэтому элементы не копируются
+  void grow_mapping(size_type size) {
+    if (arr == nullptr) {
+      arr = allocate(size);
+    } else {
+      size_type old_bytes = mapped_bytes(m_capacity);
+      size_type new_bytes = mapped_bytes(size);
+      void *pages = mremap(arr, old_bytes, new_bytes, MREMAP_MAYMOVE);
+      if (pages == MAP_FAILED) throw std::bad_alloc();
+      advise_huge_pages(pages, new_bytes);
+      arr = static_cast<T *>(pages);
+    }
+    m_capacity = mapped_capacity(size);
+  }
+
+  // Возвращает системе целые страницы за последним элементом
+  void release_unused_pages() noexcept {
+    size_type used = mapped_bytes(m_size);
+    size_type total = mapped_bytes(m_capacity);
+    if (used < total)
+      madvise(reinterpret_cast<char *>(arr) + used, total - used,
+              MADV_DONTNEED);
+  }
+#else
+  static size_type mapped_capacity(size_type count) noexcept { return count; }
+  void grow_mapping(size_type) {}
+  void release_unused_pages() noexcept {}
+#endif
 };
 
+// Удаляет из вектора все элементы, удовлетворяющие предикату, за один
+// проход: оставшиеся элементы сдвигаются на место удаленных
+template <typename T, typename Pred>
+std::size_t erase_if(vector<T> &container, Pred pred) {
+  auto write = container.begin();
+  for (auto it = container.begin(); it != container.end(); ++it) {
+    if (!pred(*it)) {
+      if (write != it) *write = std::move(*it);
+      ++write;
+    }
+  }
+  std::size_t removed = container.end() - write;
+  container.erase(write, container.end());
+  return removed;
+}
+
 }  // namespace s21
 
 #endif
\ No newline at end of file
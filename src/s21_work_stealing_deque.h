@@ -0,0 +1,174 @@
+#ifndef S21_WORK_STEALING_DEQUE_H_
+#define S21_WORK_STEALING_DEQUE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+/*
+    Реализация деки с кражей работы (Chase, Lev)
+    work_stealing_deque - очередь задач одного рабочего потока. Владелец
+   кладет и забирает задачи с нижнего конца без CAS, кроме случая, когда
+   остался последний элемент, а другие потоки крадут с верхнего конца
+   одним CAS. Элементы лежат в кольцевом массиве степени двойки, который
+   владелец удваивает при заполнении. Старые массивы хранятся до
+   разрушения деки, потому что вор мог успеть взять на них указатель:
+   вместе они занимают не больше нового массива. Порядок памяти взят из
+   работы Lê, Pop, Cohen, Zappa Nardelli (PPoPP 2013). Элемент читается
+   вором до CAS и может быть в это время перезаписан, поэтому T должен
+   быть тривиально копируемым: обычно это указатель на задачу.
+*/
+
+namespace s21 {
+
+template <typename T>
+class work_stealing_deque {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "work_stealing_deque stores only trivially copyable types");
+
+ public:
+  using value_type = T;
+  using size_type = std::size_t;
+
+  // capacity округляется вверх до степени двойки
+  explicit work_stealing_deque(size_type capacity = 64)
+      : top_(0), bottom_(0) {
+    size_type size = 2;
+    while (size < capacity) size *= 2;
+    arrays_.emplace_back(new ring(size));
+    array_.store(arrays_.back().get(), std::memory_order_relaxed);
+  }
+
+  work_stealing_deque(const work_stealing_deque &) = delete;
+  work_stealing_deque &operator=(const work_stealing_deque &) = delete;
+
+  // Приблизительно: при параллельных операциях ответ мог устареть
+  size_type size() const noexcept {
+    std::int64_t bottom = bottom_.load(std::memory_order_relaxed);
+    std::int64_t top = top_.load(std::memory_order_relaxed);
+    return bottom > top ? size_type(bottom - top) : 0;
+  }
+  bool empty() const noexcept { return size() == 0; }
+
+  // Owner
+
+  // Кладет элемент снизу. Вызывает только владелец
+  void push(const T &value) {
+    std::int64_t bottom = bottom_.load(std::memory_order_relaxed);
+    std::int64_t top = top_.load(std::memory_order_acquire);
+    ring *items = array_.load(std::memory_order_relaxed);
+    if (bottom - top > std::int64_t(items->mask)) items = grow(top, bottom);
+    items->put(bottom, value);
+    bottom_.store(bottom + 1, std::memory_order_release);
+  }
+
+  // Забирает последний положенный элемент. Вызывает только владелец
+  std::optional<T> pop() {
+    std::int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+    ring *items = array_.load(std::memory_order_relaxed);
+    bottom_.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    std::int64_t top = top_.load(std::memory_order_relaxed);
+    if (top > bottom) {
+      bottom_.store(bottom + 1, std::memory_order_relaxed);
+      return std::nullopt;
+    }
+    std::optional<T> value(items->get(bottom));
+    if (top == bottom) {
+      // последний элемент разыгрывается с ворами
+      if (!top_.compare_exchange_strong(top, top + 1,
+                                        std::memory_order_seq_cst,
+                                        std::memory_order_relaxed)) {
+        value.reset();
+      }
+      bottom_.store(bottom + 1, std::memory_order_relaxed);
+    }
+    return value;
+  }
+
+  // Thieves
+
+  // Крадет самый старый элемент. Пустой optional, если дека пуста или
+  // элемент перехватил другой поток
+  std::optional<T> steal() {
+    std::int64_t top = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    std::int64_t bottom = bottom_.load(std::memory_order_acquire);
+    if (top >= bottom) return std::nullopt;
+    return claim(top);
+  }
+
+  // Крадет до половины элементов, но не больше max, в out по порядку
+  // от старых к новым. Каждый элемент забирается своим CAS: захват
+  // диапазона одним CAS мог бы пересечься с pop владельца, который
+  // обходится без CAS. Останавливается на первом проигранном CAS.
+  // Возвращает число украденных
+  size_type steal_half(T *out, size_type max) {
+    std::int64_t top = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    std::int64_t bottom = bottom_.load(std::memory_order_acquire);
+    if (top >= bottom) return 0;
+    size_type wanted = size_type(bottom - top + 1) / 2;
+    if (wanted > max) wanted = max;
+    size_type taken = 0;
+    while (taken < wanted) {
+      std::optional<T> value = taken == 0 ? claim(top) : steal();
+      if (!value) break;
+      out[taken++] = *value;
+    }
+    return taken;
+  }
+
+ private:
+  struct ring {
+    explicit ring(size_type size)
+        : mask(size - 1), items(new std::atomic<T>[size]) {}
+
+    T get(std::int64_t index) const noexcept {
+      return items[size_type(index) & mask].load(std::memory_order_relaxed);
+    }
+    void put(std::int64_t index, const T &value) noexcept {
+      items[size_type(index) & mask].store(value, std::memory_order_relaxed);
+    }
+
+    size_type mask;
+    std::unique_ptr<std::atomic<T>[]> items;
+  };
+
+  // top_ и bottom_ на разных кеш-линиях: первый меняют воры, второй
+  // владелец
+  alignas(64) std::atomic<std::int64_t> top_;
+  alignas(64) std::atomic<std::int64_t> bottom_;
+  std::atomic<ring *> array_;
+  // Все массивы, текущий последний. Меняется только владельцем
+  std::vector<std::unique_ptr<ring>> arrays_;
+
+  // Забирает элемент top, если его никто не забрал раньше
+  std::optional<T> claim(std::int64_t top) {
+    ring *items = array_.load(std::memory_order_acquire);
+    T value = items->get(top);
+    if (!top_.compare_exchange_strong(top, top + 1,
+                                      std::memory_order_seq_cst,
+                                      std::memory_order_relaxed)) {
+      return std::nullopt;
+    }
+    return value;
+  }
+
+  ring *grow(std::int64_t top, std::int64_t bottom) {
+    ring *old = array_.load(std::memory_order_relaxed);
+    std::unique_ptr<ring> bigger(new ring((old->mask + 1) * 2));
+    for (std::int64_t i = top; i < bottom; ++i) bigger->put(i, old->get(i));
+    arrays_.push_back(std::move(bigger));
+    array_.store(arrays_.back().get(), std::memory_order_release);
+    return arrays_.back().get();
+  }
+};
+
+}  // namespace s21
+
+#endif
@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <string>
+
+#include "../s21_containers.h"
+#include "../s21_containersplus.h"
+
+namespace {
+
+const s21::simd::isa kLevels[] = {s21::simd::isa::scalar,
+                                  s21::simd::isa::sse2, s21::simd::isa::avx2};
+
+// Прогоняет проверку на всех наборах инструкций, которые есть у процессора
+template <typename F>
+void for_each_isa(F check) {
+  for (s21::simd::isa level : kLevels) {
+    s21::simd::set_isa(level);
+    check();
+  }
+  s21::simd::set_isa(s21::simd::detected_isa());
+}
+
+template <typename T>
+s21::vector<T> random_vector(std::size_t n, int range, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<int> dist(-range, range);
+  s21::vector<T> result;
+  for (std::size_t i = 0; i < n; ++i) result.push_back(T(dist(gen)));
+  return result;
+}
+
+template <typename T>
+void check_against_std() {
+  for (std::size_t n = 0; n < 70; ++n) {
+    s21::vector<T> v = random_vector<T>(n, 20, n);
+    const T *first = v.data(), *last = v.data() + v.size();
+    for (int value = -21; value <= 21; value += 7) {
+      EXPECT_EQ(s21::find(first, last, T(value)),
+                std::find(first, last, T(value)));
+      EXPECT_EQ(s21::count(first, last, T(value)),
+                std::size_t(std::count(first, last, T(value))));
+    }
+    EXPECT_EQ(s21::min_element(first, last), std::min_element(first, last));
+    EXPECT_EQ(s21::max_element(first, last), std::max_element(first, last));
+    EXPECT_EQ(s21::sum(v), std::accumulate(first, last,
+                                           typename s21::simd::traits<T>::
+                                               sum_type()));
+  }
+}
+
+}  // namespace
+
+TEST(ALGORITHM, matchesStdInt) {
+  for_each_isa(check_against_std<std::int32_t>);
+}
+
+TEST(ALGORITHM, matchesStdFloat) { for_each_isa(check_against_std<float>); }
+
+TEST(ALGORITHM, matchesStdDouble) { for_each_isa(check_against_std<double>); }
+
+TEST(ALGORITHM, sumInt32Widens) {
+  for_each_isa([] {
+    s21::vector<std::int32_t> v(37);
+    s21::fill(v, INT32_MAX);
+    EXPECT_EQ(s21::sum(v), std::int64_t(INT32_MAX) * 37);
+  });
+}
+
+TEST(ALGORITHM, fillAndEqual) {
+  for_each_isa([] {
+    s21::vector<double> a(45), b(45);
+    s21::fill(a, 2.5);
+    s21::fill(b.data(), b.data() + b.size(), 2.5);
+    EXPECT_EQ(s21::count(a, 2.5), 45U);
+    EXPECT_TRUE(s21::equal(a, b));
+    b[44] = 0.0;
+    EXPECT_FALSE(s21::equal(a, b));
+    b[44] = 2.5;
+    b[3] = -1.0;
+    EXPECT_FALSE(s21::equal(a, b));
+    b.pop_back();
+    EXPECT_FALSE(s21::equal(a, b));
+  });
+}
+
+TEST(ALGORITHM, array) {
+  for_each_isa([] {
+    s21::array<float, 11> arr = {3, 1, 4, 1, 5, 9, 2, 6, 5, 3, 5};
+    EXPECT_EQ(s21::find(arr, 9.0f), arr.data() + 5);
+    EXPECT_EQ(s21::find(arr, 7.0f), arr.data() + arr.size());
+    EXPECT_EQ(s21::min_element(arr), arr.data() + 1);
+    EXPECT_EQ(s21::max_element(arr), arr.data() + 5);
+    EXPECT_EQ(s21::count(arr, 5.0f), 3U);
+    EXPECT_FLOAT_EQ(s21::sum(arr), 44.0f);
+  });
+}
+
+TEST(ALGORITHM, genericType) {
+  s21::vector<std::string> v = {"a", "b", "c"};
+  EXPECT_EQ(s21::find(v, "b"), v.data() + 1);
+  EXPECT_EQ(s21::count(v, std::string("c")), 1U);
+  s21::fill(v, std::string("z"));
+  EXPECT_EQ(*s21::max_element(v), "z");
+}
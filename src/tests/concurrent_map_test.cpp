@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+
+#include <functional>
+#include <optional>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "../s21_containersplus.h"
+
+TEST(ConcurrentMap, matchesUnorderedMap) {
+  s21::concurrent_map<int, std::string> map(4);
+  EXPECT_EQ(map.shard_count(), 4u);
+  std::unordered_map<int, std::string> expected;
+  std::mt19937 gen(9);
+  for (int i = 0; i < 30000; ++i) {
+    int key = int(gen() % 3000);
+    if (gen() % 3 == 0) {
+      EXPECT_EQ(map.erase(key), expected.erase(key));
+    } else {
+      bool added = expected.count(key) == 0;
+      expected[key] = std::to_string(i);
+      EXPECT_EQ(map.insert_or_assign(key, std::to_string(i)), added);
+    }
+  }
+  ASSERT_EQ(map.size(), expected.size());
+  for (int key = 0; key < 3000; ++key) {
+    auto it = expected.find(key);
+    std::optional<std::string> found = map.find(key);
+    EXPECT_EQ(found.has_value(), it != expected.end());
+    if (found && it != expected.end()) {
+      EXPECT_EQ(*found, it->second);
+    }
+    EXPECT_EQ(map.contains(key), it != expected.end());
+  }
+  map.clear();
+  EXPECT_TRUE(map.empty());
+  EXPECT_FALSE(map.find(1).has_value());
+}
+
+TEST(ConcurrentMap, batchesAndUpdates) {
+  s21::concurrent_map<int, int> map(8);
+  std::vector<std::pair<const int, int>> items;
+  for (int i = 0; i < 1000; ++i) items.emplace_back(i, i * 10);
+  // повтор ключа в пакете: побеждает последняя пара
+  items.emplace_back(5, -1);
+  map.multi_put(items.data(), items.size());
+  EXPECT_EQ(map.size(), 1000u);
+
+  std::vector<int> keys = {5, 999, 1000, 0, -3};
+  std::vector<std::optional<int>> out(keys.size());
+  map.multi_get(keys.data(), keys.size(), out.data());
+  EXPECT_EQ(out[0], std::optional<int>(-1));
+  EXPECT_EQ(out[1], std::optional<int>(9990));
+  EXPECT_FALSE(out[2].has_value());
+  EXPECT_EQ(out[3], std::optional<int>(0));
+  EXPECT_FALSE(out[4].has_value());
+
+  EXPECT_TRUE(map.update(7, [](int &value) { value += 3; }));
+  EXPECT_FALSE(map.update(-7, [](int &value) { value += 3; }));
+  EXPECT_EQ(map.find(7), std::optional<int>(73));
+}
+
+namespace {
+
+// Хешер и сравнение с состоянием: ключи равны по модулю
+struct modulo_hash {
+  explicit modulo_hash(int m) : modulus(m) {}
+  std::size_t operator()(int key) const {
+    return std::hash<int>{}(key % modulus);
+  }
+  int modulus;
+};
+
+struct modulo_equal {
+  explicit modulo_equal(int m) : modulus(m) {}
+  bool operator()(int a, int b) const { return a % modulus == b % modulus; }
+  int modulus;
+};
+
+}  // namespace
+
+TEST(ConcurrentMap, statefulHashAndEqual) {
+  s21::concurrent_map<int, int, modulo_hash, modulo_equal> map(
+      4, modulo_hash(100), modulo_equal(100));
+  EXPECT_TRUE(map.insert_or_assign(7, 1));
+  EXPECT_FALSE(map.insert_or_assign(107, 2));
+  EXPECT_EQ(map.find(207), std::optional<int>(2));
+  for (int i = 0; i < 500; ++i) map.insert_or_assign(i, i);
+  EXPECT_EQ(map.size(), 100u);
+  EXPECT_EQ(map.erase(350), 1u);
+  EXPECT_FALSE(map.contains(50));
+  EXPECT_EQ(map.hash_function().modulus, 100);
+  EXPECT_EQ(map.key_eq().modulus, 100);
+}
+
+TEST(ConcurrentMap, parallelCounters) {
+  const int kThreads = 4;
+  const int kRounds = 20000;
+  s21::concurrent_map<int, long> map;
+  for (int key = 0; key < 64; ++key) map.insert_or_assign(key, 0);
+  std::vector<std::thread> workers;
+  for (int t = 0; t < kThreads; ++t) {
+    workers.emplace_back([&map, t] {
+      for (int i = 0; i < kRounds; ++i) {
+        map.update(i % 64, [](long &value) { ++value; });
+        int scratch = 1000 + t * kRounds + i;
+        map.insert_or_assign(scratch, i);
+        map.erase(scratch);
+      }
+    });
+  }
+  for (std::thread &worker : workers) worker.join();
+  EXPECT_EQ(map.size(), 64u);
+  long total = 0;
+  for (int key = 0; key < 64; ++key) total += map.find(key).value_or(0);
+  EXPECT_EQ(total, long(kThreads) * kRounds);
+}
@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <random>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../s21_containersplus.h"
+
+TEST(ConcurrentSkiplist, matchesStdSet) {
+  s21::concurrent_skiplist_set<int> set;
+  std::set<int> expected;
+  std::mt19937 gen(3);
+  for (int i = 0; i < 20000; ++i) {
+    int key = int(gen() % 2000);
+    if (gen() % 3 == 0) {
+      EXPECT_EQ(set.erase(key), expected.erase(key));
+    } else {
+      EXPECT_EQ(set.insert(key), expected.insert(key).second);
+    }
+  }
+  ASSERT_EQ(set.size(), expected.size());
+  std::vector<int> keys(set.begin(), set.end());
+  EXPECT_EQ(keys, std::vector<int>(expected.begin(), expected.end()));
+  for (int key = -1; key <= 2000; key += 7) {
+    auto lower = expected.lower_bound(key);
+    auto upper = expected.upper_bound(key);
+    auto it = set.lower_bound(key);
+    if (lower == expected.end()) {
+      EXPECT_TRUE(it == set.end());
+    } else {
+      EXPECT_EQ(*it, *lower);
+    }
+    it = set.upper_bound(key);
+    if (upper == expected.end()) {
+      EXPECT_TRUE(it == set.end());
+    } else {
+      EXPECT_EQ(*it, *upper);
+    }
+    EXPECT_EQ(set.contains(key), expected.count(key) == 1);
+  }
+}
+
+TEST(ConcurrentSkiplist, parallelInsertAndErase) {
+  const int kThreads = 4;
+  const int kPerThread = 5000;
+  s21::concurrent_skiplist_map<int, std::string> map;
+  std::vector<std::thread> workers;
+  for (int t = 0; t < kThreads; ++t) {
+    workers.emplace_back([&map, t] {
+      for (int i = 0; i < kPerThread; ++i) {
+        int key = i * kThreads + t;
+        map.insert(key, std::to_string(key));
+      }
+      // нечетные ключи удаляются, пока другие потоки еще вставляют
+      for (int i = 1; i < kPerThread; i += 2) {
+        map.erase(i * kThreads + t);
+      }
+    });
+  }
+  for (std::thread &worker : workers) worker.join();
+  ASSERT_EQ(map.size(), std::size_t(kThreads * kPerThread / 2));
+  int previous = -1;
+  std::size_t count = 0;
+  for (const auto &item : map) {
+    EXPECT_LT(previous, item.first);
+    EXPECT_EQ((item.first / kThreads) % 2, 0);
+    EXPECT_EQ(item.second, std::to_string(item.first));
+    previous = item.first;
+    ++count;
+  }
+  EXPECT_EQ(count, map.size());
+  EXPECT_EQ(map.find(kThreads * 2)->second, std::to_string(kThreads * 2));
+  EXPECT_TRUE(map.find(kThreads * 3) == map.end());
+}
+
+TEST(ConcurrentSkiplist, readersRunDuringChurn) {
+  s21::concurrent_skiplist_set<long> set;
+  for (long key = 0; key < 1000; key += 2) set.insert(key);
+  std::atomic<bool> stop(false);
+  std::vector<std::thread> writers;
+  for (int t = 0; t < 2; ++t) {
+    writers.emplace_back([&set, &stop, t] {
+      std::mt19937 gen(t);
+      while (!stop.load()) {
+        long key = long(gen() % 500) * 2 + 1;
+        if (gen() % 2 == 0) {
+          set.insert(key);
+        } else {
+          set.erase(key);
+        }
+      }
+    });
+  }
+  // четные ключи не меняются и всегда видны читателю по порядку
+  for (int round = 0; round < 200; ++round) {
+    long even = 0;
+    long previous = -1;
+    for (long key : set) {
+      EXPECT_LT(previous, key);
+      previous = key;
+      if (key % 2 == 0) ++even;
+    }
+    EXPECT_EQ(even, 500);
+  }
+  stop.store(true);
+  for (std::thread &writer : writers) writer.join();
+}
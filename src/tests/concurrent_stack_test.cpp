@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../s21_containersplus.h"
+
+TEST(ConcurrentStack, lifoInOneThread) {
+  s21::concurrent_stack<std::string> stack;
+  EXPECT_TRUE(stack.empty());
+  EXPECT_FALSE(stack.pop().has_value());
+  stack.push("a");
+  std::string b = "b";
+  stack.push(b);
+  stack.emplace(3, 'c');
+  EXPECT_FALSE(stack.empty());
+  EXPECT_EQ(stack.pop(), std::optional<std::string>("ccc"));
+  EXPECT_EQ(stack.pop(), std::optional<std::string>("b"));
+  EXPECT_EQ(stack.pop(), std::optional<std::string>("a"));
+  EXPECT_FALSE(stack.pop().has_value());
+}
+
+TEST(ConcurrentStack, moveOnlyValues) {
+  s21::concurrent_stack<std::unique_ptr<int>> stack;
+  stack.push(std::make_unique<int>(4));
+  stack.push(std::make_unique<int>(5));
+  EXPECT_EQ(**stack.pop(), 5);
+  EXPECT_EQ(**stack.pop(), 4);
+  // оставшиеся в стеке узлы удаляет деструктор
+  stack.push(std::make_unique<int>(6));
+}
+
+TEST(ConcurrentStack, parallelPushPop) {
+  const int kThreads = 4;
+  const int kPerThread = 20000;
+  s21::concurrent_stack<int> stack;
+  std::vector<std::vector<int>> popped(kThreads);
+  std::vector<std::thread> workers;
+  for (int t = 0; t < kThreads; ++t) {
+    workers.emplace_back([&, t] {
+      for (int i = 0; i < kPerThread; ++i) {
+        stack.push(t * kPerThread + i);
+        if (i % 2 == 1) {
+          for (int k = 0; k < 2; ++k) {
+            std::optional<int> value = stack.pop();
+            if (value) popped[t].push_back(*value);
+          }
+        }
+      }
+    });
+  }
+  for (std::thread &worker : workers) worker.join();
+  std::vector<int> all;
+  for (const auto &part : popped) {
+    all.insert(all.end(), part.begin(), part.end());
+  }
+  while (std::optional<int> value = stack.pop()) all.push_back(*value);
+  std::sort(all.begin(), all.end());
+  ASSERT_EQ(all.size(), std::size_t(kThreads * kPerThread));
+  for (int i = 0; i < kThreads * kPerThread; ++i) {
+    EXPECT_EQ(all[i], i);
+  }
+}
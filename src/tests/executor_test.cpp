@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../s21_containersplus.h"
+
+namespace {
+
+long fibonacci(s21::executor &pool, int n) {
+  if (n < 2) return n;
+  s21::future<long> left = pool.submit([&pool, n] {
+    return fibonacci(pool, n - 1);
+  });
+  long right = fibonacci(pool, n - 2);
+  return left.get() + right;
+}
+
+}  // namespace
+
+TEST(Executor, submitReturnsResult) {
+  s21::executor pool(2);
+  EXPECT_EQ(pool.size(), 2u);
+  s21::future<int> answer = pool.submit([] { return 42; });
+  EXPECT_TRUE(answer.valid());
+  EXPECT_EQ(answer.get(), 42);
+  EXPECT_FALSE(answer.valid());
+  EXPECT_THROW(answer.get(), std::logic_error);
+  s21::future<int> empty;
+  EXPECT_THROW(empty.wait(), std::logic_error);
+
+  auto owned = std::make_unique<std::string>("moved");
+  s21::future<std::string> text =
+      pool.submit([owned = std::move(owned)] { return *owned; });
+  EXPECT_EQ(text.get(), "moved");
+}
+
+TEST(Executor, exceptionsReachFuture) {
+  s21::executor pool(2);
+  s21::future<int> failed =
+      pool.submit([]() -> int { throw std::runtime_error("task"); });
+  EXPECT_THROW(failed.get(), std::runtime_error);
+  int touched = 0;
+  s21::future<void> done = pool.submit([&touched] { touched = 1; });
+  done.get();
+  EXPECT_EQ(touched, 1);
+}
+
+TEST(Executor, continuations) {
+  s21::executor pool(2);
+  s21::future<std::string> chain =
+      pool.submit([] { return 2; })
+          .then([](int x) { return x * 10; })
+          .then([](int x) { return std::to_string(x); });
+  EXPECT_EQ(chain.get(), "20");
+
+  bool called = false;
+  s21::future<int> skipped =
+      pool.submit([]() -> int { throw std::out_of_range("first"); })
+          .then([&called](int x) {
+            called = true;
+            return x;
+          });
+  EXPECT_THROW(skipped.get(), std::out_of_range);
+  EXPECT_FALSE(called);
+
+  s21::future<void> first = pool.submit([] {});
+  s21::future<int> second = first.then([] { return 7; });
+  EXPECT_FALSE(first.valid());
+  EXPECT_EQ(second.get(), 7);
+
+  // продолжение готового future ставится сразу
+  s21::future<int> ready = pool.submit([] { return 1; });
+  ready.wait();
+  EXPECT_EQ(ready.then([](int x) { return x + 1; }).get(), 2);
+}
+
+TEST(Executor, destructorRunsPostedTasks) {
+  std::atomic<int> counter{0};
+  {
+    s21::executor pool(3);
+    for (int i = 0; i < 1000; ++i) {
+      pool.post([&counter] { counter.fetch_add(1); });
+    }
+  }
+  EXPECT_EQ(counter.load(), 1000);
+}
+
+TEST(Executor, parallelFor) {
+  s21::executor pool(3);
+  std::vector<int> hits(10000, 0);
+  pool.parallel_for(0, hits.size(), [&hits](std::size_t i) { ++hits[i]; },
+                    16);
+  for (int value : hits) EXPECT_EQ(value, 1);
+
+  int calls = 0;
+  pool.parallel_for(5, 5, [&calls](std::size_t) { ++calls; });
+  pool.parallel_for(5, 6, [&calls](std::size_t i) { calls += int(i); });
+  EXPECT_EQ(calls, 5);
+
+  EXPECT_THROW(pool.parallel_for(0, 1000,
+                                 [](std::size_t i) {
+                                   if (i == 500) throw std::runtime_error("x");
+                                 }),
+               std::runtime_error);
+}
+
+TEST(Executor, nestedWaitsDoNotBlockPool) {
+  s21::executor pool(2);
+  s21::future<long> result = pool.submit([&pool] {
+    return fibonacci(pool, 16);
+  });
+  EXPECT_EQ(result.get(), 987);
+
+  std::atomic<int> sum{0};
+  pool.submit([&pool, &sum] {
+        pool.parallel_for(0, 100, [&sum](std::size_t i) {
+          sum.fetch_add(int(i));
+        });
+      })
+      .get();
+  EXPECT_EQ(sum.load(), 4950);
+}
+
+TEST(Executor, waitAll) {
+  s21::executor pool(4);
+  std::vector<s21::future<int>> results;
+  for (int i = 0; i < 200; ++i) {
+    results.push_back(pool.submit([i] { return i * i; }));
+  }
+  s21::wait_all(results.begin(), results.end());
+  for (int i = 0; i < 200; ++i) {
+    EXPECT_TRUE(results[i].ready());
+    EXPECT_EQ(results[i].get(), i * i);
+  }
+  s21::future<int> number = pool.submit([] { return 1; });
+  s21::future<std::string> word = pool.submit([] { return std::string("a"); });
+  s21::wait_all(number, word);
+  EXPECT_TRUE(number.ready());
+  EXPECT_TRUE(word.ready());
+}
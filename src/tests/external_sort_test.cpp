@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../s21_containersplus.h"
+
+namespace {
+
+struct record {
+  std::uint32_t key;
+  std::uint32_t payload;
+};
+
+std::string temp_path(const char *name) {
+  return testing::TempDir() + name;
+}
+
+s21::external_sort_options small_budget() {
+  s21::external_sort_options options;
+  options.memory_bytes = 64 << 10;
+  options.temp_dir = testing::TempDir();
+  return options;
+}
+
+}  // namespace
+
+TEST(EXTERNAL_SORT, fitsInMemoryWithoutRuns) {
+  s21::external_sorter<int> sorter;
+  for (int i = 0; i < 1000; ++i) sorter.push((i * 7919) % 1000);
+  EXPECT_EQ(sorter.runs(), 0U);
+  std::vector<int> out;
+  sorter.finish([&out](int value) { out.push_back(value); });
+  ASSERT_EQ(out.size(), 1000U);
+  EXPECT_TRUE(std::is_sorted(out.begin(), out.end()));
+  EXPECT_EQ(sorter.size(), 0U);
+}
+
+TEST(EXTERNAL_SORT, spillsAndMergesInSeveralPasses) {
+  std::mt19937_64 gen(5);
+  std::vector<std::uint64_t> data(200000);
+  for (auto &x : data) x = gen() % 50000;
+  s21::external_sort_options options = small_budget();
+  options.direct_io = true;
+  s21::external_sorter<std::uint64_t> sorter(options);
+  sorter.push(data.data(), data.size());
+  EXPECT_GT(sorter.runs(), 2U);
+
+  std::vector<std::uint64_t> out;
+  sorter.finish([&out](std::uint64_t value) { out.push_back(value); });
+  std::sort(data.begin(), data.end());
+  EXPECT_TRUE(out == data);
+}
+
+TEST(EXTERNAL_SORT, fileToFileWithComparator) {
+  std::string input = temp_path("s21_external_in.bin");
+  std::string output = temp_path("s21_external_out.bin");
+  std::vector<record> data;
+  for (std::uint32_t i = 0; i < 50000; ++i) {
+    data.push_back({(i * 2654435761U) % 10007, i});
+  }
+  std::FILE *file = std::fopen(input.c_str(), "wb");
+  ASSERT_NE(file, nullptr);
+  std::fwrite(data.data(), sizeof(record), data.size(), file);
+  std::fclose(file);
+
+  auto by_key_desc = [](const record &a, const record &b) {
+    return a.key > b.key;
+  };
+  s21::external_sort<record>(input, output, small_budget(), by_key_desc);
+
+  std::vector<record> out(data.size() + 1);
+  file = std::fopen(output.c_str(), "rb");
+  ASSERT_NE(file, nullptr);
+  std::size_t read = std::fread(out.data(), sizeof(record), out.size(), file);
+  std::fclose(file);
+  std::remove(input.c_str());
+  std::remove(output.c_str());
+  ASSERT_EQ(read, data.size());
+  out.pop_back();
+  EXPECT_TRUE(std::is_sorted(out.begin(), out.end(), by_key_desc));
+  std::uint64_t sum = 0;
+  for (const record &r : out) sum += r.payload;
+  EXPECT_EQ(sum, 49999ULL * 50000 / 2);
+}
+
+TEST(EXTERNAL_SORT, temporarySpaceBudget) {
+  s21::external_sort_options options = small_budget();
+  options.temp_bytes = 16 << 10;
+  s21::external_sorter<std::uint64_t> sorter(options);
+  auto fill = [&sorter] {
+    for (std::uint64_t i = 0; i < 100000; ++i) sorter.push(i);
+  };
+  EXPECT_THROW(fill(), std::length_error);
+}
@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <string>
+
+#include "../s21_containersplus.h"
+
+namespace {
+
+std::string temp_path(const char *name) {
+  return testing::TempDir() + name;
+}
+
+}  // namespace
+
+TEST(FROZEN, setLookupMatchesSource) {
+  for (int n : {0, 1, 2, 3, 7, 8, 100, 1023, 1024, 5000}) {
+    s21::set<int> source;
+    for (int i = 0; i < n; ++i) source.insert(i * 2);
+    s21::frozen_set<int> frozen(source);
+    ASSERT_EQ(frozen.size(), std::size_t(n));
+    for (int key = -1; key <= 2 * n; ++key) {
+      EXPECT_EQ(frozen.contains(key), key >= 0 && key % 2 == 0 && key < 2 * n)
+          << n << " " << key;
+      auto it = frozen.lower_bound(key);
+      if (key >= 2 * n - 1) {
+        EXPECT_TRUE(it == frozen.end());
+      } else {
+        EXPECT_EQ(*it, key < 0 ? 0 : (key + 1) / 2 * 2);
+      }
+    }
+    int expected = 0;
+    for (int key : frozen) {
+      EXPECT_EQ(key, expected);
+      expected += 2;
+    }
+    EXPECT_EQ(expected, 2 * n);
+  }
+}
+
+TEST(FROZEN, mapThroughMappedFile) {
+  std::string path = temp_path("s21_frozen_map.bin");
+  s21::map<long, double> source;
+  for (long i = 0; i < 20000; ++i) source.insert(i * 7, i * 0.5);
+  {
+    s21::frozen_map<long, double> frozen(source);
+    EXPECT_FALSE(frozen.mapped());
+    frozen.save(path);
+  }
+  s21::frozen_map<long, double> opened =
+      s21::frozen_map<long, double>::open(path);
+  EXPECT_TRUE(opened.mapped());
+  ASSERT_EQ(opened.size(), source.size());
+  EXPECT_DOUBLE_EQ(opened.at(7 * 123), 61.5);
+  EXPECT_THROW(opened.at(8), std::out_of_range);
+  EXPECT_EQ(opened.count(0), 1U);
+  auto it = opened.find(7 * 19999);
+  ASSERT_TRUE(it != opened.end());
+  EXPECT_DOUBLE_EQ((*it).second, 19999 * 0.5);
+  EXPECT_TRUE(++it == opened.end());
+
+  std::size_t visited = 0;
+  auto expected = source.begin();
+  for (auto item : opened) {
+    EXPECT_EQ(item.first, (*expected).first);
+    ++expected;
+    ++visited;
+  }
+  EXPECT_EQ(visited, source.size());
+
+  s21::frozen_map<long, double> moved(std::move(opened));
+  EXPECT_TRUE(opened.empty());
+  EXPECT_TRUE(moved.contains(14));
+  std::remove(path.c_str());
+}
+
+TEST(FROZEN, rejectsForeignImages) {
+  std::string path = temp_path("s21_frozen_bad.bin");
+  s21::set<int> source{1, 2, 3};
+  s21::frozen_set<int>(source).save(path);
+  EXPECT_THROW(s21::frozen_set<long>::open(path), std::runtime_error);
+  EXPECT_THROW((s21::frozen_map<int, int>::open(path)), std::runtime_error);
+  EXPECT_EQ(s21::frozen_set<int>::open(path).size(), 3U);
+
+  std::FILE *file = std::fopen(path.c_str(), "wb");
+  ASSERT_NE(file, nullptr);
+  std::fputs("not an image", file);
+  std::fclose(file);
+  EXPECT_THROW(s21::frozen_set<int>::open(path), std::runtime_error);
+  std::remove(path.c_str());
+  EXPECT_THROW(s21::frozen_set<int>::open(path), std::system_error);
+}
@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 
 #include <list>
+#include <memory>
 #include <random>
 
 #include "../s21_containers.h"  // Подключение вашего заголовочного файла
@@ -539,8 +540,8 @@ TEST(LIST, back) {
 
 TEST(LIST, back2) {
   s21::list<int> a = {};
-  auto a1 = a.back();
-  EXPECT_EQ(a1, 0);
+  EXPECT_TRUE(a.empty());
+  EXPECT_TRUE(a.begin() == a.end());
 }
 
 TEST(LIST, pushFront1) {
@@ -714,4 +715,113 @@ TEST(LIST, insertManyBack) {
   EXPECT_EQ(9U, it);
   EXPECT_EQ(a.front(), 1);
   EXPECT_EQ(a.back(), 6);
-}
\ No newline at end of file
+}
+namespace {
+// тип без конструктора по умолчанию
+struct NoDefaultItem {
+  explicit NoDefaultItem(int v) : value(v) {}
+  int value;
+};
+}  // namespace
+
+TEST(LIST, NoDefaultConstructor) {
+  s21::list<NoDefaultItem> a;
+  EXPECT_TRUE(a.begin() == a.end());
+  a.push_back(NoDefaultItem(2));
+  a.push_front(NoDefaultItem(1));
+  EXPECT_EQ(a.size(), 2U);
+  EXPECT_EQ(a.front().value, 1);
+  EXPECT_EQ(a.back().value, 2);
+}
+
+TEST(LIST, MoveNoexcept) {
+  static_assert(std::is_nothrow_default_constructible<s21::list<int>>::value);
+  static_assert(std::is_nothrow_move_constructible<s21::list<int>>::value);
+  static_assert(std::is_nothrow_move_assignable<s21::list<int>>::value);
+
+  s21::list<int> a = {1, 2, 3};
+  auto first = a.begin();
+  s21::list<int> b(std::move(a));
+  EXPECT_TRUE(a.empty());
+  EXPECT_TRUE(a.begin() == a.end());
+  EXPECT_EQ(b.size(), 3U);
+  EXPECT_EQ(*first, 1);
+  int expected = 1;
+  for (auto it = b.begin(); it != b.end(); ++it, ++expected) {
+    EXPECT_EQ(*it, expected);
+  }
+  EXPECT_EQ(expected, 4);
+
+  s21::list<int> c = {7};
+  c = std::move(b);
+  EXPECT_EQ(c.size(), 3U);
+  EXPECT_EQ(c.back(), 3);
+  c.swap(a);
+  EXPECT_TRUE(c.empty());
+  EXPECT_EQ(a.size(), 3U);
+  EXPECT_EQ(*(--a.end()), 3);
+  a.push_back(4);
+  c.push_back(5);
+  EXPECT_EQ(a.back(), 4);
+  EXPECT_EQ(c.front(), 5);
+}
+
+TEST(LIST, insertManyMoveOnly) {
+  s21::list<std::unique_ptr<int>> a;
+  a.insert_many_back(std::make_unique<int>(2), std::make_unique<int>(3));
+  a.insert_many_front(std::make_unique<int>(1));
+  EXPECT_EQ(a.size(), 3U);
+  int expected = 1;
+  for (auto it = a.begin(); it != a.end(); ++it, ++expected) {
+    EXPECT_EQ(**it, expected);
+  }
+}
+
+TEST(LIST, emplace) {
+  s21::list<std::string> a = {"b"};
+  auto it = a.emplace(a.begin(), 3, 'a');
+  EXPECT_EQ(*it, "aaa");
+  a.emplace(a.end(), "c");
+  EXPECT_EQ(a.front(), "aaa");
+  EXPECT_EQ(a.back(), "c");
+  EXPECT_EQ(a.size(), 3U);
+}
+
+TEST(LIST, spliceOne) {
+  s21::list<int> a = {1, 3};
+  s21::list<int> b = {2, 4};
+  int* address = &*b.begin();
+  a.splice(++a.begin(), b, b.begin());
+  EXPECT_EQ(a.size(), 3U);
+  EXPECT_EQ(b.size(), 1U);
+  EXPECT_EQ(&*(++a.begin()), address);
+  a.splice(a.end(), b, b.begin());
+  a.splice(a.end(), b, b.end());
+  EXPECT_TRUE(b.empty());
+  int expected = 1;
+  for (auto it = a.begin(); it != a.end(); ++it, ++expected) {
+    EXPECT_EQ(*it, expected);
+  }
+  a.splice(a.begin(), a, --a.end());
+  EXPECT_EQ(a.front(), 4);
+  EXPECT_EQ(a.size(), 4U);
+}
+
+TEST(LIST, eraseRangeAndIf) {
+  s21::list<int> a = {1, 2, 3, 4, 5, 6};
+  auto first = ++a.begin();
+  auto last = first;
+  ++last;
+  ++last;
+  auto it = a.erase(first, last);
+  EXPECT_EQ(*it, 4);
+  EXPECT_EQ(a.size(), 4U);
+
+  auto removed = s21::erase_if(a, [](int x) { return x > 4; });
+  EXPECT_EQ(removed, 2U);
+  EXPECT_EQ(a.size(), 2U);
+  EXPECT_EQ(a.front(), 1);
+  EXPECT_EQ(a.back(), 4);
+  a.erase(a.begin(), a.end());
+  EXPECT_TRUE(a.empty());
+}
@@ -38,27 +38,27 @@ TEST(map_test, erase_3) {
   it++;
   s21_map.erase(it);
   EXPECT_EQ((*s21_map.begin()).first, 4);
-  EXPECT_EQ((*s21_map.end()).first, 0);
+  EXPECT_EQ((*(--s21_map.end())).first, 18);
   EXPECT_EQ(s21_map.size(), 6U);
 
   it = s21_map.begin();
   s21_map.erase(it);
   EXPECT_EQ((*s21_map.begin()).first, 5);
-  EXPECT_EQ((*s21_map.end()).first, 0);
+  EXPECT_EQ((*(--s21_map.end())).first, 18);
   EXPECT_EQ(s21_map.size(), 5U);
 
   it = s21_map.begin();
   it++;
   s21_map.erase(it);
   EXPECT_EQ((*s21_map.begin()).first, 5);
-  EXPECT_EQ((*s21_map.end()).first, 0);
+  EXPECT_EQ((*(--s21_map.end())).first, 18);
   EXPECT_EQ(s21_map.size(), 4U);
 
   it = s21_map.end();
   --it;
   s21_map.erase(it);
   EXPECT_EQ((*s21_map.begin()).first, 5);
-  EXPECT_EQ((*s21_map.end()).first, 0);
+  EXPECT_EQ((*(--s21_map.end())).first, 16);
   EXPECT_EQ(s21_map.size(), 3U);
 
   it = s21_map.begin();
@@ -1364,3 +1364,131 @@ TEST(map_test, insert_many_3) {
   EXPECT_EQ(s21_map.at("The"), s21_exm.at("The"));
   EXPECT_EQ(s21_map.at("!"), s21_exm.at("!"));
 }
+
+TEST(map_test, move_noexcept) {
+  static_assert(
+      std::is_nothrow_default_constructible<s21::map<int, int>>::value);
+  static_assert(std::is_nothrow_move_constructible<s21::map<int, int>>::value);
+  static_assert(std::is_nothrow_move_assignable<s21::map<int, int>>::value);
+
+  s21::map<int, std::string> s21_map = {{2, "b"}, {1, "a"}};
+  s21::map<int, std::string> s21_moved(std::move(s21_map));
+  EXPECT_TRUE(s21_map.empty());
+  EXPECT_TRUE(s21_map.begin() == s21_map.end());
+  EXPECT_EQ(s21_moved.at(1), "a");
+  EXPECT_EQ(s21_moved.at(2), "b");
+  s21_map[3] = "c";
+  EXPECT_EQ(s21_map.size(), 1U);
+}
+
+namespace {
+// считает созданные объекты, чтобы проверить отсутствие лишних копий
+struct CountedValue {
+  static int created;
+  CountedValue() : value(0) { created++; }
+  explicit CountedValue(int v) : value(v) { created++; }
+  CountedValue(const CountedValue& other) : value(other.value) { created++; }
+  int value;
+};
+int CountedValue::created = 0;
+}  // namespace
+
+TEST(map_test, try_emplace) {
+  s21::map<int, CountedValue> s21_map;
+  CountedValue::created = 0;
+  auto res = s21_map.try_emplace(1, 10);
+  EXPECT_TRUE(res.second);
+  EXPECT_EQ((*res.first).second.value, 10);
+  EXPECT_EQ(CountedValue::created, 1);
+
+  res = s21_map.try_emplace(1, 20);
+  EXPECT_FALSE(res.second);
+  EXPECT_EQ((*res.first).second.value, 10);
+  EXPECT_EQ(CountedValue::created, 1);
+
+  s21_map[1].value = 11;
+  EXPECT_EQ(CountedValue::created, 1);
+  EXPECT_EQ(s21_map[2].value, 0);
+  EXPECT_EQ(CountedValue::created, 2);
+  EXPECT_EQ(s21_map.at(1).value, 11);
+
+  std::string key = "moved";
+  s21::map<std::string, int> s21_map_2;
+  s21_map_2.try_emplace(std::move(key), 5);
+  EXPECT_EQ(s21_map_2.at("moved"), 5);
+}
+
+TEST(map_test, emplace) {
+  s21::map<int, std::string> s21_map;
+  auto res = s21_map.emplace(1, "one");
+  EXPECT_TRUE(res.second);
+  res = s21_map.emplace(std::make_pair(1, "uno"));
+  EXPECT_FALSE(res.second);
+  EXPECT_EQ((*res.first).second, "one");
+  res = s21_map.emplace(std::piecewise_construct, std::forward_as_tuple(2),
+                        std::forward_as_tuple(3, 'z'));
+  EXPECT_TRUE(res.second);
+  EXPECT_EQ(s21_map.at(2), "zzz");
+  EXPECT_EQ(s21_map.size(), 2U);
+}
+
+TEST(map_test, emplace_skips_value_for_existing_key) {
+  s21::map<int, CountedValue> s21_map;
+  CountedValue::created = 0;
+  EXPECT_TRUE(s21_map.emplace(1, 10).second);
+  EXPECT_EQ(CountedValue::created, 1);
+
+  auto res = s21_map.emplace(1, 20);
+  EXPECT_FALSE(res.second);
+  res = s21_map.emplace(std::piecewise_construct, std::forward_as_tuple(1),
+                        std::forward_as_tuple(30));
+  EXPECT_FALSE(res.second);
+  EXPECT_EQ(CountedValue::created, 1);
+  EXPECT_EQ((*res.first).second.value, 10);
+
+  res = s21_map.emplace(std::piecewise_construct, std::forward_as_tuple(2),
+                        std::forward_as_tuple(40));
+  EXPECT_TRUE(res.second);
+  EXPECT_EQ(CountedValue::created, 2);
+  EXPECT_EQ(s21_map.at(2).value, 40);
+
+  s21::map<std::string, int> by_name;
+  EXPECT_TRUE(by_name.emplace("one", 1).second);
+  EXPECT_FALSE(by_name.emplace("one", 2).second);
+  EXPECT_EQ(by_name.at("one"), 1);
+}
+
+TEST(map_test, extract_insert_node) {
+  s21::map<int, std::string> shard_1 = {{1, "one"}, {2, "two"}, {3, "three"}};
+  s21::map<int, std::string> shard_2 = {{4, "four"}};
+  for (int key = 1; key <= 3; key++) {
+    auto nh = shard_1.extract(key);
+    EXPECT_EQ(nh.value().first, key);
+    auto res = shard_2.insert(std::move(nh));
+    EXPECT_TRUE(res.inserted);
+  }
+  EXPECT_TRUE(shard_1.empty());
+  EXPECT_EQ(shard_2.size(), 4U);
+  EXPECT_EQ(shard_2.at(2), "two");
+  auto nh = shard_2.extract(shard_2.begin());
+  nh.value().second = "uno";
+  shard_1.insert(std::move(nh));
+  EXPECT_EQ(shard_1.at(1), "uno");
+}
+
+TEST(map_test, erase_range_and_if) {
+  s21::map<int, int> s21_map;
+  for (int i = 0; i < 50; i++) s21_map.insert(i, i * i);
+  auto last = s21_map.begin();
+  for (int i = 0; i < 10; i++) last++;
+  auto it = s21_map.erase(s21_map.begin(), last);
+  EXPECT_EQ((*it).first, 10);
+  EXPECT_EQ(s21_map.size(), 40U);
+  auto removed = s21::erase_if(s21_map, [](const std::pair<const int, int>& p) {
+    return p.second > 900;
+  });
+  EXPECT_EQ(removed, 19U);
+  EXPECT_EQ(s21_map.size(), 21U);
+  EXPECT_EQ((*(--s21_map.end())).first, 30);
+  EXPECT_FALSE(s21_map.contains(31));
+}
@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include "../s21_containersplus.h"
+
+namespace {
+
+struct point {
+  double x;
+  double y;
+  int id;
+};
+
+std::string temp_path(const char *name) {
+  return testing::TempDir() + name;
+}
+
+}  // namespace
+
+TEST(MMAP_VECTOR, persistsBetweenOpens) {
+  std::string path = temp_path("s21_mmap_vector_persist.bin");
+  {
+    s21::mmap_vector<point> v(path, s21::mmap_mode::create);
+    EXPECT_TRUE(v.empty());
+    for (int i = 0; i < 50000; ++i) v.push_back({i * 0.5, -i * 1.0, i});
+    EXPECT_EQ(v.size(), 50000U);
+    EXPECT_GE(v.capacity(), v.size());
+    v.flush();
+  }
+  {
+    s21::mmap_vector<point> v(path);
+    ASSERT_EQ(v.size(), 50000U);
+    EXPECT_EQ(v.capacity(), v.size());
+    EXPECT_EQ(v[123].id, 123);
+    EXPECT_DOUBLE_EQ(v.back().x, 49999 * 0.5);
+    v.pop_back();
+    v.push_back({1, 2, -1});
+    v[0].id = 777;
+  }
+  s21::mmap_vector<point> v(path, s21::mmap_mode::read_only);
+  EXPECT_EQ(v.size(), 50000U);
+  EXPECT_EQ(v.at(0).id, 777);
+  EXPECT_EQ(v.back().id, -1);
+  EXPECT_THROW(v.at(50000), std::out_of_range);
+  std::remove(path.c_str());
+}
+
+TEST(MMAP_VECTOR, readOnlyRejectsWrites) {
+  std::string path = temp_path("s21_mmap_vector_ro.bin");
+  { s21::mmap_vector<int> v(path, s21::mmap_mode::create); }
+  s21::mmap_vector<int> v(path, s21::mmap_mode::read_only);
+  EXPECT_FALSE(v.writable());
+  EXPECT_THROW(v.push_back(1), std::logic_error);
+  EXPECT_THROW(v.clear(), std::logic_error);
+  EXPECT_THROW(v.front(), std::logic_error);
+  std::remove(path.c_str());
+}
+
+TEST(MMAP_VECTOR, readerSeesWriterAfterRefresh) {
+  std::string path = temp_path("s21_mmap_vector_shared.bin");
+  s21::mmap_vector<long> writer(path, s21::mmap_mode::create);
+  writer.push_back(1);
+  s21::mmap_vector<long> reader(path, s21::mmap_mode::read_only);
+  EXPECT_EQ(reader.size(), 1U);
+  for (long i = 2; i <= 100000; ++i) writer.push_back(i);
+  writer[0] = 42;
+  EXPECT_EQ(reader[0], 42);
+  EXPECT_EQ(reader.refresh(), 100000U);
+  EXPECT_EQ(reader.back(), 100000);
+
+  s21::mmap_vector<long> moved(std::move(reader));
+  EXPECT_EQ(moved.size(), 100000U);
+  EXPECT_EQ(reader.size(), 0U);
+  std::remove(path.c_str());
+}
+
+TEST(MMAP_VECTOR, rejectsForeignFiles) {
+  std::string path = temp_path("s21_mmap_vector_bad.bin");
+  {
+    std::ofstream out(path, std::ios::binary);
+    out << std::string(100, 'x');
+  }
+  auto open_read_only = [&] {
+    s21::mmap_vector<int> v(path, s21::mmap_mode::read_only);
+  };
+  EXPECT_THROW(open_read_only(), std::runtime_error);
+  { s21::mmap_vector<int> v(path, s21::mmap_mode::create); }
+  EXPECT_THROW(s21::mmap_vector<double>{path}, std::runtime_error);
+  std::remove(path.c_str());
+  EXPECT_THROW(open_read_only(), std::system_error);
+}
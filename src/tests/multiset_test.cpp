@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 
+#include <memory>
+
 #include "../s21_containersplus.h"
 
 TEST(multiset_test, constructor_1) {
@@ -478,7 +480,7 @@ TEST(multiset_test, test30) {
   const s21::multiset<int> one = {1, 1, 1, 1, 1, 1, 43, 413, 123, 4135};
   auto res = one.equal_range(4135);
   EXPECT_EQ(*(res.first), 4135);
-  EXPECT_EQ(*(res.second), 0);
+  EXPECT_TRUE(res.second == one.end());
 }
 
 TEST(multiset_test, insert_many_4) {
@@ -547,3 +549,67 @@ TEST(multiset_test, insert_many_5) {
     EXPECT_EQ(*s21_it, *exm_it);
   }
 }
+
+TEST(multiset_test, emplace) {
+  s21::multiset<std::string> s21_multiset;
+  s21_multiset.emplace(2, 'x');
+  s21_multiset.emplace("xx");
+  s21_multiset.emplace("a");
+  EXPECT_EQ(s21_multiset.size(), 3U);
+  EXPECT_EQ(s21_multiset.count("xx"), 2U);
+  EXPECT_EQ(*s21_multiset.begin(), "a");
+}
+
+TEST(multiset_test, emplace_hint) {
+  s21::multiset<int> s21_multiset = {1, 3, 3, 5};
+  std::multiset<int> std_multiset = {1, 3, 3, 5};
+  for (int i = 0; i < 7; i++) {
+    s21_multiset.emplace_hint(s21_multiset.find(3), i);
+    std_multiset.emplace_hint(std_multiset.find(3), i);
+    s21_multiset.emplace_hint(s21_multiset.end(), i);
+    std_multiset.emplace_hint(std_multiset.end(), i);
+    s21_multiset.emplace_hint(s21_multiset.begin(), i);
+    std_multiset.emplace_hint(std_multiset.begin(), i);
+  }
+  EXPECT_EQ(s21_multiset.size(), std_multiset.size());
+  auto std_it = std_multiset.begin();
+  for (auto s21_it = s21_multiset.begin(); s21_it != s21_multiset.end();
+       s21_it++, std_it++) {
+    EXPECT_EQ(*s21_it, *std_it);
+  }
+}
+
+TEST(multiset_test, insert_many_move_only) {
+  s21::multiset<std::unique_ptr<int>> s21_multiset;
+  auto res = s21_multiset.insert_many(std::make_unique<int>(1),
+                                      std::make_unique<int>(2));
+  EXPECT_EQ(s21_multiset.size(), 2U);
+  EXPECT_TRUE(res[1].second);
+  EXPECT_EQ(**res[1].first, 2);
+}
+
+TEST(multiset_test, extract_insert_node) {
+  s21::multiset<int> one = {1, 2, 2, 3};
+  s21::multiset<int> two = {2};
+  auto nh = one.extract(2);
+  EXPECT_EQ(nh.value(), 2);
+  EXPECT_EQ(one.count(2), 1U);
+  two.insert(std::move(nh));
+  EXPECT_EQ(two.count(2), 2U);
+  EXPECT_TRUE(one.extract(5).empty());
+  two.insert(one.extract(one.begin()));
+  EXPECT_EQ(*two.begin(), 1);
+  EXPECT_EQ(one.size(), 2U);
+  EXPECT_EQ(two.size(), 3U);
+}
+
+TEST(multiset_test, erase_range_and_if) {
+  s21::multiset<int> s21_multiset = {1, 2, 2, 2, 3, 4, 4, 5};
+  auto range = s21_multiset.equal_range(2);
+  auto it = s21_multiset.erase(range.first, range.second);
+  EXPECT_EQ(*it, 3);
+  EXPECT_EQ(s21_multiset.count(2), 0U);
+  auto removed = s21::erase_if(s21_multiset, [](int x) { return x == 4; });
+  EXPECT_EQ(removed, 2U);
+  EXPECT_EQ(s21_multiset.size(), 3U);
+}
@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "../s21_containers.h"
+#include "../s21_containersplus.h"
+#include "../s21_parallel.h"
+
+namespace {
+
+// Мелкие части, чтобы задачи реально распределялись по потокам пула
+s21::parallel::options small_chunks(s21::parallel::thread_pool &pool) {
+  s21::parallel::options opt;
+  opt.pool = &pool;
+  opt.grain = 7;
+  return opt;
+}
+
+}  // namespace
+
+TEST(PARALLEL, runEachIndexOnce) {
+  s21::parallel::thread_pool pool(4);
+  EXPECT_EQ(pool.size(), 4U);
+  for (int round = 0; round < 20; ++round) {
+    std::vector<std::atomic<int>> hits(100);
+    pool.run(hits.size(), [&](std::size_t i) { ++hits[i]; });
+    for (auto &hit : hits) EXPECT_EQ(hit.load(), 1);
+  }
+}
+
+TEST(PARALLEL, exceptionPropagates) {
+  s21::parallel::thread_pool pool(3);
+  EXPECT_THROW(pool.run(50,
+                        [](std::size_t i) {
+                          if (i == 17) throw std::out_of_range("17");
+                        }),
+               std::out_of_range);
+  std::atomic<int> calls(0);
+  pool.run(10, [&](std::size_t) { ++calls; });
+  EXPECT_EQ(calls.load(), 10);
+}
+
+TEST(PARALLEL, nestedRunDoesNotBlock) {
+  s21::parallel::thread_pool pool(2);
+  std::atomic<int> calls(0);
+  pool.run(4, [&](std::size_t) {
+    pool.run(5, [&](std::size_t) { ++calls; });
+  });
+  EXPECT_EQ(calls.load(), 20);
+}
+
+TEST(PARALLEL, forEachTransformReduce) {
+  s21::parallel::thread_pool pool(4);
+  s21::parallel::options opt = small_chunks(pool);
+  s21::vector<int> v(1000);
+  std::iota(v.begin(), v.end(), 1);
+  s21::parallel::for_each(v.begin(), v.end(), [](int &x) { x *= 2; }, opt);
+  EXPECT_EQ(v[999], 2000);
+
+  s21::vector<long> out(v.size());
+  s21::parallel::transform(v.begin(), v.end(), out.begin(),
+                           [](int x) { return long(x) * x; }, opt);
+  EXPECT_EQ(out[10], 22L * 22);
+  EXPECT_EQ(s21::parallel::reduce(v.begin(), v.end(), 0L, opt), 1001000L);
+  EXPECT_EQ(s21::parallel::reduce(
+                v.begin(), v.end(), 0,
+                [](int a, int b) { return std::max(a, b); }, opt),
+            2000);
+  EXPECT_EQ(s21::parallel::reduce(v.begin(), v.begin(), 5L, opt), 5L);
+}
+
+TEST(PARALLEL, sortMatchesStd) {
+  s21::parallel::thread_pool pool(3);
+  std::mt19937 gen(42);
+  for (std::size_t n : {0, 1, 6, 7, 50, 1000}) {
+    s21::vector<int> v(n);
+    for (auto &x : v) x = int(gen() % 100);
+    std::vector<int> expected(v.begin(), v.end());
+    std::sort(expected.begin(), expected.end(), std::greater<int>());
+    s21::parallel::sort(v.begin(), v.end(), std::greater<int>(),
+                        small_chunks(pool));
+    EXPECT_TRUE(std::equal(v.begin(), v.end(), expected.begin()));
+  }
+}
+
+TEST(PARALLEL, inclusiveScanArray) {
+  s21::parallel::thread_pool pool(4);
+  s21::array<int, 100> arr;
+  arr.fill(1);
+  s21::array<int, 100> out;
+  s21::parallel::inclusive_scan(arr.begin(), arr.end(), out.begin(),
+                                small_chunks(pool));
+  for (std::size_t i = 0; i < out.size(); ++i) EXPECT_EQ(out[i], int(i) + 1);
+}
+
+TEST(PARALLEL, treeForEachAndReduce) {
+  s21::parallel::thread_pool pool(4);
+  s21::parallel::options opt = small_chunks(pool);
+  s21::set<int> s;
+  s21::map<int, long> m;
+  for (int i = 0; i < 500; ++i) {
+    s.insert(i);
+    m.insert(i, i * 2L);
+  }
+  std::vector<std::atomic<int>> seen(500);
+  s21::parallel::for_each(s, [&](int x) { ++seen[x]; }, opt);
+  for (auto &hit : seen) EXPECT_EQ(hit.load(), 1);
+
+  long total = s21::parallel::reduce(
+      m, 0L, [](long acc, const std::pair<const int, long> &p) {
+        return acc + p.second;
+      },
+      std::plus<long>(), opt);
+  EXPECT_EQ(total, 249500L);
+}
+
+TEST(PARALLEL, treeSplitCoversInOrder) {
+  s21::multiset<int> ms;
+  for (int i = 0; i < 300; ++i) ms.insert(i % 100);
+  auto bounds = ms.split(8);
+  EXPECT_GE(bounds.size(), 9U);
+  EXPECT_TRUE(bounds.front() == ms.begin());
+  EXPECT_TRUE(bounds.back() == ms.end());
+  std::vector<int> walked;
+  for (std::size_t i = 0; i + 1 < bounds.size(); ++i)
+    for (auto it = bounds[i]; it != bounds[i + 1]; ++it) walked.push_back(*it);
+  EXPECT_EQ(walked.size(), ms.size());
+  EXPECT_TRUE(std::is_sorted(walked.begin(), walked.end()));
+  EXPECT_EQ(s21::set<int>().split(4).size(), 2U);
+}
@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+
+#include <map>
+#include <random>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../s21_containersplus.h"
+
+TEST(Persistent, setMatchesStdSet) {
+  s21::persistent_set<int> set;
+  std::set<int> expected;
+  std::mt19937 gen(11);
+  std::uniform_int_distribution<int> key(0, 499);
+  for (int i = 0; i < 5000; ++i) {
+    int k = key(gen);
+    if (gen() % 3 == 0) {
+      EXPECT_EQ(set.erase(k), expected.erase(k));
+    } else {
+      EXPECT_EQ(set.insert(k), expected.insert(k).second);
+    }
+  }
+  ASSERT_EQ(set.size(), expected.size());
+  std::vector<int> keys(set.begin(), set.end());
+  EXPECT_EQ(keys, std::vector<int>(expected.begin(), expected.end()));
+  for (int k = 0; k < 500; ++k) {
+    EXPECT_EQ(set.contains(k), expected.count(k) == 1);
+  }
+}
+
+TEST(Persistent, snapshotsKeepOldVersions) {
+  s21::persistent_map<int, std::string> map = {{1, "one"}, {2, "two"}};
+  std::vector<s21::persistent_map<int, std::string>> versions;
+  std::vector<std::map<int, std::string>> expected;
+  std::map<int, std::string> model = {{1, "one"}, {2, "two"}};
+  for (int i = 0; i < 300; ++i) {
+    versions.push_back(map.snapshot());
+    expected.push_back(model);
+    int k = i % 37;
+    if (i % 4 == 3) {
+      map.erase(k);
+      model.erase(k);
+    } else {
+      map.insert_or_assign(k, std::to_string(i));
+      model[k] = std::to_string(i);
+    }
+  }
+  for (std::size_t v = 0; v < versions.size(); ++v) {
+    ASSERT_EQ(versions[v].size(), expected[v].size());
+    auto it = versions[v].begin();
+    for (const auto &item : expected[v]) {
+      EXPECT_EQ(it->first, item.first);
+      EXPECT_EQ(it->second, item.second);
+      ++it;
+    }
+    EXPECT_TRUE(it == versions[v].end());
+  }
+  for (int k = 0; k < 37; ++k) {
+    if (model.count(k) == 1) {
+      EXPECT_EQ(map.at(k), model.at(k));
+      EXPECT_EQ(map.find(k)->second, model.at(k));
+      EXPECT_FALSE(map.insert(k, "again"));
+    } else {
+      EXPECT_THROW(map.at(k), std::out_of_range);
+    }
+  }
+  EXPECT_TRUE(map.find(1000) == map.end());
+}
+
+TEST(Persistent, readerSeesStableSnapshot) {
+  s21::persistent_set<int> set;
+  for (int i = 0; i < 2000; ++i) set.insert(i);
+  s21::persistent_set<int> snapshot = set.snapshot();
+  std::thread writer([&set] {
+    for (int i = 0; i < 2000; i += 2) set.erase(i);
+    for (int i = 2000; i < 4000; ++i) set.insert(i);
+  });
+  long long sum = 0;
+  for (int round = 0; round < 20; ++round) {
+    for (int k : snapshot) sum += k;
+  }
+  writer.join();
+  EXPECT_EQ(sum, 20LL * 1999 * 2000 / 2);
+  EXPECT_EQ(snapshot.size(), 2000u);
+  EXPECT_EQ(set.size(), 3000u);
+  EXPECT_FALSE(set.contains(0));
+  EXPECT_TRUE(snapshot.contains(0));
+  snapshot.clear();
+  EXPECT_EQ(*set.begin(), 1);
+}
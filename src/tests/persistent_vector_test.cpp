@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../s21_containersplus.h"
+
+TEST(PersistentVector, matchesStdVector) {
+  s21::persistent_vector<std::string> vec;
+  std::vector<std::string> expected;
+  std::mt19937 gen(5);
+  for (int i = 0; i < 40000; ++i) {
+    if (!expected.empty() && gen() % 4 == 0) {
+      vec.pop_back();
+      expected.pop_back();
+    } else {
+      vec.push_back(std::to_string(i));
+      expected.push_back(std::to_string(i));
+    }
+  }
+  ASSERT_EQ(vec.size(), expected.size());
+  EXPECT_TRUE(std::equal(vec.begin(), vec.end(), expected.begin()));
+  for (std::size_t i = 0; i < expected.size(); i += 97) {
+    EXPECT_EQ(vec[i], expected[i]);
+  }
+  EXPECT_EQ(vec.back(), expected.back());
+  EXPECT_EQ(vec.front(), expected.front());
+  EXPECT_THROW(vec.at(expected.size()), std::out_of_range);
+  while (!vec.empty()) vec.pop_back();
+  EXPECT_THROW(vec.pop_back(), std::logic_error);
+  EXPECT_THROW(vec.back(), std::logic_error);
+  EXPECT_TRUE(vec.begin() == vec.end());
+}
+
+TEST(PersistentVector, snapshotsAreIndependent) {
+  s21::persistent_vector<int> vec;
+  for (int i = 0; i < 5000; ++i) vec.push_back(i);
+  s21::persistent_vector<int> before = vec.snapshot();
+  for (int i = 0; i < 5000; i += 3) vec.set(i, -i);
+  vec.edit(4999) = 7;
+  for (int i = 0; i < 2000; ++i) vec.pop_back();
+  vec.push_back(42);
+
+  EXPECT_EQ(before.size(), 5000u);
+  std::vector<int> expected(5000);
+  std::iota(expected.begin(), expected.end(), 0);
+  EXPECT_TRUE(std::equal(before.begin(), before.end(), expected.begin()));
+
+  ASSERT_EQ(vec.size(), 3001u);
+  for (int i = 0; i < 3000; ++i) {
+    EXPECT_EQ(vec[i], i % 3 == 0 ? -i : i);
+  }
+  EXPECT_EQ(vec.back(), 42);
+  EXPECT_THROW(vec.edit(3001), std::out_of_range);
+}
+
+TEST(PersistentVector, iteratorIsRandomAccess) {
+  s21::persistent_vector<int> vec = {5, 3, 1};
+  for (int i = 0; i < 100; ++i) vec.push_back(i);
+  auto it = vec.begin() + 70;
+  EXPECT_EQ(*it, 67);
+  EXPECT_EQ(it[-40], 27);
+  EXPECT_EQ(vec.end() - it, 33);
+  --it;
+  EXPECT_EQ(*it, 66);
+  EXPECT_EQ(*std::max_element(vec.begin(), vec.end()), 99);
+  s21::persistent_vector<int> moved = std::move(vec);
+  EXPECT_EQ(moved.size(), 103u);
+  EXPECT_TRUE(vec.empty());
+}
+
+TEST(PersistentVector, decrementFromEnd) {
+  s21::persistent_vector<int> small = {1, 2, 3, 4, 5};
+  EXPECT_EQ(*--small.end(), 5);
+  EXPECT_EQ(*std::prev(small.end()), 5);
+  auto last = small.end();
+  last--;
+  EXPECT_EQ(*last, 5);
+  std::vector<int> reversed(std::make_reverse_iterator(small.end()),
+                            std::make_reverse_iterator(small.begin()));
+  EXPECT_EQ(reversed, std::vector<int>({5, 4, 3, 2, 1}));
+
+  // конец в середине листа дерева и на границе листов
+  for (int size : {33, 64, 70, 1100}) {
+    s21::persistent_vector<int> vec;
+    for (int i = 0; i < size; ++i) vec.push_back(i);
+    auto it = vec.end();
+    for (int i = size - 1; i >= 0; --i) EXPECT_EQ(*--it, i);
+    EXPECT_TRUE(it == vec.begin());
+    auto back = vec.end() - 1;
+    ++back;
+    EXPECT_TRUE(back == vec.end());
+    EXPECT_EQ(*--back, size - 1);
+  }
+}
+
+namespace {
+
+// Копирование бросает, когда кончается бюджет
+struct fragile {
+  static int budget;
+
+  explicit fragile(int v) : value(v) {}
+  fragile(const fragile &other) : value(other.value) {
+    if (budget-- <= 0) throw std::runtime_error("copy failed");
+  }
+  fragile &operator=(const fragile &) = default;
+
+  int value;
+};
+
+int fragile::budget = 0;
+
+}  // namespace
+
+TEST(PersistentVector, failedPushBackKeepsVector) {
+  // рост корня, перенос хвоста в дерево и запись в неполный хвост
+  for (int size : {32, 1056, 40}) {
+    fragile::budget = 1 << 20;
+    s21::persistent_vector<fragile> vec;
+    for (int i = 0; i < size; ++i) vec.push_back(fragile(i));
+    s21::persistent_vector<fragile> snapshot = vec;
+    fragile::budget = 0;
+    EXPECT_THROW(vec.push_back(fragile(-1)), std::runtime_error);
+    fragile::budget = 1 << 20;
+    ASSERT_EQ(vec.size(), std::size_t(size));
+    for (int i = 0; i < size; ++i) EXPECT_EQ(vec[i].value, i);
+    vec.push_back(fragile(size));
+    EXPECT_EQ(vec.size(), std::size_t(size) + 1);
+    EXPECT_EQ(vec[size].value, size);
+    EXPECT_EQ(vec[size - 1].value, size - 1);
+    EXPECT_EQ(snapshot.size(), std::size_t(size));
+  }
+}
@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+
+#include "../s21_containersplus.h"
+
+TEST(PINNED_VECTOR, pointersStayValidWhileGrowing) {
+  s21::pinned_vector<int> v;
+  EXPECT_TRUE(v.empty());
+  v.push_back(7);
+  int *first = &v[0];
+  int *data = v.data();
+  for (int i = 0; i < 200000; ++i) v.push_back(i);
+  EXPECT_EQ(first, &v[0]);
+  EXPECT_EQ(data, v.data());
+  EXPECT_EQ(*first, 7);
+  EXPECT_EQ(v.size(), 200001U);
+  EXPECT_EQ(v.back(), 199999);
+  EXPECT_GE(v.capacity(), v.size());
+}
+
+TEST(PINNED_VECTOR, elementsAreNeverCopied) {
+  s21::pinned_vector<std::unique_ptr<std::string>> v(1000);
+  for (int i = 0; i < 1000; ++i)
+    v.emplace_back(std::make_unique<std::string>(std::to_string(i)));
+  EXPECT_EQ(*v[999], "999");
+  EXPECT_THROW(v.emplace_back(nullptr), std::length_error);
+  EXPECT_THROW(v.reserve(1001), std::length_error);
+  EXPECT_EQ(v.max_size(), 1000U);
+}
+
+TEST(PINNED_VECTOR, moveKeepsAddresses) {
+  s21::pinned_vector<std::string> v = {"a", "b", "c"};
+  std::string *b = &v[1];
+  s21::pinned_vector<std::string> moved(std::move(v));
+  EXPECT_EQ(&moved[1], b);
+  EXPECT_TRUE(v.empty());
+  v.push_back("again");
+  EXPECT_EQ(v.at(0), "again");
+
+  s21::pinned_vector<std::string> copy = moved;
+  EXPECT_NE(&copy[1], b);
+  EXPECT_EQ(copy[1], "b");
+  EXPECT_THROW(copy.at(3), std::out_of_range);
+}
+
+TEST(PINNED_VECTOR, shrinkAndPop) {
+  s21::pinned_vector<long> v;
+  for (long i = 0; i < 100000; ++i) v.push_back(i);
+  long *kept = &v[10];
+  while (v.size() > 11) v.pop_back();
+  v.shrink_to_fit();
+  EXPECT_LT(v.capacity(), 100000U);
+  EXPECT_EQ(kept, &v[10]);
+  EXPECT_EQ(v[10], 10);
+  for (long i = 0; i < 50000; ++i) v.push_back(i);
+  EXPECT_EQ(v[50010], 49999);
+  v.clear();
+  EXPECT_THROW(v.pop_back(), std::logic_error);
+  EXPECT_THROW(v.front(), std::logic_error);
+}
+
+TEST(PINNED_VECTOR, defaultReservationFollowsPointerWidth) {
+  s21::pinned_vector<int> v;
+  std::size_t bytes = std::size_t(1) << (sizeof(void *) >= 8 ? 34 : 28);
+  EXPECT_EQ(v.max_size(), bytes / sizeof(int));
+  // пустой вектор не резервирует и не выделяет ничего
+  EXPECT_EQ(v.capacity(), 0U);
+  EXPECT_EQ(v.data(), nullptr);
+}
@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../s21_containersplus.h"
+
+TEST(Rcu, writersPublishVersions) {
+  s21::rcu_map<int, std::string> map;
+  EXPECT_TRUE(map.empty());
+  map.insert_or_assign(1, "one");
+  map.insert_or_assign(2, "two");
+  std::atomic<int> step(0);
+  // старая версия жива, пока ее читатель не вышел из секции
+  std::thread reader([&] {
+    auto before = map.read();
+    step.store(1);
+    while (step.load() != 2) std::this_thread::yield();
+    EXPECT_EQ(before->at(2), "two");
+    EXPECT_TRUE(before->contains(1));
+  });
+  while (step.load() != 1) std::this_thread::yield();
+  std::thread writer([&] { map.insert_or_assign(2, "deux"); });
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  EXPECT_EQ(map.find(2), std::optional<std::string>("deux"));
+  step.store(2);
+  reader.join();
+  writer.join();
+  EXPECT_EQ(map.erase(1), 1u);
+  EXPECT_EQ(map.erase(1), 0u);
+  EXPECT_EQ(map.find(2), std::optional<std::string>("deux"));
+  EXPECT_FALSE(map.find(1).has_value());
+  EXPECT_EQ(map.size(), 1u);
+  map.update([](s21::map<int, std::string> &items) {
+    items.insert_or_assign(3, "three");
+    items.insert_or_assign(4, "four");
+  });
+  EXPECT_EQ(map.size(), 3u);
+  EXPECT_THROW(map.update([](s21::map<int, std::string> &) {
+    throw std::runtime_error("rejected");
+  }),
+               std::runtime_error);
+  EXPECT_EQ(map.size(), 3u);
+}
+
+TEST(Rcu, wrapsFrozenMap) {
+  s21::map<int, int> source;
+  for (int i = 0; i < 100; ++i) source.insert_or_assign(i, i * i);
+  s21::rcu_map<int, int, s21::frozen_map<int, int>> map(
+      (s21::frozen_map<int, int>(source)));
+  EXPECT_EQ(map.find(9), std::optional<int>(81));
+  source.insert_or_assign(100, 10000);
+  map.assign(s21::frozen_map<int, int>(source));
+  EXPECT_EQ(map.find(100), std::optional<int>(10000));
+  EXPECT_FALSE(map.contains(101));
+}
+
+TEST(Rcu, readersSeeWholeVersions) {
+  const int kKeys = 64;
+  s21::rcu_map<int, int> map;
+  map.update([](s21::map<int, int> &items) {
+    for (int key = 0; key < kKeys; ++key) items.insert_or_assign(key, 0);
+  });
+  std::atomic<bool> stop(false);
+  std::atomic<long> checked(0);
+  std::vector<std::thread> readers;
+  for (int t = 0; t < 3; ++t) {
+    readers.emplace_back([&] {
+      while (!stop.load()) {
+        // все значения одной версии одинаковы
+        auto version = map.read();
+        int first = version->at(0);
+        for (int key = 1; key < kKeys; ++key) {
+          if (version->at(key) != first) {
+            ADD_FAILURE() << "torn version";
+            return;
+          }
+        }
+        checked.fetch_add(1);
+      }
+    });
+  }
+  while (checked.load() == 0) std::this_thread::yield();
+  for (int round = 1; round <= 100; ++round) {
+    map.update([round](s21::map<int, int> &items) {
+      for (int key = 0; key < kKeys; ++key) {
+        items.insert_or_assign(key, round);
+      }
+    });
+  }
+  stop.store(true);
+  for (std::thread &reader : readers) reader.join();
+  EXPECT_EQ(map.find(kKeys - 1), std::optional<int>(100));
+  EXPECT_GT(checked.load(), 0);
+}
+
+TEST(Rcu, writeWhileReadingThrows) {
+  s21::rcu_map<int, int> map;
+  s21::rcu_map<int, int> other;
+  map.insert_or_assign(1, 10);
+  {
+    auto version = map.read();
+    EXPECT_THROW(map.insert_or_assign(2, 20), std::logic_error);
+    EXPECT_THROW(map.erase(1), std::logic_error);
+    EXPECT_THROW(other.assign(s21::map<int, int>()), std::logic_error);
+    EXPECT_EQ(version->at(1), 10);
+  }
+  EXPECT_EQ(map.size(), 1U);
+  map.insert_or_assign(2, 20);
+  EXPECT_EQ(map.find(2), std::optional<int>(20));
+}
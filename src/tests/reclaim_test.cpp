@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "../s21_containersplus.h"
+
+namespace {
+
+// Считает живые объекты, чтобы проверить, что освобождено все
+struct tracked {
+  static std::atomic<long> alive;
+  explicit tracked(long v) : value(v) { alive.fetch_add(1); }
+  ~tracked() {
+    value = -1;
+    alive.fetch_sub(1);
+  }
+  long value;
+};
+
+std::atomic<long> tracked::alive(0);
+
+// Читатели разыменовывают общий указатель, писатели подменяют его и
+// отдают старый объект домену. Освобождение раньше времени ASan ловит
+// как use-after-free, а value == -1 - как чтение удаленного объекта
+template <typename Read, typename Retire>
+void churn(std::atomic<tracked *> &shared, Read read, Retire retire) {
+  std::atomic<bool> stop(false);
+  std::vector<std::thread> readers;
+  for (int t = 0; t < 3; ++t) {
+    readers.emplace_back([&] {
+      while (!stop.load()) {
+        if (read() < 0) ADD_FAILURE() << "read a freed object";
+      }
+    });
+  }
+  std::vector<std::thread> writers;
+  for (int t = 0; t < 2; ++t) {
+    writers.emplace_back([&, t] {
+      for (long i = 0; i < 20000; ++i) {
+        retire(shared.exchange(new tracked(t * 100000 + i)));
+      }
+    });
+  }
+  for (std::thread &writer : writers) writer.join();
+  stop.store(true);
+  for (std::thread &reader : readers) reader.join();
+}
+
+}  // namespace
+
+TEST(Reclaim, epochStress) {
+  auto &domain = s21::reclaim::epoch_domain::global();
+  std::atomic<tracked *> shared(new tracked(0));
+  churn(
+      shared,
+      [&] {
+        s21::reclaim::epoch_domain::guard guard;
+        return shared.load()->value;
+      },
+      [&](tracked *old) { domain.retire(old); });
+  delete shared.load();
+  // мусор завершившихся потоков освобождается следующими collect
+  for (int i = 0; i < 4; ++i) domain.collect();
+  EXPECT_EQ(tracked::alive.load(), 0);
+}
+
+TEST(Reclaim, epochGuardDelaysFree) {
+  auto &domain = s21::reclaim::epoch_domain::global();
+  domain.register_thread();
+  std::atomic<int> step(0);
+  std::thread reader([&] {
+    s21::reclaim::epoch_domain::guard guard;
+    step.store(1);
+    while (step.load() != 2) std::this_thread::yield();
+  });
+  while (step.load() != 1) std::this_thread::yield();
+  domain.retire(new tracked(1));
+  for (int i = 0; i < 4; ++i) domain.collect();
+  EXPECT_EQ(tracked::alive.load(), 1);
+  EXPECT_EQ(domain.pending(), 1u);
+  step.store(2);
+  reader.join();
+  for (int i = 0; i < 4; ++i) domain.collect();
+  EXPECT_EQ(tracked::alive.load(), 0);
+  domain.unregister_thread();
+}
+
+TEST(Reclaim, hazardStress) {
+  auto &domain = s21::reclaim::hazard_domain::global();
+  std::atomic<tracked *> shared(new tracked(0));
+  churn(
+      shared,
+      [&] {
+        s21::reclaim::hazard_domain::hazard_pointer hazard;
+        return hazard.protect(shared)->value;
+      },
+      [&](tracked *old) {
+        domain.retire(old);
+        // мусора не больше порога сканирования
+        if (domain.pending() > domain.threshold()) {
+          ADD_FAILURE() << "unbounded garbage";
+        }
+      });
+  delete shared.load();
+  domain.collect();
+  EXPECT_EQ(tracked::alive.load(), 0);
+}
+
+TEST(Reclaim, hazardKeepsProtectedObject) {
+  auto &domain = s21::reclaim::hazard_domain::global();
+  std::atomic<tracked *> shared(new tracked(7));
+  {
+    s21::reclaim::hazard_domain::hazard_pointer hazard;
+    tracked *held = hazard.protect(shared);
+    domain.retire(shared.exchange(nullptr));
+    // retire сам сканирует слоты по достижении порога
+    for (long i = 0; i < 100; ++i) domain.retire(new tracked(i));
+    domain.collect();
+    EXPECT_EQ(domain.pending(), 1u);
+    EXPECT_EQ(held->value, 7);
+    EXPECT_EQ(tracked::alive.load(), 1);
+  }
+  EXPECT_EQ(domain.collect(), 1u);
+  EXPECT_EQ(tracked::alive.load(), 0);
+
+  s21::reclaim::hazard_domain::hazard_pointer slots[4];
+  EXPECT_THROW(s21::reclaim::hazard_domain::hazard_pointer(),
+               std::length_error);
+}
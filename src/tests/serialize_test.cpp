@@ -0,0 +1,265 @@
+#include <fcntl.h>
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "../s21_containers.h"
+#include "../s21_containersplus.h"
+
+namespace {
+
+struct point {
+  double x;
+  int id;
+};
+
+std::string temp_path(const char *name) {
+  return testing::TempDir() + name;
+}
+
+template <typename C>
+std::vector<unsigned char> to_bytes(const C &container) {
+  std::vector<unsigned char> bytes;
+  s21::buffer_writer out(bytes);
+  s21::save(out, container);
+  return bytes;
+}
+
+template <typename C>
+bool same_items(const C &one, const C &two) {
+  if (one.size() != two.size()) return false;
+  auto it = two.begin();
+  for (const auto &item : one) {
+    if (!(item == *it++)) return false;
+  }
+  return true;
+}
+
+// Читатель без remaining, как у файловых потоков
+class blind_reader {
+ public:
+  explicit blind_reader(const std::vector<unsigned char> &bytes)
+      : in_(bytes) {}
+  void read(void *data, std::size_t size) { in_.read(data, size); }
+
+ private:
+  s21::buffer_reader in_;
+};
+
+}  // namespace
+
+TEST(SERIALIZE, vectorOfTrivialIsOneBlock) {
+  s21::vector<point> v;
+  for (int i = 0; i < 1000; ++i) v.push_back({i * 0.25, i});
+  std::vector<unsigned char> bytes = to_bytes(v);
+  EXPECT_EQ(bytes.size(), 20 + v.size() * sizeof(point));
+
+  s21::vector<point> loaded{{1.0, 1}};
+  s21::buffer_reader in(bytes);
+  s21::load(in, loaded);
+  ASSERT_EQ(loaded.size(), v.size());
+  EXPECT_EQ(loaded[999].id, 999);
+  EXPECT_DOUBLE_EQ(loaded[4].x, 1.0);
+  EXPECT_EQ(in.remaining(), 0U);
+}
+
+TEST(SERIALIZE, sequencesAndAdapters) {
+  s21::list<std::string> l{"a", "", "long string value"};
+  s21::array<int, 4> a{1, 2, 3, 4};
+  s21::stack<int> s{1, 2, 3};
+  s21::queue<std::string> q{"x", "y"};
+  s21::list<s21::vector<int>> nested{{1, 2}, {}, {3}};
+
+  std::vector<unsigned char> bytes;
+  s21::buffer_writer out(bytes);
+  s21::save(out, l);
+  s21::save(out, a);
+  s21::save(out, s);
+  s21::save(out, q);
+  s21::save(out, nested);
+
+  s21::list<std::string> l2;
+  s21::array<int, 4> a2;
+  s21::stack<int> s2;
+  s21::queue<std::string> q2;
+  s21::list<s21::vector<int>> nested2;
+  s21::buffer_reader in(bytes);
+  s21::load(in, l2);
+  s21::load(in, a2);
+  s21::load(in, s2);
+  s21::load(in, q2);
+  s21::load(in, nested2);
+
+  EXPECT_TRUE(same_items(l2, l));
+  EXPECT_EQ(a2[3], 4);
+  EXPECT_EQ(s2.size(), 3U);
+  EXPECT_EQ(s2.top(), 3);
+  EXPECT_EQ(q2.front(), "x");
+  EXPECT_EQ(q2.back(), "y");
+  ASSERT_EQ(nested2.size(), 3U);
+  EXPECT_EQ(nested2.front()[1], 2);
+  EXPECT_EQ(nested2.back()[0], 3);
+  EXPECT_EQ(in.remaining(), 0U);
+}
+
+TEST(SERIALIZE, treesThroughFile) {
+  s21::map<int, std::string> m;
+  s21::set<int> st;
+  s21::multiset<int> ms{5, 1, 5, 3, 1};
+  for (int i = 0; i < 5000; ++i) {
+    m.insert(i * 3, std::to_string(i));
+    st.insert(-i);
+  }
+
+  std::FILE *file = std::tmpfile();
+  ASSERT_NE(file, nullptr);
+  s21::file_writer out(file);
+  s21::save(out, m);
+  s21::save(out, st);
+  s21::save(out, ms);
+  std::rewind(file);
+
+  s21::map<int, std::string> m2;
+  s21::set<int> st2{42};
+  s21::multiset<int> ms2;
+  s21::file_reader in(file);
+  s21::load(in, m2);
+  s21::load(in, st2);
+  s21::load(in, ms2);
+  std::fclose(file);
+
+  EXPECT_EQ(m2.size(), m.size());
+  EXPECT_EQ(m2.at(300), "100");
+  EXPECT_TRUE(m2.contains(14997));
+  EXPECT_EQ(st2.size(), 5000U);
+  EXPECT_FALSE(st2.contains(42));
+  EXPECT_EQ(*st2.begin(), -4999);
+  EXPECT_EQ(ms2.size(), 5U);
+  EXPECT_EQ(ms2.count(5), 2U);
+  m2.insert(1, "one");
+  EXPECT_EQ(m2.size(), m.size() + 1);
+}
+
+TEST(SERIALIZE, fileDescriptorRoundTrip) {
+  std::string path = temp_path("s21_serialize_fd.bin");
+  s21::vector<int> v;
+  s21::list<int> l;
+  for (int i = 0; i < 100000; ++i) {
+    v.push_back(i);
+    l.push_back(-i);
+  }
+  {
+    int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    ASSERT_GE(fd, 0);
+    s21::fd_writer out(fd);
+    s21::save(out, l);
+    s21::save(out, v);
+    out.flush();
+    ::close(fd);
+  }
+  int fd = ::open(path.c_str(), O_RDONLY);
+  ASSERT_GE(fd, 0);
+  s21::fd_reader in(fd);
+  s21::list<int> l2;
+  s21::vector<int> v2;
+  s21::load(in, l2);
+  s21::load(in, v2);
+  ::close(fd);
+  std::remove(path.c_str());
+  EXPECT_TRUE(same_items(l2, l));
+  ASSERT_EQ(v2.size(), v.size());
+  EXPECT_EQ(v2[77777], 77777);
+}
+
+TEST(SERIALIZE, rejectsBadInput) {
+  s21::set<int> st{1, 2, 3};
+  std::vector<unsigned char> bytes = to_bytes(st);
+
+  s21::set<int> target{7};
+  std::vector<unsigned char> truncated(bytes.begin(), bytes.end() - 2);
+  s21::buffer_reader short_in(truncated);
+  EXPECT_THROW(s21::load(short_in, target), std::runtime_error);
+  EXPECT_TRUE(target.contains(7));
+
+  s21::multiset<int> wrong_kind;
+  s21::buffer_reader kind_in(bytes);
+  EXPECT_THROW(s21::load(kind_in, wrong_kind), std::runtime_error);
+
+  s21::set<long long> wrong_size;
+  s21::buffer_reader size_in(bytes);
+  EXPECT_THROW(s21::load(size_in, wrong_size), std::runtime_error);
+
+  std::vector<unsigned char> bad_magic = bytes;
+  bad_magic[0] = 'X';
+  s21::buffer_reader magic_in(bad_magic);
+  EXPECT_THROW(s21::load(magic_in, target), std::runtime_error);
+
+  std::vector<unsigned char> unsorted = bytes;
+  unsorted[20] = 9;
+  s21::buffer_reader order_in(unsorted);
+  EXPECT_THROW(s21::load(order_in, target), std::runtime_error);
+  EXPECT_EQ(target.size(), 1U);
+
+  s21::array<int, 3> small;
+  std::vector<unsigned char> array_bytes = to_bytes(s21::array<int, 4>{});
+  s21::buffer_reader array_in(array_bytes);
+  EXPECT_THROW(s21::load(array_in, small), std::runtime_error);
+}
+
+TEST(SERIALIZE, assignSortedBuildsBalancedTree) {
+  s21::set<int> st{100};
+  int next = 0;
+  st.assign_sorted(1000, [&next] { return next++ * 2; });
+  EXPECT_EQ(st.size(), 1000U);
+  EXPECT_TRUE(st.contains(1998));
+  EXPECT_FALSE(st.contains(100 + 1));
+  st.insert(1);
+  st.erase(st.find(0));
+  EXPECT_EQ(*st.begin(), 1);
+
+  int repeated = 0;
+  EXPECT_THROW(st.assign_sorted(3, [&repeated] { return repeated; }),
+               std::invalid_argument);
+  EXPECT_TRUE(st.empty());
+
+  s21::multiset<int> ms;
+  ms.assign_sorted(3, [] { return 5; });
+  EXPECT_EQ(ms.count(5), 3U);
+}
+
+TEST(SERIALIZE, rejectsCorruptedVectorCount) {
+  s21::vector<int> v{1, 2, 3};
+  std::vector<unsigned char> bytes = to_bytes(v);
+  // число элементов лежит после сигнатуры и размера элемента
+  const std::size_t kCountOffset = 12;
+  const std::uint64_t counts[] = {~std::uint64_t(0),
+                                  ~std::uint64_t(0) / sizeof(int),
+                                  std::uint64_t(1) << 40, 4};
+  for (std::uint64_t count : counts) {
+    std::vector<unsigned char> corrupted = bytes;
+    std::memcpy(corrupted.data() + kCountOffset, &count, sizeof(count));
+    s21::vector<int> target{7, 8};
+    s21::buffer_reader in(corrupted);
+    EXPECT_THROW(s21::load(in, target), std::runtime_error);
+    blind_reader blind(corrupted);
+    EXPECT_THROW(s21::load(blind, target), std::runtime_error);
+    ASSERT_EQ(target.size(), 2U);
+    EXPECT_EQ(target[0], 7);
+  }
+
+  s21::vector<int> big;
+  for (int i = 0; i < 200000; ++i) big.push_back(i);
+  std::vector<unsigned char> big_bytes = to_bytes(big);
+  s21::vector<int> loaded;
+  blind_reader blind(big_bytes);
+  s21::load(blind, loaded);
+  ASSERT_EQ(loaded.size(), big.size());
+  EXPECT_EQ(loaded[65535], 65535);
+  EXPECT_EQ(loaded[65536], 65536);
+  EXPECT_EQ(loaded[199999], 199999);
+}
@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 
+#include <memory>
+
 #include "../s21_containers.h"
 
 TEST(set_test, constructor_1) {
@@ -483,3 +485,196 @@ TEST(set_test, insert_many_4) {
     EXPECT_EQ(*s21_it, *exm_it);
   }
 }
+
+namespace {
+// тип без конструктора по умолчанию
+struct NoDefaultKey {
+  explicit NoDefaultKey(int v) : value(v) {}
+  bool operator<(const NoDefaultKey& other) const {
+    return value < other.value;
+  }
+  bool operator==(const NoDefaultKey& other) const {
+    return value == other.value;
+  }
+  int value;
+};
+}  // namespace
+
+TEST(set_test, no_default_constructor) {
+  s21::set<NoDefaultKey> s21_set;
+  EXPECT_TRUE(s21_set.begin() == s21_set.end());
+  s21_set.insert(NoDefaultKey(3));
+  s21_set.insert(NoDefaultKey(1));
+  s21_set.insert(NoDefaultKey(2));
+  int expected = 1;
+  for (auto it = s21_set.begin(); it != s21_set.end(); it++, expected++) {
+    EXPECT_EQ((*it).value, expected);
+  }
+  EXPECT_TRUE(s21_set.contains(NoDefaultKey(2)));
+}
+
+TEST(set_test, move_noexcept) {
+  static_assert(std::is_nothrow_default_constructible<s21::set<int>>::value);
+  static_assert(std::is_nothrow_move_constructible<s21::set<int>>::value);
+  static_assert(std::is_nothrow_move_assignable<s21::set<int>>::value);
+
+  s21::set<int> s21_set = {5, 1, 4, 2, 3};
+  auto it_min = s21_set.begin();
+  s21::set<int> s21_moved(std::move(s21_set));
+  EXPECT_TRUE(s21_set.empty());
+  EXPECT_TRUE(s21_set.begin() == s21_set.end());
+  EXPECT_TRUE(it_min == s21_moved.begin());
+  int expected = 5;
+  for (auto it = --s21_moved.end(); expected > 0; it--, expected--) {
+    EXPECT_EQ(*it, expected);
+  }
+
+  s21::set<int> s21_other = {10};
+  s21_other.swap(s21_moved);
+  EXPECT_EQ(s21_other.size(), 5U);
+  EXPECT_EQ(*s21_moved.begin(), 10);
+  s21_set = std::move(s21_other);
+  s21_set.insert(6);
+  EXPECT_EQ(*(--s21_set.end()), 6);
+  EXPECT_EQ(s21_set.size(), 6U);
+}
+
+TEST(set_test, copy_is_independent) {
+  s21::set<int> s21_copy;
+  {
+    s21::set<int> s21_set = {3, 1, 2};
+    s21_copy = s21_set;
+  }
+  int expected = 1;
+  for (auto it = s21_copy.begin(); it != s21_copy.end(); it++, expected++) {
+    EXPECT_EQ(*it, expected);
+  }
+  EXPECT_EQ(expected, 4);
+}
+
+TEST(set_test, emplace) {
+  s21::set<std::string> s21_set = {"b"};
+  auto res = s21_set.emplace(3, 'a');
+  EXPECT_TRUE(res.second);
+  EXPECT_EQ(*res.first, "aaa");
+  res = s21_set.emplace("b");
+  EXPECT_FALSE(res.second);
+  EXPECT_EQ(*res.first, "b");
+  EXPECT_EQ(s21_set.size(), 2U);
+}
+
+TEST(set_test, emplace_hint) {
+  s21::set<int> s21_set;
+  std::set<int> std_set;
+  for (int i = 0; i < 100; i++) {
+    s21_set.emplace_hint(s21_set.end(), i);
+    std_set.emplace_hint(std_set.end(), i);
+  }
+  for (int i = 199; i >= 100; i--) {
+    s21_set.emplace_hint(s21_set.find(99), i);
+    std_set.emplace_hint(std_set.find(99), i);
+  }
+  auto it = s21_set.emplace_hint(s21_set.begin(), 50);
+  EXPECT_EQ(*it, 50);
+  it = s21_set.emplace_hint(s21_set.begin(), -1);
+  EXPECT_EQ(*it, -1);
+  std_set.insert(-1);
+  EXPECT_EQ(s21_set.size(), std_set.size());
+  auto std_it = std_set.begin();
+  for (auto s21_it = s21_set.begin(); s21_it != s21_set.end();
+       s21_it++, std_it++) {
+    EXPECT_EQ(*s21_it, *std_it);
+  }
+}
+
+TEST(set_test, insert_many_move_only) {
+  s21::set<std::unique_ptr<int>> s21_set;
+  auto first = std::make_unique<int>(1);
+  int* raw = first.get();
+  auto res = s21_set.insert_many(std::move(first), std::make_unique<int>(2));
+  EXPECT_EQ(s21_set.size(), 2U);
+  EXPECT_TRUE(res[0].second);
+  EXPECT_EQ((*res[0].first).get(), raw);
+}
+
+TEST(set_test, extract_insert_node) {
+  s21::set<std::string> active = {"a", "b", "c"};
+  s21::set<std::string> expired;
+  const std::string* address = &*active.find("b");
+
+  auto nh = active.extract("b");
+  EXPECT_FALSE(nh.empty());
+  EXPECT_EQ(nh.value(), "b");
+  EXPECT_EQ(active.size(), 2U);
+  EXPECT_FALSE(active.contains("b"));
+
+  auto res = expired.insert(std::move(nh));
+  EXPECT_TRUE(res.inserted);
+  EXPECT_TRUE(res.node.empty());
+  EXPECT_EQ(&*res.position, address);
+  EXPECT_EQ(expired.size(), 1U);
+
+  auto dup = active.extract(active.begin());
+  EXPECT_EQ(dup.value(), "a");
+  expired.insert("a");
+  res = expired.insert(std::move(dup));
+  EXPECT_FALSE(res.inserted);
+  EXPECT_FALSE(res.node.empty());
+  EXPECT_EQ(*res.position, "a");
+
+  EXPECT_TRUE(active.extract("missing").empty());
+  EXPECT_TRUE(active.extract(active.end()).empty());
+  res = expired.insert(s21::set<std::string>::node_type());
+  EXPECT_FALSE(res.inserted);
+
+  auto last = active.extract("c");
+  EXPECT_TRUE(active.empty());
+  EXPECT_TRUE(active.begin() == active.end());
+  active.insert(std::move(last));
+  EXPECT_EQ(*active.begin(), "c");
+  EXPECT_EQ(*(--active.end()), "c");
+}
+
+TEST(set_test, erase_range) {
+  s21::set<int> s21_set;
+  std::set<int> std_set;
+  for (int i = 0; i < 1000; i++) {
+    s21_set.insert(i);
+    std_set.insert(i);
+  }
+  // маленький диапазон удаляется поэлементно
+  auto it = s21_set.erase(s21_set.find(10), s21_set.find(13));
+  std_set.erase(std_set.find(10), std_set.find(13));
+  EXPECT_EQ(*it, 13);
+  // большой диапазон удаляется с перестройкой дерева
+  it = s21_set.erase(s21_set.find(100), s21_set.find(900));
+  std_set.erase(std_set.find(100), std_set.find(900));
+  EXPECT_EQ(*it, 900);
+  s21_set.insert(500);
+  std_set.insert(500);
+
+  EXPECT_EQ(s21_set.size(), std_set.size());
+  auto std_it = std_set.begin();
+  for (auto s21_it = s21_set.begin(); s21_it != s21_set.end();
+       s21_it++, std_it++) {
+    EXPECT_EQ(*s21_it, *std_it);
+  }
+  EXPECT_EQ(*(--s21_set.end()), 999);
+
+  s21_set.erase(s21_set.begin(), s21_set.end());
+  EXPECT_TRUE(s21_set.empty());
+}
+
+TEST(set_test, erase_if) {
+  s21::set<int> s21_set;
+  for (int i = 0; i < 100; i++) s21_set.insert(i);
+  auto kept = s21_set.find(52);
+  auto removed = s21::erase_if(s21_set, [](int x) { return x % 3 == 0; });
+  EXPECT_EQ(removed, 34U);
+  EXPECT_EQ(s21_set.size(), 66U);
+  EXPECT_EQ(*kept, 52);
+  EXPECT_FALSE(s21_set.contains(51));
+  EXPECT_TRUE(s21_set.insert(3).second);
+  EXPECT_EQ(*s21_set.begin(), 1);
+  EXPECT_EQ(*(--s21_set.end()), 98);
+}
@@ -0,0 +1,242 @@
+#include <gtest/gtest.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <random>
+#include <shared_mutex>
+#include <stdexcept>
+#include <string>
+
+#include "../s21_containersplus.h"
+
+namespace {
+
+struct route {
+  std::uint32_t next_hop;
+  std::uint16_t metric;
+};
+
+std::string segment_name(const char *tag) {
+  return "/s21_test_" + std::string(tag) + "_" + std::to_string(getpid());
+}
+
+// Объект, конструктор которого сам выделяет память в сегменте
+struct preloaded {
+  preloaded(s21::shm_segment &segment, int count) : items(segment) {
+    for (int i = 0; i < count; ++i) items.push_back(i);
+    if (count < 0) throw std::invalid_argument("negative count");
+  }
+  s21::shm_list<int> items;
+};
+
+}  // namespace
+
+TEST(SHM, offsetPtrSurvivesCopy) {
+  int values[2] = {1, 2};
+  s21::offset_ptr<int> a(&values[0]);
+  s21::offset_ptr<int> b;
+  EXPECT_FALSE(b);
+  b = a;
+  EXPECT_EQ(b.get(), &values[0]);
+  EXPECT_EQ(*b, 1);
+  b = &values[1];
+  EXPECT_TRUE(a != b);
+  b = nullptr;
+  EXPECT_EQ(b.get(), nullptr);
+}
+
+TEST(SHM, listInSegment) {
+  std::string name = segment_name("list");
+  s21::shm_segment segment(name, 1 << 20, s21::shm_mode::create);
+  auto &items = segment.find_or_construct<s21::shm_list<int>>("items");
+  EXPECT_THROW(items.front(), std::out_of_range);
+  for (int i = 0; i < 100; ++i) items.push_back(i);
+  items.push_front(-1);
+  EXPECT_EQ(items.size(), 101U);
+  EXPECT_EQ(items.front(), -1);
+  EXPECT_EQ(items.back(), 99);
+  items.pop_front();
+  items.erase(items.begin());
+  int expected = 1;
+  for (int value : items) EXPECT_EQ(value, expected++);
+  EXPECT_EQ(&items, segment.find<s21::shm_list<int>>("items"));
+  std::size_t used = segment.used_bytes();
+  EXPECT_TRUE(segment.destroy<s21::shm_list<int>>("items"));
+  EXPECT_LT(segment.used_bytes(), used);
+  EXPECT_EQ(segment.find<s21::shm_list<int>>("items"), nullptr);
+  s21::shm_segment::remove(name);
+}
+
+TEST(SHM, setMatchesStdUnderRandomOps) {
+  std::string name = segment_name("set");
+  s21::shm_segment segment(name, 4 << 20, s21::shm_mode::create);
+  auto &items = segment.find_or_construct<s21::shm_set<int>>("set");
+  std::map<int, bool> model;
+  std::mt19937 gen(3);
+  for (int i = 0; i < 20000; ++i) {
+    int key = int(gen() % 2000);
+    if (gen() % 3 == 0) {
+      EXPECT_EQ(items.erase(key), model.erase(key));
+    } else {
+      EXPECT_EQ(items.insert(key).second, model.emplace(key, true).second);
+    }
+    if (i % 1000 == 0) {
+      // обход от найденного ключа идет по списку соседей
+      auto from = items.lower_bound(key);
+      for (auto expected = model.lower_bound(key); expected != model.end();
+           ++expected) {
+        ASSERT_TRUE(from != items.end());
+        EXPECT_EQ(*from++, expected->first);
+      }
+      EXPECT_TRUE(from == items.end());
+    }
+  }
+  ASSERT_EQ(items.size(), model.size());
+  auto it = items.begin();
+  for (const auto &entry : model) EXPECT_EQ(*it++, entry.first);
+  EXPECT_TRUE(it == items.end());
+  items.clear();
+  EXPECT_TRUE(items.empty());
+  s21::shm_segment::remove(name);
+}
+
+TEST(SHM, mapSharedBetweenProcesses) {
+  std::string name = segment_name("map");
+  s21::shm_segment segment(name, 8 << 20, s21::shm_mode::create);
+  auto &routes =
+      segment.find_or_construct<s21::shm_map<std::uint32_t, route>>("routes");
+  for (std::uint32_t i = 0; i < 1000; ++i) {
+    routes.insert(i, {i + 1, std::uint16_t(i % 7)});
+  }
+
+  pid_t child = fork();
+  ASSERT_GE(child, 0);
+  if (child == 0) {
+    // другой процесс отображает сегмент по своему адресу
+    int status = 0;
+    try {
+      s21::shm_segment attached(name, 0, s21::shm_mode::open);
+      auto *shared =
+          attached.find<s21::shm_map<std::uint32_t, route>>("routes");
+      std::unique_lock<s21::shm_segment> lock(attached);
+      if (shared == nullptr || shared->at(500).next_hop != 501) status = 1;
+      for (std::uint32_t i = 1000; i < 2000; ++i) {
+        shared->insert(i, {i * 2, 1});
+      }
+      shared->erase(0);
+      shared->insert_or_assign(1, {42, 0});
+    } catch (...) {
+      status = 2;
+    }
+    _exit(status);
+  }
+  int status = -1;
+  waitpid(child, &status, 0);
+  ASSERT_TRUE(WIFEXITED(status));
+  EXPECT_EQ(WEXITSTATUS(status), 0);
+
+  std::shared_lock<s21::shm_segment> lock(segment);
+  EXPECT_EQ(routes.size(), 1999U);
+  EXPECT_FALSE(routes.contains(0));
+  EXPECT_EQ(routes.at(1).next_hop, 42U);
+  EXPECT_EQ(routes.at(1999).next_hop, 3998U);
+  EXPECT_THROW(routes.at(5000), std::out_of_range);
+  std::uint32_t previous = 0;
+  for (const auto &entry : routes) {
+    EXPECT_GT(entry.first, previous);
+    previous = entry.first;
+  }
+  s21::shm_segment::remove(name);
+}
+
+TEST(SHM, segmentErrors) {
+  std::string name = segment_name("errors");
+  EXPECT_THROW(s21::shm_segment(name, 0, s21::shm_mode::open),
+               std::system_error);
+  s21::shm_segment segment(name, 64 << 10, s21::shm_mode::create);
+  EXPECT_THROW(s21::shm_segment(name, 0, s21::shm_mode::create),
+               std::system_error);
+  auto &items = segment.find_or_construct<s21::shm_list<std::uint64_t>>("l");
+  auto fill = [&items] {
+    for (int i = 0; i < 100000; ++i) items.push_back(i);
+  };
+  EXPECT_THROW(fill(), std::bad_alloc);
+  items.clear();
+  EXPECT_NO_THROW(items.push_back(1));
+  s21::shm_segment::remove(name);
+}
+
+TEST(SHM, constructorMayAllocate) {
+  std::string name = segment_name("ctor");
+  s21::shm_segment segment(name, 1 << 20, s21::shm_mode::create);
+  auto &first = segment.find_or_construct<preloaded>("preloaded", 50);
+  EXPECT_EQ(first.items.size(), 50U);
+  EXPECT_EQ(first.items.back(), 49);
+  auto &again = segment.find_or_construct<preloaded>("preloaded", 7);
+  EXPECT_EQ(&again, &first);
+  EXPECT_EQ(again.items.size(), 50U);
+
+  // неудачный конструктор освобождает имя
+  EXPECT_THROW(segment.find_or_construct<preloaded>("failed", -1),
+               std::invalid_argument);
+  EXPECT_EQ(segment.find<preloaded>("failed"), nullptr);
+  auto &retried = segment.find_or_construct<preloaded>("failed", 3);
+  EXPECT_EQ(retried.items.size(), 3U);
+  EXPECT_TRUE(segment.destroy<preloaded>("failed"));
+  s21::shm_segment::remove(name);
+}
+
+namespace {
+
+// Процесс умирает посреди конструктора
+struct half_built {
+  half_built(s21::shm_segment &, bool die) : value(7) {
+    if (die) _exit(0);
+  }
+  int value;
+};
+
+}  // namespace
+
+TEST(SHM, constructorOfDeadProcessIsReclaimed) {
+  std::string name = segment_name("orphan");
+  s21::shm_segment segment(name, 1 << 20, s21::shm_mode::create);
+  pid_t child = fork();
+  ASSERT_GE(child, 0);
+  if (child == 0) {
+    segment.find_or_construct<half_built>("object", true);
+    _exit(1);
+  }
+  int status = 0;
+  ASSERT_EQ(waitpid(child, &status, 0), child);
+  ASSERT_TRUE(WIFEXITED(status));
+  EXPECT_EQ(WEXITSTATUS(status), 0);
+  EXPECT_EQ(segment.find<half_built>("object"), nullptr);
+  EXPECT_EQ(segment.find_or_construct<half_built>("object", false).value, 7);
+  s21::shm_segment::remove(name);
+}
+
+#if S21_SHM_ROBUST
+TEST(SHM, allocatorSurvivesCrashedOwner) {
+  std::string name = segment_name("robust");
+  s21::shm_segment segment(name, 1 << 20, s21::shm_mode::create);
+  auto &items = segment.find_or_construct<s21::shm_list<int>>("items");
+  items.push_back(1);
+  pid_t child = fork();
+  ASSERT_GE(child, 0);
+  if (child == 0) {
+    // процесс падает, держа мьютекс распределителя
+    pthread_mutex_lock(&segment.header()->alloc_mutex);
+    _exit(0);
+  }
+  int status = 0;
+  ASSERT_EQ(waitpid(child, &status, 0), child);
+  items.push_back(2);
+  EXPECT_EQ(items.size(), 2U);
+  EXPECT_GT(segment.used_bytes(), 0U);
+  s21::shm_segment::remove(name);
+}
+#endif
@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../s21_containers.h"
+#include "../s21_containersplus.h"
+#include "../s21_sort.h"
+
+namespace {
+
+template <typename T>
+s21::vector<T> random_vector(std::size_t n, T low, T high, unsigned seed) {
+  std::mt19937_64 gen(seed);
+  s21::vector<T> result(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    if constexpr (std::is_floating_point_v<T>)
+      result[i] = std::uniform_real_distribution<T>(low, high)(gen);
+    else
+      result[i] = std::uniform_int_distribution<T>(low, high)(gen);
+  }
+  return result;
+}
+
+template <typename T, typename Compare = std::less<>>
+void expect_sorted_like_std(s21::vector<T> v, Compare comp = Compare()) {
+  std::vector<T> expected(v.begin(), v.end());
+  std::sort(expected.begin(), expected.end(), comp);
+  s21::sort(v.begin(), v.end(), comp);
+  ASSERT_EQ(v.size(), expected.size());
+  EXPECT_TRUE(std::equal(v.begin(), v.end(), expected.begin()));
+}
+
+struct record {
+  std::int64_t key = 0;
+  int order = 0;
+};
+
+}  // namespace
+
+TEST(SORT, radixIntegers) {
+  for (std::size_t n : {0, 1, 63, 64, 1000, 20000}) {
+    expect_sorted_like_std(random_vector<int>(n, -1000000, 1000000, n));
+    expect_sorted_like_std(
+        random_vector<std::uint64_t>(n, 0, UINT64_MAX, n + 1));
+    expect_sorted_like_std(
+        random_vector<std::int16_t>(n, -32768, 32767, n + 2));
+  }
+}
+
+TEST(SORT, radixFloatingPoint) {
+  s21::vector<double> v = random_vector<double>(5000, -1e9, 1e9, 7);
+  v[10] = -0.0;
+  v[20] = 0.0;
+  v[30] = -1e300;
+  v[40] = std::numeric_limits<double>::infinity();
+  expect_sorted_like_std(v);
+  expect_sorted_like_std(random_vector<float>(5000, -1.0f, 1.0f, 8));
+}
+
+TEST(SORT, pdqsortComparatorsAndPatterns) {
+  const std::size_t n = 5000;
+  s21::vector<int> random = random_vector<int>(n, 0, 100, 3);
+  s21::vector<int> ascending(n), descending(n), equal(n), organ(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    ascending[i] = int(i);
+    descending[i] = int(n - i);
+    equal[i] = 5;
+    organ[i] = int(i < n / 2 ? i : n - i);
+  }
+  for (const auto &v : {random, ascending, descending, equal, organ}) {
+    expect_sorted_like_std(v, std::greater<int>());
+    expect_sorted_like_std(v);
+  }
+}
+
+TEST(SORT, pdqsortStrings) {
+  s21::vector<std::string> v;
+  std::mt19937 gen(11);
+  for (int i = 0; i < 3000; ++i) v.push_back(std::to_string(gen() % 500));
+  expect_sorted_like_std(v);
+}
+
+TEST(SORT, stableSortKeepsOrderOfEqualKeys) {
+  s21::vector<record> records(3000);
+  std::mt19937 gen(5);
+  for (std::size_t i = 0; i < records.size(); ++i)
+    records[i] = {std::int64_t(gen() % 50) - 25, int(i)};
+
+  s21::vector<record> buffer;
+  s21::radix_sort(records.begin(), records.end(),
+                  [](const record &r) { return r.key; }, buffer);
+  EXPECT_GE(buffer.size(), records.size());
+  for (std::size_t i = 1; i < records.size(); ++i) {
+    EXPECT_LE(records[i - 1].key, records[i].key);
+    if (records[i - 1].key == records[i].key) {
+      EXPECT_LT(records[i - 1].order, records[i].order);
+    }
+  }
+
+  s21::stable_sort(records.begin(), records.end(),
+                   [](const record &a, const record &b) {
+                     return a.order % 7 < b.order % 7;
+                   });
+  for (std::size_t i = 1; i < records.size(); ++i) {
+    if (records[i - 1].order % 7 == records[i].order % 7) {
+      EXPECT_TRUE(records[i - 1].key < records[i].key ||
+                  (records[i - 1].key == records[i].key &&
+                   records[i - 1].order < records[i].order));
+    }
+  }
+}
+
+TEST(SORT, nthElement) {
+  for (std::size_t n : {1, 10, 100, 5000}) {
+    s21::vector<int> v = random_vector<int>(n, 0, 30, n);
+    std::vector<int> expected(v.begin(), v.end());
+    std::sort(expected.begin(), expected.end());
+    for (std::size_t k : {std::size_t(0), n / 3, n - 1}) {
+      s21::vector<int> copy = v;
+      s21::nth_element(copy.begin(), copy.begin() + k, copy.end());
+      EXPECT_EQ(copy[k], expected[k]);
+      for (std::size_t i = 0; i < k; ++i) EXPECT_LE(copy[i], copy[k]);
+      for (std::size_t i = k + 1; i < n; ++i) EXPECT_GE(copy[i], copy[k]);
+    }
+  }
+}
+
+TEST(SORT, partialSortArray) {
+  s21::array<int, 10> arr = {9, 3, 7, 1, 8, 2, 6, 0, 5, 4};
+  s21::partial_sort(arr.begin(), arr.begin() + 4, arr.end(),
+                    std::greater<int>());
+  EXPECT_EQ(arr[0], 9);
+  EXPECT_EQ(arr[1], 8);
+  EXPECT_EQ(arr[2], 7);
+  EXPECT_EQ(arr[3], 6);
+  s21::partial_sort(arr.begin(), arr.end(), arr.end());
+  EXPECT_TRUE(std::is_sorted(arr.begin(), arr.end()));
+}
@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <system_error>
+
+#include "../s21_containersplus.h"
+
+namespace {
+
+struct message {
+  std::uint64_t id;
+  double value;
+};
+
+s21::spilling_queue_options small_budget() {
+  s21::spilling_queue_options options;
+  options.memory_bytes = 16 << 10;
+  options.segment_bytes = 4 << 10;
+  options.file_segments = 4;
+  options.dir = testing::TempDir();
+  return options;
+}
+
+}  // namespace
+
+TEST(SPILLING_QUEUE, staysInMemoryUnderBudget) {
+  s21::spilling_queue<int> q;
+  EXPECT_TRUE(q.empty());
+  EXPECT_THROW(q.front(), std::logic_error);
+  EXPECT_THROW(q.pop(), std::logic_error);
+  for (int i = 0; i < 100000; ++i) q.push(i);
+  EXPECT_EQ(q.size(), 100000U);
+  EXPECT_EQ(q.spilled_segments(), 0U);
+  for (int i = 0; i < 100000; ++i) {
+    ASSERT_EQ(q.front(), i);
+    q.pop();
+  }
+  EXPECT_TRUE(q.empty());
+}
+
+TEST(SPILLING_QUEUE, spillsAndKeepsOrder) {
+  s21::spilling_queue<message> q(small_budget());
+  std::uint64_t pushed = 0, popped = 0;
+  // всплески записи сменяются частичным чтением, часть очереди все время
+  // лежит на диске, а файлы сегментов переиспользуются
+  for (int round = 0; round < 20; ++round) {
+    for (int i = 0; i < 5000; ++i, ++pushed) q.push({pushed, pushed * 0.5});
+    if (round == 0) {
+      EXPECT_GT(q.spilled_segments(), 0U);
+    }
+    for (int i = 0; i < 4000; ++i, ++popped) {
+      ASSERT_EQ(q.front().id, popped);
+      q.pop();
+    }
+  }
+  EXPECT_EQ(q.size(), pushed - popped);
+  while (!q.empty()) {
+    ASSERT_EQ(q.front().id, popped);
+    EXPECT_DOUBLE_EQ(q.front().value, popped * 0.5);
+    q.pop();
+    ++popped;
+  }
+  EXPECT_EQ(popped, pushed);
+  EXPECT_EQ(q.spilled_segments(), 0U);
+}
+
+TEST(SPILLING_QUEUE, interleavedSingleElements) {
+  s21::spilling_queue<int> q(small_budget());
+  int next = 0;
+  for (int i = 0; i < 50000; ++i) {
+    q.push(i);
+    if (i % 3 == 0) {
+      ASSERT_EQ(q.front(), next++);
+      q.pop();
+    }
+  }
+  s21::spilling_queue<int> moved(std::move(q));
+  while (!moved.empty()) {
+    ASSERT_EQ(moved.front(), next++);
+    moved.pop();
+  }
+  EXPECT_EQ(next, 50000);
+}
+
+TEST(SPILLING_QUEUE, movedFromIsEmpty) {
+  s21::spilling_queue<int> q(small_budget());
+  for (int i = 0; i < 10; ++i) q.push(i);
+  s21::spilling_queue<int> moved(std::move(q));
+  EXPECT_TRUE(q.empty());
+  EXPECT_EQ(q.size(), 0U);
+  EXPECT_THROW(q.front(), std::logic_error);
+  q.push(100);
+  EXPECT_EQ(q.front(), 100);
+
+  s21::spilling_queue<int> target(small_budget());
+  target.push(-1);
+  target = std::move(moved);
+  EXPECT_TRUE(moved.empty());
+  EXPECT_EQ(moved.size(), 0U);
+  ASSERT_EQ(target.size(), 10U);
+  EXPECT_EQ(target.front(), 0);
+
+  target.swap(q);
+  EXPECT_EQ(target.size(), 1U);
+  EXPECT_EQ(target.front(), 100);
+  EXPECT_EQ(q.size(), 10U);
+}
+
+TEST(SPILLING_QUEUE, failedSpillKeepsBlockSize) {
+  s21::spilling_queue_options options;
+  options.memory_bytes = 0;
+  options.segment_bytes = 4 * sizeof(int);
+  options.dir = "/nonexistent-s21-dir";
+  s21::spilling_queue<int> q(options);
+  // первый элемент сразу становится головой, следующие копятся в хвосте
+  for (int i = 0; i < 4; ++i) q.push(i);
+  // пятый элемент заполняет хвост, а файл сегмента создать нельзя
+  for (int attempt = 0; attempt < 3; ++attempt) {
+    EXPECT_THROW(q.push(4), std::system_error);
+    EXPECT_EQ(q.size(), 4U);
+  }
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_EQ(q.front(), i);
+    q.pop();
+  }
+  EXPECT_TRUE(q.empty());
+}
@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 
+#include <memory>
 #include <string>
 
 #include "../s21_containers.h"
@@ -696,3 +697,147 @@ TEST(VectorTest, SwapSelf) {
   EXPECT_EQ(vec[1], 2);
   EXPECT_EQ(vec[2], 3);
 }
+
+TEST(VectorTest, InsertManyMiddle) {
+  s21::vector<int> vec = {1, 2, 6, 7};
+  auto it = vec.insert_many(vec.begin() + 2, 3, 4, 5);
+
+  EXPECT_EQ(*it, 3);
+  EXPECT_EQ(vec.size(), 7U);
+  for (size_t i = 0; i < vec.size(); i++) {
+    EXPECT_EQ(vec[i], static_cast<int>(i) + 1);
+  }
+}
+
+TEST(VectorTest, InsertManyBack) {
+  s21::vector<std::string> vec;
+  vec.insert_many_back("a", std::string("b"));
+  vec.insert_many_back("c");
+
+  EXPECT_EQ(vec.size(), 3U);
+  EXPECT_EQ(vec[0], "a");
+  EXPECT_EQ(vec[1], "b");
+  EXPECT_EQ(vec[2], "c");
+}
+
+TEST(VectorTest, InsertManyFrontReserveOnce) {
+  s21::vector<int> vec = {4};
+  vec.insert_many(vec.begin(), 1, 2, 3);
+
+  EXPECT_EQ(vec.size(), 4U);
+  EXPECT_EQ(vec.capacity(), 4U);
+  EXPECT_EQ(vec[0], 1);
+  EXPECT_EQ(vec[3], 4);
+  EXPECT_THROW(vec.insert_many(vec.end() + 1, 5), std::out_of_range);
+}
+
+TEST(VectorTest, InsertManyMoveOnly) {
+  s21::vector<std::unique_ptr<int>> vec;
+  vec.insert_many_back(std::make_unique<int>(1), std::make_unique<int>(3));
+  vec.insert_many(vec.begin() + 1, std::make_unique<int>(2));
+
+  EXPECT_EQ(vec.size(), 3U);
+  EXPECT_EQ(*vec[0], 1);
+  EXPECT_EQ(*vec[1], 2);
+  EXPECT_EQ(*vec[2], 3);
+}
+
+TEST(VectorTest, InsertManySelfReference) {
+  // с расширением: аргументы читаются до освобождения старого массива
+  s21::vector<std::string> grown = {"first", "second"};
+  ASSERT_EQ(grown.capacity(), 2U);
+  grown.insert_many(grown.begin(), grown[1], grown[0]);
+  ASSERT_EQ(grown.size(), 4U);
+  EXPECT_EQ(grown[0], "second");
+  EXPECT_EQ(grown[1], "first");
+  EXPECT_EQ(grown[2], "first");
+  EXPECT_EQ(grown[3], "second");
+
+  // без расширения: сдвиг хвоста не портит аргументы
+  s21::vector<std::string> shifted = {"first", "second"};
+  shifted.reserve(8);
+  shifted.insert_many(shifted.begin(), shifted[0], shifted[1]);
+  ASSERT_EQ(shifted.size(), 4U);
+  EXPECT_EQ(shifted[0], "first");
+  EXPECT_EQ(shifted[1], "second");
+  EXPECT_EQ(shifted[2], "first");
+  EXPECT_EQ(shifted[3], "second");
+}
+
+TEST(VectorTest, EraseRange) {
+  s21::vector<int> vec = {1, 2, 3, 4, 5, 6};
+  auto it = vec.erase(vec.begin() + 1, vec.begin() + 4);
+
+  EXPECT_EQ(*it, 5);
+  EXPECT_EQ(vec.size(), 3U);
+  EXPECT_EQ(vec[0], 1);
+  EXPECT_EQ(vec[1], 5);
+  EXPECT_EQ(vec[2], 6);
+
+  it = vec.erase(vec.begin(), vec.begin());
+  EXPECT_EQ(vec.size(), 3U);
+  it = vec.erase(vec.begin(), vec.end());
+  EXPECT_TRUE(vec.empty());
+  EXPECT_THROW(vec.erase(vec.end(), vec.begin() + 1), std::out_of_range);
+}
+
+TEST(VectorTest, EraseIf) {
+  s21::vector<int> vec = {1, 2, 3, 4, 5, 6, 7, 8};
+  auto removed = s21::erase_if(vec, [](int x) { return x % 2 == 0; });
+
+  EXPECT_EQ(removed, 4U);
+  EXPECT_EQ(vec.size(), 4U);
+  for (size_t i = 0; i < vec.size(); i++) {
+    EXPECT_EQ(vec[i], static_cast<int>(i) * 2 + 1);
+  }
+  EXPECT_EQ(s21::erase_if(vec, [](int) { return false; }), 0U);
+}
+
+TEST(VectorTest, MoveAssignment) {
+  s21::vector<int> source = {1, 2, 3};
+  s21::vector<int> target(10);
+  target = std::move(source);
+  EXPECT_EQ(target.size(), 3U);
+  EXPECT_EQ(target[2], 3);
+  EXPECT_EQ(source.size(), 0U);
+  EXPECT_EQ(source.data(), nullptr);
+  s21::vector<int> moved(std::move(target));
+  EXPECT_EQ(moved.size(), 3U);
+  EXPECT_TRUE(target.empty());
+}
+
+TEST(VectorTest, MappedStorageGrowsInPlace) {
+  s21::vector<int> v = {1, 2, 3};
+  bool mapped = v.use_mapped_storage();
+#if defined(__linux__)
+  EXPECT_TRUE(mapped);
+#endif
+  EXPECT_EQ(v.uses_mapped_storage(), mapped);
+  EXPECT_EQ(v[2], 3);
+  for (int i = 0; i < 300000; ++i) v.push_back(i);
+  EXPECT_EQ(v.size(), 300003U);
+  EXPECT_EQ(v[3], 0);
+  EXPECT_EQ(v[300002], 299999);
+
+  s21::vector<int> copy = v;
+  EXPECT_EQ(copy.uses_mapped_storage(), mapped);
+  EXPECT_EQ(copy[100000], 99997);
+
+  v.erase(v.begin() + 10, v.end());
+  v.shrink_to_fit();
+  EXPECT_EQ(v.size(), 10U);
+  EXPECT_EQ(v[9], 6);
+  v.push_back(42);
+  EXPECT_EQ(v[10], 42);
+
+  EXPECT_FALSE(v.use_mapped_storage(false));
+  EXPECT_EQ(v[0], 1);
+  EXPECT_EQ(v[10], 42);
+}
+
+TEST(VectorTest, MappedStorageNeedsTrivialType) {
+  s21::vector<std::string> v = {"a", "b"};
+  EXPECT_FALSE(v.use_mapped_storage());
+  v.push_back("c");
+  EXPECT_EQ(v[2], "c");
+}
@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "../s21_containersplus.h"
+
+TEST(WorkStealingDeque, ownerIsLifoThiefIsFifo) {
+  s21::work_stealing_deque<int> deque(4);
+  EXPECT_TRUE(deque.empty());
+  EXPECT_FALSE(deque.pop().has_value());
+  EXPECT_FALSE(deque.steal().has_value());
+  for (int i = 0; i < 5; ++i) deque.push(i);
+  EXPECT_EQ(deque.size(), 5u);
+  EXPECT_EQ(deque.pop(), std::optional<int>(4));
+  EXPECT_EQ(deque.steal(), std::optional<int>(0));
+  EXPECT_EQ(deque.pop(), std::optional<int>(3));
+  EXPECT_EQ(deque.steal(), std::optional<int>(1));
+  EXPECT_EQ(deque.pop(), std::optional<int>(2));
+  EXPECT_FALSE(deque.pop().has_value());
+  EXPECT_FALSE(deque.steal().has_value());
+  EXPECT_TRUE(deque.empty());
+}
+
+TEST(WorkStealingDeque, growsPastCapacity) {
+  s21::work_stealing_deque<long> deque(2);
+  for (long i = 0; i < 1000; ++i) {
+    deque.push(i);
+    if (i % 3 == 0) {
+      EXPECT_EQ(deque.steal(), std::optional<long>(i / 3));
+    }
+  }
+  EXPECT_EQ(deque.size(), 1000u - 334u);
+  for (long i = 999; i >= 334; --i) {
+    EXPECT_EQ(deque.pop(), std::optional<long>(i));
+  }
+  EXPECT_TRUE(deque.empty());
+}
+
+TEST(WorkStealingDeque, stealHalf) {
+  s21::work_stealing_deque<int> deque;
+  int out[16];
+  EXPECT_EQ(deque.steal_half(out, 16), 0u);
+  for (int i = 0; i < 9; ++i) deque.push(i);
+  ASSERT_EQ(deque.steal_half(out, 16), 5u);
+  for (int i = 0; i < 5; ++i) EXPECT_EQ(out[i], i);
+  ASSERT_EQ(deque.steal_half(out, 1), 1u);
+  EXPECT_EQ(out[0], 5);
+  ASSERT_EQ(deque.steal_half(out, 16), 2u);
+  EXPECT_EQ(out[0], 6);
+  EXPECT_EQ(out[1], 7);
+  ASSERT_EQ(deque.steal_half(out, 16), 1u);
+  EXPECT_EQ(out[0], 8);
+  EXPECT_TRUE(deque.empty());
+}
+
+TEST(WorkStealingDeque, everyItemTakenOnce) {
+  const int kThieves = 3;
+  const int kItems = 100000;
+  s21::work_stealing_deque<int> deque(8);
+  std::atomic<bool> done{false};
+  std::vector<std::vector<int>> taken(kThieves + 1);
+  std::vector<std::thread> thieves;
+  for (int t = 0; t < kThieves; ++t) {
+    thieves.emplace_back([&, t] {
+      int batch[8];
+      while (true) {
+        bool finished = done.load(std::memory_order_acquire);
+        if (t % 2 == 0) {
+          std::size_t count = deque.steal_half(batch, 8);
+          taken[t].insert(taken[t].end(), batch, batch + count);
+        } else if (std::optional<int> value = deque.steal()) {
+          taken[t].push_back(*value);
+        }
+        if (finished && deque.empty()) break;
+        std::this_thread::yield();
+      }
+    });
+  }
+  // владелец кладет и сам забирает часть, соревнуясь с ворами за
+  // последние элементы
+  for (int i = 0; i < kItems; ++i) {
+    deque.push(i);
+    if (i % 3 == 2) {
+      for (int k = 0; k < 2; ++k) {
+        std::optional<int> value = deque.pop();
+        if (value) taken[kThieves].push_back(*value);
+      }
+    }
+  }
+  while (std::optional<int> value = deque.pop()) {
+    taken[kThieves].push_back(*value);
+  }
+  done.store(true, std::memory_order_release);
+  for (std::thread &thief : thieves) thief.join();
+  std::vector<int> all;
+  for (const auto &part : taken) {
+    all.insert(all.end(), part.begin(), part.end());
+  }
+  std::sort(all.begin(), all.end());
+  ASSERT_EQ(all.size(), std::size_t(kItems));
+  for (int i = 0; i < kItems; ++i) EXPECT_EQ(all[i], i);
+}